@@ -53,8 +53,12 @@ class Strategy;
 class Forwarder
 {
 public:
+  /** \param faceTable the faces of the forwarder
+   *  \param nameTreeOptions options of the hashtable underlying all name-indexed tables
+   */
   explicit
-  Forwarder(FaceTable& faceTable);
+  Forwarder(FaceTable& faceTable,
+            const name_tree::HashtableOptions& nameTreeOptions = name_tree::HashtableOptions(1024));
 
   NFD_VIRTUAL_WITH_TESTS
   ~Forwarder();
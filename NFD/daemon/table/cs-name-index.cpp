@@ -0,0 +1,146 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-name-index.hpp"
+
+namespace nfd {
+namespace cs {
+
+const size_t INITIAL_N_BUCKETS = 16;
+
+NameIndex::NameIndex()
+  : m_buckets(INITIAL_N_BUCKETS)
+{
+}
+
+Table::const_iterator
+NameIndex::find(const Table& table, const Name& name, size_t prefixLen, HashValue h) const
+{
+  for (const Node* node = m_buckets[h % m_buckets.size()]; node != nullptr; node = node->next) {
+    if (node->hash == h && name.compare(0, prefixLen, node->first->getName()) == 0) {
+      return node->first;
+    }
+  }
+  return table.end();
+}
+
+NameIndex::Node**
+NameIndex::findLink(const Name& name, HashValue h)
+{
+  Node** link = &getBucket(h);
+  while (*link != nullptr && ((*link)->hash != h || (*link)->first->getName() != name)) {
+    link = &(*link)->next;
+  }
+  return link;
+}
+
+void
+NameIndex::insert(const Table& table, Table::const_iterator it, HashValue h)
+{
+  const Name& name = it->getName();
+  if (it != table.begin() && std::prev(it)->getName() == name) {
+    // an earlier entry of the same name is indexed
+    return;
+  }
+
+  Node** link = findLink(name, h);
+  if (*link != nullptr) {
+    // the indexed entry now follows it
+    (*link)->first = it;
+    return;
+  }
+
+  Node* node = allocateNode();
+  node->hash = h;
+  node->first = it;
+  node->next = nullptr;
+  *link = node;
+  if (++m_size > m_buckets.size()) {
+    expand();
+  }
+}
+
+void
+NameIndex::erase(const Table& table, Table::const_iterator it, HashValue h)
+{
+  Node** link = findLink(it->getName(), h);
+  BOOST_ASSERT(*link != nullptr);
+  Node* node = *link;
+  if (node->first != it) {
+    return;
+  }
+
+  auto next = std::next(it);
+  if (next != table.end() && next->getName() == it->getName()) {
+    node->first = next;
+    return;
+  }
+
+  *link = node->next;
+  deallocateNode(node);
+  --m_size;
+}
+
+NameIndex::Node*
+NameIndex::allocateNode()
+{
+  Node* node = m_freeList;
+  if (node != nullptr) {
+    m_freeList = node->next;
+    return node;
+  }
+
+  if (m_nUsedInLastSlab == SLAB_SIZE) {
+    m_slabs.push_back(make_unique<Node[]>(SLAB_SIZE));
+    m_nUsedInLastSlab = 0;
+  }
+  return &m_slabs.back()[m_nUsedInLastSlab++];
+}
+
+void
+NameIndex::deallocateNode(Node* node)
+{
+  node->next = m_freeList;
+  m_freeList = node;
+}
+
+void
+NameIndex::expand()
+{
+  std::vector<Node*> buckets(m_buckets.size() * 2);
+  for (Node* head : m_buckets) {
+    while (head != nullptr) {
+      Node* node = head;
+      head = head->next;
+      Node*& bucket = buckets[node->hash % buckets.size()];
+      node->next = bucket;
+      bucket = node;
+    }
+  }
+  m_buckets.swap(buckets);
+}
+
+} // namespace cs
+} // namespace nfd
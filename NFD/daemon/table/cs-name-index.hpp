@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_NAME_INDEX_HPP
+#define NFD_DAEMON_TABLE_CS_NAME_INDEX_HPP
+
+#include "cs-entry.hpp"
+#include "name-tree-hashtable.hpp"
+
+namespace nfd {
+namespace cs {
+
+/** \brief a hash index of ContentStore entries by Data name
+ *
+ *  Entries whose Data have the same name differ only in implicit digest, and are adjacent
+ *  in the Table. The index therefore maps each Data name to the first of those entries,
+ *  and lets an exact-name lookup skip the Name comparisons of a Table search.
+ *
+ *  Index nodes are chained in buckets and allocated from fixed-size slabs. The number of
+ *  buckets doubles whenever it is exceeded by the number of nodes; it never shrinks, because
+ *  the number of entries is bounded by the ContentStore capacity.
+ */
+class NameIndex : noncopyable
+{
+public:
+  using HashValue = name_tree::HashValue;
+
+  NameIndex();
+
+  /** \return number of distinct Data names
+   */
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  /** \return first entry whose Data name equals \p name.getPrefix(prefixLen),
+   *          or \p table.end() if none exists
+   *  \pre h == name_tree::computeHash(name, prefixLen)
+   */
+  Table::const_iterator
+  find(const Table& table, const Name& name, size_t prefixLen, HashValue h) const;
+
+  /** \brief update the index after \p it has been inserted into \p table
+   *  \pre h == name_tree::computeHash(it->getName())
+   */
+  void
+  insert(const Table& table, Table::const_iterator it, HashValue h);
+
+  /** \brief update the index before \p it is erased from \p table
+   *  \pre h == name_tree::computeHash(it->getName())
+   */
+  void
+  erase(const Table& table, Table::const_iterator it, HashValue h);
+
+private:
+  struct Node
+  {
+    HashValue hash;
+    Table::const_iterator first;
+    Node* next;
+  };
+
+  Node*&
+  getBucket(HashValue h)
+  {
+    return m_buckets[h % m_buckets.size()];
+  }
+
+  /** \return pointer to the link that points to the node of \p name, or to nullptr
+   */
+  Node**
+  findLink(const Name& name, HashValue h);
+
+  Node*
+  allocateNode();
+
+  void
+  deallocateNode(Node* node);
+
+  void
+  expand();
+
+private:
+  static constexpr size_t SLAB_SIZE = 256;
+
+  std::vector<Node*> m_buckets;
+  size_t m_size = 0;
+  std::vector<unique_ptr<Node[]>> m_slabs;
+  Node* m_freeList = nullptr;
+  size_t m_nUsedInLastSlab = SLAB_SIZE;
+};
+
+} // namespace cs
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_CS_NAME_INDEX_HPP
@@ -80,6 +80,7 @@ Cs::insert(const Data& data, bool isUnsolicited)
     m_policy->afterRefresh(it);
   }
   else {
+    m_index.insert(m_table, it, name_tree::getHashes(data, data.getName()).back());
     m_policy->afterInsert(it);
   }
 }
@@ -104,7 +105,7 @@ Cs::eraseImpl(const Name& prefix, size_t limit)
   size_t nErased = 0;
   while (i != last && nErased < limit) {
     m_policy->beforeErase(i);
-    i = m_table.erase(i);
+    i = eraseEntry(i);
     ++nErased;
   }
   return nErased;
@@ -118,11 +119,20 @@ Cs::findImpl(const Interest& interest) const
   }
 
   const Name& prefix = interest.getName();
-  auto range = findPrefixRange(prefix);
-  auto match = std::find_if(range.first, range.second,
-                            [&interest] (const auto& entry) { return entry.canSatisfy(interest); });
+  const_iterator match;
+  if (!interest.getCanBePrefix()) {
+    match = findExactImpl(interest);
+  }
+  else {
+    auto range = findPrefixRange(prefix);
+    match = std::find_if(range.first, range.second,
+                         [&interest] (const auto& entry) { return entry.canSatisfy(interest); });
+    if (match == range.second) {
+      match = m_table.end();
+    }
+  }
 
-  if (match == range.second) {
+  if (match == m_table.end()) {
     NFD_LOG_DEBUG("find " << prefix << " no-match");
     return m_table.end();
   }
@@ -131,6 +141,34 @@ Cs::findImpl(const Interest& interest) const
   return match;
 }
 
+Cs::const_iterator
+Cs::findExactImpl(const Interest& interest) const
+{
+  // The Interest matches Data of its name, or if its name ends with an implicit digest,
+  // Data of its name without the digest; the latter come first in the Table
+  const Name& name = interest.getName();
+  bool hasDigest = !name.empty() && name[-1].isImplicitSha256Digest();
+  const name_tree::HashSequence& hashes = name_tree::getHashes(interest, name);
+
+  for (size_t prefixLen = hasDigest ? name.size() - 1 : name.size(); prefixLen <= name.size();
+       ++prefixLen) {
+    for (auto it = m_index.find(m_table, name, prefixLen, hashes[prefixLen]);
+         it != m_table.end() && name.compare(0, prefixLen, it->getName()) == 0; ++it) {
+      if (it->canSatisfy(interest)) {
+        return it;
+      }
+    }
+  }
+  return m_table.end();
+}
+
+Cs::const_iterator
+Cs::eraseEntry(const_iterator it)
+{
+  m_index.erase(m_table, it, name_tree::getHashes(it->getData(), it->getName()).back());
+  return m_table.erase(it);
+}
+
 void
 Cs::dump()
 {
@@ -155,7 +193,7 @@ Cs::setPolicyImpl(unique_ptr<Policy> policy)
 {
   NFD_LOG_DEBUG("set-policy " << policy->getName());
   m_policy = std::move(policy);
-  m_beforeEvictConnection = m_policy->beforeEvict.connect([this] (auto it) { m_table.erase(it); });
+  m_beforeEvictConnection = m_policy->beforeEvict.connect([this] (auto it) { eraseEntry(it); });
 
   m_policy->setCs(this);
   BOOST_ASSERT(m_policy->getCs() == this);
@@ -26,6 +26,7 @@
 #ifndef NFD_DAEMON_TABLE_CS_HPP
 #define NFD_DAEMON_TABLE_CS_HPP
 
+#include "cs-name-index.hpp"
 #include "cs-policy.hpp"
 
 namespace nfd {
@@ -38,6 +39,8 @@ namespace cs {
  *  The Table is a container ( \c std::set ) sorted by full Names of stored Data packets.
  *  Data packets are wrapped in Entry objects. Each Entry contains the Data packet itself,
  *  and a few additional attributes such as when the Data becomes non-fresh.
+ *  A NameIndex locates the entries of a Data name by hash, which serves Interests that
+ *  cannot be satisfied by a longer name without searching the Table.
  *
  *  The replacement policy is implemented in a subclass of \c Policy.
  */
@@ -182,6 +185,16 @@ private:
   const_iterator
   findImpl(const Interest& interest) const;
 
+  /** \brief find the first entry that satisfies an Interest whose CanBePrefix is false
+   */
+  const_iterator
+  findExactImpl(const Interest& interest) const;
+
+  /** \brief erase an entry from both the Table and the NameIndex
+   */
+  const_iterator
+  eraseEntry(const_iterator it);
+
   void
   setPolicyImpl(unique_ptr<Policy> policy);
 
@@ -191,6 +204,7 @@ NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 
 private:
   Table m_table;
+  NameIndex m_index;
   unique_ptr<Policy> m_policy;
   signal::ScopedConnection m_beforeEvictConnection;
 
@@ -27,6 +27,10 @@
 #include "common/city-hash.hpp"
 #include "common/logger.hpp"
 
+#include <boost/endian/conversion.hpp>
+
+#include <cstring>
+
 namespace nfd {
 namespace name_tree {
 
@@ -89,6 +93,29 @@ computeHashes(const Name& name, size_t prefixLen)
   return seq;
 }
 
+HashSequenceTag::HashSequenceTag(const Block& nameWire, HashSequence hashes)
+  : nameWire(nameWire)
+  , hashes(std::move(hashes))
+{
+}
+
+const HashSequence&
+getHashes(const ndn::TagHost& pkt, const Name& name, size_t prefixLen)
+{
+  const Block& nameWire = name.wireEncode();
+  size_t last = std::min(prefixLen, name.size());
+
+  auto tag = pkt.getTag<HashSequenceTag>();
+  if (tag != nullptr && tag->nameWire.data() == nameWire.data() &&
+      tag->nameWire.size() == nameWire.size() && tag->hashes.size() > last) {
+    return tag->hashes;
+  }
+
+  tag = make_shared<HashSequenceTag>(nameWire, computeHashes(name, last));
+  pkt.setTag(tag);
+  return tag->hashes;
+}
+
 Node::Node(HashValue h, const Name& name)
   : hash(h)
   , prev(nullptr)
@@ -115,9 +142,123 @@ HashtableOptions::HashtableOptions(size_t size)
 {
 }
 
+NodeArena::~NodeArena() = default;
+
+Node*
+NodeArena::create(HashValue h, const Name& name)
+{
+  Slot* slot = m_freeList;
+  if (slot != nullptr) {
+    m_freeList = slot->nextFree;
+  }
+  else {
+    if (m_nUsedInLastSlab == SLAB_SIZE) {
+      m_slabs.push_back(make_unique<Slot[]>(SLAB_SIZE));
+      m_nUsedInLastSlab = 0;
+    }
+    slot = &m_slabs.back()[m_nUsedInLastSlab++];
+  }
+
+  try {
+    return new (slot->storage) Node(h, name);
+  }
+  catch (...) {
+    slot->nextFree = m_freeList;
+    m_freeList = slot;
+    throw;
+  }
+}
+
+void
+NodeArena::destroy(Node* node)
+{
+  node->~Node();
+  Slot* slot = reinterpret_cast<Slot*>(node);
+  slot->nextFree = m_freeList;
+  m_freeList = slot;
+}
+
+/** \brief tag of a bucket that has never held a node since the last resize
+ */
+const uint8_t TAG_EMPTY = 0x80;
+
+/** \brief tag of a bucket whose node has been erased
+ *
+ *  Lookups continue probing past a group that has no empty bucket, and insertions may reuse it.
+ */
+const uint8_t TAG_DELETED = 0xFE;
+
+/** \return 7-bit hash tag stored for a node in open addressing
+ *
+ *  The tag takes the most significant bits, because the bucket index depends mostly on the
+ *  least significant ones.
+ */
+static uint8_t
+computeTag(HashValue h)
+{
+  return static_cast<uint8_t>(h >> (std::numeric_limits<HashValue>::digits - 7));
+}
+
+/** \brief the last tag of a group, which is never matched
+ */
+const uint8_t TAG_SENTINEL = 0xFF;
+
+const uint64_t TAG_LSBS = 0x0101010101010101;
+const uint64_t TAG_MSBS = 0x0080808080808080; // skips the sentinel
+
+/** \return the tags of a group as one word, where the i-th tag takes bits 8i to 8i+7
+ */
+static uint64_t
+loadTags(const std::array<uint8_t, 8>& tags)
+{
+  uint64_t word = 0;
+  std::memcpy(&word, tags.data(), sizeof(word));
+  return boost::endian::little_to_native(word);
+}
+
+/** \return a mask with bit 8i+7 set if the i-th tag may equal \p tag
+ *
+ *  A borrow may flag a full bucket next to a match, so candidates must be checked.
+ */
+static uint64_t
+matchTag(uint64_t tags, uint8_t tag)
+{
+  uint64_t x = tags ^ (TAG_LSBS * tag);
+  return (x - TAG_LSBS) & ~x & TAG_MSBS;
+}
+
+/** \return a mask with bit 8i+7 set if the i-th tag is TAG_EMPTY
+ */
+static uint64_t
+matchEmpty(uint64_t tags)
+{
+  return tags & ~(tags << 6) & TAG_MSBS;
+}
+
+/** \return a mask with bit 8i+7 set if the i-th tag is TAG_EMPTY or TAG_DELETED
+ */
+static uint64_t
+matchFree(uint64_t tags)
+{
+  return tags & ~(tags << 7) & TAG_MSBS;
+}
+
+/** \return index of the lowest tag flagged in a non-zero \p mask
+ */
+static size_t
+firstIndex(uint64_t mask)
+{
+  size_t i = 0;
+  for (; (mask & 0x80) == 0; mask >>= 8) {
+    ++i;
+  }
+  return i;
+}
+
 Hashtable::Hashtable(const Options& options)
   : m_options(options)
   , m_size(0)
+  , m_nTombstones(0)
 {
   BOOST_ASSERT(m_options.minSize > 0);
   BOOST_ASSERT(m_options.initialSize >= m_options.minSize);
@@ -128,19 +269,55 @@ Hashtable::Hashtable(const Options& options)
   BOOST_ASSERT(m_options.shrinkLoadFactor < 1.0);
   BOOST_ASSERT(m_options.shrinkFactor > 0.0);
   BOOST_ASSERT(m_options.shrinkFactor < 1.0);
-
-  m_buckets.resize(options.initialSize);
+  BOOST_ASSERT(!m_options.useOpenAddressing || m_options.expandLoadFactor < 1.0);
+
+  if (m_options.useOpenAddressing) {
+    BucketGroup empty;
+    empty.tags.fill(TAG_EMPTY);
+    empty.tags.back() = TAG_SENTINEL;
+    empty.nodes.fill(nullptr);
+    m_groups.resize((options.initialSize + BucketGroup::SIZE - 1) / BucketGroup::SIZE, empty);
+  }
+  else {
+    m_buckets.resize(options.initialSize);
+  }
   this->computeThresholds();
 }
 
 Hashtable::~Hashtable()
 {
-  for (size_t i = 0; i < m_buckets.size(); ++i) {
-    foreachNode(m_buckets[i], [] (Node* node) {
+  for (Node* head : m_buckets) {
+    foreachNode(head, [] (Node* node) {
       node->prev = node->next = nullptr;
       delete node;
     });
   }
+
+  for (const BucketGroup& group : m_groups) {
+    for (Node* node : group.nodes) {
+      if (node != nullptr) {
+        m_arena.destroy(node);
+      }
+    }
+  }
+}
+
+size_t
+Hashtable::getBucketIndex(const Node* node) const
+{
+  size_t bucket = this->computeBucketIndex(node->hash);
+  if (!m_options.useOpenAddressing) {
+    return bucket;
+  }
+
+  for (size_t g = bucket / BucketGroup::SIZE; ; g = g + 1 == m_groups.size() ? 0 : g + 1) {
+    const BucketGroup& group = m_groups[g];
+    for (size_t i = 0; i < BucketGroup::SIZE; ++i) {
+      if (group.nodes[i] == node) {
+        return g * BucketGroup::SIZE + i;
+      }
+    }
+  }
 }
 
 void
@@ -180,6 +357,10 @@ Hashtable::detach(size_t bucket, Node* node)
 std::pair<const Node*, bool>
 Hashtable::findOrInsert(const Name& name, size_t prefixLen, HashValue h, bool allowInsert)
 {
+  if (m_options.useOpenAddressing) {
+    return this->probe(name, prefixLen, h, allowInsert);
+  }
+
   size_t bucket = this->computeBucketIndex(h);
 
   for (const Node* node = m_buckets[bucket]; node != nullptr; node = node->next) {
@@ -206,6 +387,79 @@ Hashtable::findOrInsert(const Name& name, size_t prefixLen, HashValue h, bool al
   return {node, true};
 }
 
+std::pair<const Node*, bool>
+Hashtable::probe(const Name& name, size_t prefixLen, HashValue h, bool allowInsert)
+{
+  uint8_t tag = computeTag(h);
+  size_t g = this->computeBucketIndex(h) / BucketGroup::SIZE;
+  BucketGroup* freeGroup = nullptr;
+  size_t freeIndex = 0;
+
+  // There is always an empty bucket, which ends the probe sequence
+  for (;; g = g + 1 == m_groups.size() ? 0 : g + 1) {
+    BucketGroup& group = m_groups[g];
+    uint64_t tags = loadTags(group.tags);
+
+    for (uint64_t match = matchTag(tags, tag); match != 0; match &= match - 1) {
+      const Node* node = group.nodes[firstIndex(match)];
+      if (node->hash == h && name.compare(0, prefixLen, node->entry.getName()) == 0) {
+        NFD_LOG_TRACE("found " << name.getPrefix(prefixLen) << " hash=" << h << " group=" << g);
+        return {node, false};
+      }
+    }
+
+    uint64_t free = matchFree(tags);
+    if (freeGroup == nullptr && free != 0) {
+      freeGroup = &group;
+      freeIndex = firstIndex(free);
+    }
+    if (matchEmpty(tags) != 0) {
+      break;
+    }
+  }
+
+  if (!allowInsert) {
+    NFD_LOG_TRACE("not-found " << name.getPrefix(prefixLen) << " hash=" << h);
+    return {nullptr, false};
+  }
+
+  if (freeGroup->tags[freeIndex] == TAG_DELETED) {
+    --m_nTombstones;
+  }
+  Node* node = m_arena.create(h, name.getPrefix(prefixLen));
+  freeGroup->tags[freeIndex] = tag;
+  freeGroup->nodes[freeIndex] = node;
+  NFD_LOG_TRACE("insert " << node->entry.getName() << " hash=" << h
+                << " group=" << (freeGroup - m_groups.data()));
+  ++m_size;
+
+  if (m_size > m_expandThreshold) {
+    this->resize(std::max(static_cast<size_t>(m_options.expandFactor * this->getNBuckets()),
+                          this->getNBuckets() + 1));
+  }
+  else if (m_size + m_nTombstones > m_expandThreshold) {
+    // too few empty buckets are left: rehash in place to drop the tombstones
+    this->resize(this->getNBuckets());
+  }
+
+  return {node, true};
+}
+
+void
+Hashtable::place(Node* node)
+{
+  for (size_t g = this->computeBucketIndex(node->hash) / BucketGroup::SIZE; ;
+       g = g + 1 == m_groups.size() ? 0 : g + 1) {
+    uint64_t empty = matchEmpty(loadTags(m_groups[g].tags));
+    if (empty != 0) {
+      size_t i = firstIndex(empty);
+      m_groups[g].tags[i] = computeTag(node->hash);
+      m_groups[g].nodes[i] = node;
+      return;
+    }
+  }
+}
+
 const Node*
 Hashtable::find(const Name& name, size_t prefixLen) const
 {
@@ -233,16 +487,40 @@ Hashtable::erase(Node* node)
   BOOST_ASSERT(node != nullptr);
   BOOST_ASSERT(node->entry.getParent() == nullptr);
 
-  size_t bucket = this->computeBucketIndex(node->hash);
+  size_t bucket = this->getBucketIndex(node);
   NFD_LOG_TRACE("erase " << node->entry.getName() << " hash=" << node->hash << " bucket=" << bucket);
 
-  this->detach(bucket, node);
-  delete node;
+  if (m_options.useOpenAddressing) {
+    BucketGroup& group = m_groups[bucket / BucketGroup::SIZE];
+    size_t i = bucket % BucketGroup::SIZE;
+    group.nodes[i] = nullptr;
+    if (matchEmpty(loadTags(group.tags)) != 0) {
+      // probing stops at this group anyway
+      group.tags[i] = TAG_EMPTY;
+    }
+    else {
+      group.tags[i] = TAG_DELETED;
+      ++m_nTombstones;
+    }
+    m_arena.destroy(node);
+  }
+  else {
+    this->detach(bucket, node);
+    delete node;
+  }
   --m_size;
 
   if (m_size < m_shrinkThreshold) {
     size_t newNBuckets = std::max(m_options.minSize,
       static_cast<size_t>(m_options.shrinkFactor * this->getNBuckets()));
+    if (m_options.useOpenAddressing) {
+      size_t nGroups = (std::max(newNBuckets, m_size + 1) + BucketGroup::SIZE - 1) /
+                       BucketGroup::SIZE;
+      newNBuckets = nGroups * BucketGroup::SIZE;
+      if (newNBuckets == this->getNBuckets()) {
+        return; // don't move nodes merely to drop the tombstones
+      }
+    }
     this->resize(newNBuckets);
   }
 }
@@ -258,20 +536,43 @@ Hashtable::computeThresholds()
 void
 Hashtable::resize(size_t newNBuckets)
 {
-  if (this->getNBuckets() == newNBuckets) {
+  if (this->getNBuckets() == newNBuckets && m_nTombstones == 0) {
     return;
   }
   NFD_LOG_DEBUG("resize from=" << this->getNBuckets() << " to=" << newNBuckets);
 
-  std::vector<Node*> oldBuckets;
-  oldBuckets.swap(m_buckets);
-  m_buckets.resize(newNBuckets);
-
-  for (Node* head : oldBuckets) {
-    foreachNode(head, [this] (Node* node) {
-      size_t bucket = this->computeBucketIndex(node->hash);
-      this->attach(bucket, node);
-    });
+  if (m_options.useOpenAddressing) {
+    // keep an empty bucket to end every probe sequence
+    size_t nGroups = (newNBuckets + BucketGroup::SIZE - 1) / BucketGroup::SIZE;
+    BOOST_ASSERT(nGroups * BucketGroup::SIZE > m_size);
+
+    BucketGroup empty;
+    empty.tags.fill(TAG_EMPTY);
+    empty.tags.back() = TAG_SENTINEL;
+    empty.nodes.fill(nullptr);
+    std::vector<BucketGroup> oldGroups(nGroups, empty);
+    oldGroups.swap(m_groups);
+    m_nTombstones = 0;
+
+    for (const BucketGroup& group : oldGroups) {
+      for (Node* node : group.nodes) {
+        if (node != nullptr) {
+          this->place(node);
+        }
+      }
+    }
+  }
+  else {
+    std::vector<Node*> oldBuckets;
+    oldBuckets.swap(m_buckets);
+    m_buckets.resize(newNBuckets);
+
+    for (Node* head : oldBuckets) {
+      foreachNode(head, [this] (Node* node) {
+        size_t bucket = this->computeBucketIndex(node->hash);
+        this->attach(bucket, node);
+      });
+    }
   }
 
   this->computeThresholds();
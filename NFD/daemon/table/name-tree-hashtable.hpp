@@ -28,6 +28,8 @@
 
 #include "name-tree-entry.hpp"
 
+#include <array>
+
 namespace nfd {
 namespace name_tree {
 
@@ -53,6 +55,46 @@ computeHash(const Name& name, size_t prefixLen = std::numeric_limits<size_t>::ma
 HashSequence
 computeHashes(const Name& name, size_t prefixLen = std::numeric_limits<size_t>::max());
 
+/** \brief a packet tag that caches the hash sequence of the packet name
+ *  \sa getHashes
+ */
+class HashSequenceTag : public ndn::Tag
+{
+public:
+  static constexpr int
+  getTypeId() noexcept
+  {
+    return 0x60000010;
+  }
+
+  HashSequenceTag(const Block& nameWire, HashSequence hashes);
+
+public:
+  /** \brief wire encoding of the name from which hashes were computed
+   *
+   *  Holding the wire buffer guarantees that a name replacing it has a different address.
+   */
+  const Block nameWire;
+
+  const HashSequence hashes;
+};
+
+/** \brief computes hash values for each prefix of \p name.getPrefix(prefixLen),
+ *         caching them on the packet \p pkt whose name is \p name
+ *
+ *  An Interest or Data is looked up in several tables while it is being forwarded; the hash
+ *  sequence is computed on the first lookup and kept in a HashSequenceTag, which also survives
+ *  copies of the packet (e.g., the Interest inside a Nack). The cached sequence is discarded
+ *  if the packet name is replaced, or recomputed if it is shorter than requested.
+ *
+ *  \return a hash sequence where the i-th hash value equals computeHash(name, i),
+ *          holding at least std::min(prefixLen, name.size()) + 1 values;
+ *          it remains valid until the HashSequenceTag of \p pkt is replaced
+ */
+const HashSequence&
+getHashes(const ndn::TagHost& pkt, const Name& name,
+          size_t prefixLen = std::numeric_limits<size_t>::max());
+
 /** \brief a hashtable node
  *
  *  Zero or more nodes can be added to a hashtable bucket. They are organized as
@@ -137,13 +179,60 @@ public:
   /** \brief when hashtable is shrunk, its new size is max(nBuckets*shrinkFactor, minSize)
    */
   float shrinkFactor = 0.5;
+
+  /** \brief whether to resolve hash collisions by open addressing instead of chaining
+   *
+   *  Each bucket then holds at most one node. Buckets are grouped by cache line along with a
+   *  7-bit hash tag per bucket, so that a lookup only visits the nodes whose tag matches.
+   *  Nodes are allocated from a NodeArena. Numbers of buckets are rounded up to whole groups.
+   *
+   *  \warning expandLoadFactor must be less than 1.0 when this is enabled.
+   */
+  bool useOpenAddressing = false;
+};
+
+/** \brief allocates nodes from fixed-size slabs
+ *
+ *  Nodes allocated together are adjacent in memory. The storage of a destroyed node is reused
+ *  by the next allocation, and is returned to the system only when the arena is destructed.
+ */
+class NodeArena : noncopyable
+{
+public:
+  /** \pre all nodes have been destroyed
+   */
+  ~NodeArena();
+
+  /** \brief constructs a node in the arena
+   */
+  Node*
+  create(HashValue h, const Name& name);
+
+  /** \brief destructs a node created by this arena
+   */
+  void
+  destroy(Node* node);
+
+private:
+  union Slot
+  {
+    Slot* nextFree;
+    alignas(Node) unsigned char storage[sizeof(Node)];
+  };
+
+  static constexpr size_t SLAB_SIZE = 256;
+
+  std::vector<unique_ptr<Slot[]>> m_slabs;
+  Slot* m_freeList = nullptr;
+  size_t m_nUsedInLastSlab = SLAB_SIZE;
 };
 
 /** \brief a hashtable for fast exact name lookup
  *
  *  The Hashtable contains a number of buckets.
  *  Each node is placed into a bucket determined by a hash value computed from its name.
- *  Hash collision is resolved through a doubly linked list in each bucket.
+ *  Hash collision is resolved through a doubly linked list in each bucket, or by linear probing
+ *  if HashtableOptions::useOpenAddressing is set.
  *  The number of buckets is adjusted according to how many nodes are stored.
  */
 class Hashtable
@@ -171,7 +260,7 @@ public:
   size_t
   getNBuckets() const
   {
-    return m_buckets.size();
+    return m_options.useOpenAddressing ? m_groups.size() * BucketGroup::SIZE : m_buckets.size();
   }
 
   /** \return bucket index for hash value h
@@ -189,9 +278,18 @@ public:
   getBucket(size_t bucket) const
   {
     BOOST_ASSERT(bucket < this->getNBuckets());
+    if (m_options.useOpenAddressing) {
+      return m_groups[bucket / BucketGroup::SIZE].nodes[bucket % BucketGroup::SIZE];
+    }
     return m_buckets[bucket]; // don't use m_bucket.at() for better performance
   }
 
+  /** \return index of the bucket that holds \p node
+   *  \pre node exists in this hashtable
+   */
+  size_t
+  getBucketIndex(const Node* node) const;
+
   /** \brief find node for name.getPrefix(prefixLen)
    *  \pre name.size() > prefixLen
    */
@@ -232,6 +330,17 @@ private:
   std::pair<const Node*, bool>
   findOrInsert(const Name& name, size_t prefixLen, HashValue h, bool allowInsert);
 
+  /** \brief findOrInsert with open addressing
+   */
+  std::pair<const Node*, bool>
+  probe(const Name& name, size_t prefixLen, HashValue h, bool allowInsert);
+
+  /** \brief place node into the first empty bucket of its probe sequence
+   *  \pre useOpenAddressing
+   */
+  void
+  place(Node* node);
+
   void
   computeThresholds();
 
@@ -239,11 +348,27 @@ private:
   resize(size_t newNBuckets);
 
 private:
+  /** \brief consecutive buckets that share a cache line, used with open addressing
+   *
+   *  Probing visits whole groups: it compares the 7-bit hash tags of the group at once, and reads
+   *  only the nodes whose tag matches. It stops at the first group that has an empty bucket.
+   */
+  struct alignas(64) BucketGroup
+  {
+    static constexpr size_t SIZE = 7;
+
+    std::array<uint8_t, SIZE + 1> tags; ///< the last one is a sentinel that matches nothing
+    std::array<Node*, SIZE> nodes;
+  };
+
   std::vector<Node*> m_buckets;
+  std::vector<BucketGroup> m_groups; ///< replaces m_buckets if useOpenAddressing
   Options m_options;
   size_t m_size;
+  size_t m_nTombstones;
   size_t m_expandThreshold;
   size_t m_shrinkThreshold;
+  NodeArena m_arena;
 };
 
 } // namespace name_tree
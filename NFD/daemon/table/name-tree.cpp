@@ -40,14 +40,25 @@ NameTree::NameTree(size_t nBuckets)
 {
 }
 
+NameTree::NameTree(const HashtableOptions& options)
+  : m_ht(options)
+{
+}
+
 Entry&
 NameTree::lookup(const Name& name, size_t prefixLen)
+{
+  return this->lookup(name, prefixLen, computeHashes(name, prefixLen));
+}
+
+Entry&
+NameTree::lookup(const Name& name, size_t prefixLen, const HashSequence& hashes)
 {
   NFD_LOG_TRACE("lookup(" << name << ", " << prefixLen << ')');
   BOOST_ASSERT(prefixLen <= name.size());
   BOOST_ASSERT(prefixLen <= getMaxDepth());
+  BOOST_ASSERT(hashes.size() > prefixLen);
 
-  HashSequence hashes = computeHashes(name, prefixLen);
   const Node* node = nullptr;
   Entry* parent = nullptr;
 
@@ -85,7 +96,7 @@ NameTree::lookup(const pit::Entry& pitEntry)
   NFD_LOG_TRACE("lookup(PIT " << name << ')');
   bool hasDigest = name.size() > 0 && name[-1].isImplicitSha256Digest();
   if (hasDigest && name.size() <= getMaxDepth()) {
-    return this->lookup(name);
+    return this->lookup(name, name.size(), getHashes(pitEntry.getInterest(), name));
   }
 
   Entry* nte = this->getEntry(pitEntry);
@@ -158,11 +169,52 @@ NameTree::findExactMatch(const Name& name, size_t prefixLen) const
   return node == nullptr ? nullptr : &node->entry;
 }
 
+Entry*
+NameTree::findExactMatch(const Name& name, size_t prefixLen, const HashSequence& hashes) const
+{
+  prefixLen = std::min(name.size(), prefixLen);
+  if (prefixLen > getMaxDepth()) {
+    return nullptr;
+  }
+
+  const Node* node = m_ht.find(name, prefixLen, hashes);
+  return node == nullptr ? nullptr : &node->entry;
+}
+
 Entry*
 NameTree::findLongestPrefixMatch(const Name& name, const EntrySelector& entrySelector) const
 {
   size_t depth = std::min(name.size(), getMaxDepth());
-  HashSequence hashes = computeHashes(name, depth);
+  return this->findLongestPrefixMatch(name, computeHashes(name, depth), entrySelector);
+}
+
+Entry*
+NameTree::findLongestPrefixMatch(const Name& name, const HashSequence& hashes,
+                                 const EntrySelector& entrySelector) const
+{
+  size_t depth = std::min(name.size(), getMaxDepth());
+  BOOST_ASSERT(hashes.size() > depth);
+
+  if (m_isBinarySearchLpm) {
+    // every prefix shorter than lo exists, and no prefix at least as long as hi exists
+    const Node* deepest = nullptr;
+    size_t lo = 0, hi = depth + 1;
+    while (lo < hi) {
+      size_t mid = lo + (hi - lo) / 2;
+      const Node* node = m_ht.find(name, mid, hashes);
+      if (node != nullptr) {
+        deepest = node;
+        lo = mid + 1;
+      }
+      else {
+        hi = mid;
+      }
+    }
+    if (deepest == nullptr) {
+      return nullptr;
+    }
+    return this->findLongestPrefixMatch(deepest->entry, entrySelector);
+  }
 
   for (ssize_t i = depth; i >= 0; --i) {
     const Node* node = m_ht.find(name, i, hashes);
@@ -197,8 +249,9 @@ NameTree::findLongestPrefixMatch(const pit::Entry& pitEntry, const EntrySelector
   size_t depth = std::min(name.size(), getMaxDepth());
   if (nte->getName().size() < pitEntry.getName().size()) {
     // PIT entry name either exceeds depth limit or ends with an implicit digest: go deeper
+    const HashSequence& hashes = getHashes(pitEntry.getInterest(), name, depth);
     for (size_t i = nte->getName().size() + 1; i <= depth; ++i) {
-      const Entry* exact = this->findExactMatch(name, i);
+      const Entry* exact = this->findExactMatch(name, i, hashes);
       if (exact == nullptr) {
         break;
       }
@@ -222,6 +275,14 @@ NameTree::findAllMatches(const Name& name, const EntrySelector& entrySelector) c
   return {Iterator(make_shared<PrefixMatchImpl>(*this, entrySelector), entry), end()};
 }
 
+boost::iterator_range<NameTree::const_iterator>
+NameTree::findAllMatches(const Name& name, const HashSequence& hashes,
+                         const EntrySelector& entrySelector) const
+{
+  Entry* entry = this->findLongestPrefixMatch(name, hashes, entrySelector);
+  return {Iterator(make_shared<PrefixMatchImpl>(*this, entrySelector), entry), end()};
+}
+
 boost::iterator_range<NameTree::const_iterator>
 NameTree::fullEnumerate(const EntrySelector& entrySelector) const
 {
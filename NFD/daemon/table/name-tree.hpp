@@ -39,6 +39,9 @@ public:
   explicit
   NameTree(size_t nBuckets = 1024);
 
+  explicit
+  NameTree(const HashtableOptions& options);
+
 public: // information
   /** \brief Maximum depth of the name tree
    *
@@ -69,6 +72,31 @@ public: // information
     return m_ht.getNBuckets();
   }
 
+  /** \brief whether longest prefix match binary-searches over prefix lengths
+   *  \sa setBinarySearchLpm
+   */
+  bool
+  isBinarySearchLpm() const
+  {
+    return m_isBinarySearchLpm;
+  }
+
+  /** \brief enable or disable binary search in longest prefix match by name
+   *
+   *  By default, `findLongestPrefixMatch(name)` probes the hashtable with each prefix of \p name,
+   *  from the longest to the shortest. Since the name tree contains every prefix of the name of
+   *  each entry, the entries themselves serve as markers: if \p name.getPrefix(i) is absent, so
+   *  is every longer prefix. When enabled, the deepest existing prefix is thus found by a binary
+   *  search over prefix lengths, in O(log name.size()) probes, and the match is then sought
+   *  among its ancestors without further probes. This pays off when names are much longer than
+   *  the matched entries, e.g., FIB lookups of long application names.
+   */
+  void
+  setBinarySearchLpm(bool isEnabled)
+  {
+    m_isBinarySearchLpm = isEnabled;
+  }
+
   /** \return name tree entry on which a table entry is attached,
    *          or nullptr if the table entry is detached
    */
@@ -92,6 +120,13 @@ public: // mutation
   Entry&
   lookup(const Name& name, size_t prefixLen);
 
+  /** \brief Equivalent to `lookup(name, prefixLen)`, using precomputed hash values
+   *  \pre hashes.size() > prefixLen, and hashes[i] == name_tree::computeHash(name, i)
+   *  \sa name_tree::getHashes
+   */
+  Entry&
+  lookup(const Name& name, size_t prefixLen, const HashSequence& hashes);
+
   /** \brief Equivalent to `lookup(name, name.size())`
    */
   Entry&
@@ -148,6 +183,13 @@ public: // matching
   Entry*
   findExactMatch(const Name& name, size_t prefixLen = std::numeric_limits<size_t>::max()) const;
 
+  /** \brief Equivalent to `findExactMatch(name, prefixLen)`, using precomputed hash values
+   *  \pre hashes.size() > std::min({prefixLen, name.size(), getMaxDepth()}),
+   *       and hashes[i] == name_tree::computeHash(name, i)
+   */
+  Entry*
+  findExactMatch(const Name& name, size_t prefixLen, const HashSequence& hashes) const;
+
   /** \brief Longest prefix matching
    *  \return entry whose name is a prefix of \p name and passes \p entrySelector,
    *          where no other entry with a longer name satisfies those requirements;
@@ -157,6 +199,15 @@ public: // matching
   findLongestPrefixMatch(const Name& name,
                          const EntrySelector& entrySelector = AnyEntry()) const;
 
+  /** \brief Equivalent to `findLongestPrefixMatch(name, entrySelector)`, using precomputed
+   *         hash values
+   *  \pre hashes.size() > std::min(name.size(), getMaxDepth()),
+   *       and hashes[i] == name_tree::computeHash(name, i)
+   */
+  Entry*
+  findLongestPrefixMatch(const Name& name, const HashSequence& hashes,
+                         const EntrySelector& entrySelector = AnyEntry()) const;
+
   /** \brief Equivalent to `findLongestPrefixMatch(entry.getName(), entrySelector)`
    *  \note This overload is more efficient than
    *        `findLongestPrefixMatch(const Name&, const EntrySelector&)` in common cases.
@@ -213,6 +264,14 @@ public: // matching
   findAllMatches(const Name& name,
                  const EntrySelector& entrySelector = AnyEntry()) const;
 
+  /** \brief Equivalent to `findAllMatches(name, entrySelector)`, using precomputed hash values
+   *  \pre hashes.size() > std::min(name.size(), getMaxDepth()),
+   *       and hashes[i] == name_tree::computeHash(name, i)
+   */
+  Range
+  findAllMatches(const Name& name, const HashSequence& hashes,
+                 const EntrySelector& entrySelector = AnyEntry()) const;
+
 public: // enumeration
   using const_iterator = Iterator;
 
@@ -274,6 +333,7 @@ public: // enumeration
 
 private:
   Hashtable m_ht;
+  bool m_isBinarySearchLpm = false;
 
   friend class EnumerationImpl;
 };
@@ -48,13 +48,17 @@ Pit::findOrInsert(const Interest& interest, bool allowInsert)
   size_t nteDepth = name.size() - static_cast<int>(hasDigest);
   nteDepth = std::min(nteDepth, NameTree::getMaxDepth());
 
+  // the hashes are kept on the Interest, and reused when the PIT entry is looked up again
+  // (including the implicit digest and a Nack carrying a copy of the Interest)
+  const auto& hashes = name_tree::getHashes(interest, name, NameTree::getMaxDepth());
+
   // ensure NameTree entry exists
   name_tree::Entry* nte = nullptr;
   if (allowInsert) {
-    nte = &m_nameTree.lookup(name, nteDepth);
+    nte = &m_nameTree.lookup(name, nteDepth, hashes);
   }
   else {
-    nte = m_nameTree.findExactMatch(name, nteDepth);
+    nte = m_nameTree.findExactMatch(name, nteDepth, hashes);
     if (nte == nullptr) {
       return {nullptr, true};
     }
@@ -85,7 +89,9 @@ Pit::findOrInsert(const Interest& interest, bool allowInsert)
 DataMatchResult
 Pit::findAllDataMatches(const Data& data) const
 {
-  auto&& ntMatches = m_nameTree.findAllMatches(data.getName(), &nteHasPitEntries);
+  const Name& name = data.getName();
+  const auto& hashes = name_tree::getHashes(data, name, NameTree::getMaxDepth());
+  auto&& ntMatches = m_nameTree.findAllMatches(name, hashes, &nteHasPitEntries);
 
   DataMatchResult matches;
   for (const auto& nte : ntMatches) {
@@ -87,6 +87,41 @@ BOOST_AUTO_TEST_CASE(FullName_EmptyDataName)
   CHECK_CS_FIND(2);
 }
 
+BOOST_AUTO_TEST_CASE(ExactName_Erase)
+{
+  insert(1, "/A/B");
+  Name n2 = insert(2, "/A");
+  Name n3 = insert(3, "/A");
+  insert(4, "/A/C");
+
+  // Data of the same name differ in implicit digest; erasing one keeps the other
+  BOOST_CHECK_EQUAL(erase(n2, 1), 1);
+  startInterest("/A");
+  CHECK_CS_FIND(3);
+  startInterest(n2);
+  CHECK_CS_FIND(0);
+  startInterest(n3);
+  CHECK_CS_FIND(3);
+
+  insert(2, "/A");
+  startInterest("/A");
+  CHECK_CS_FIND(n2 < n3 ? 2 : 3);
+  startInterest(n2);
+  CHECK_CS_FIND(2);
+
+  BOOST_CHECK_EQUAL(erase(n3, 1), 1);
+  startInterest("/A");
+  CHECK_CS_FIND(2);
+
+  BOOST_CHECK_EQUAL(erase(n2, 1), 1);
+  startInterest("/A");
+  CHECK_CS_FIND(0);
+  startInterest("/A/B");
+  CHECK_CS_FIND(1);
+  startInterest("/A/C");
+  CHECK_CS_FIND(4);
+}
+
 BOOST_AUTO_TEST_CASE(PrefixName)
 {
   insert(1, "/A");
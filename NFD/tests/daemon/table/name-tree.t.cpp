@@ -53,6 +53,27 @@ BOOST_AUTO_TEST_CASE(ComputeHash)
   BOOST_CHECK_EQUAL(hashes.size(), 3);
 }
 
+BOOST_AUTO_TEST_CASE(GetHashes)
+{
+  auto interest = makeInterest("/A/B/C/D");
+  const HashSequence& hashes = getHashes(*interest, interest->getName(), 2);
+  BOOST_CHECK(hashes == computeHashes("/A/B"));
+  BOOST_CHECK(interest->getTag<HashSequenceTag>() != nullptr);
+
+  // a cached sequence that is long enough is reused, also by a copy of the packet
+  BOOST_CHECK_EQUAL(&getHashes(*interest, interest->getName(), 1), &hashes);
+  Interest copy(*interest);
+  BOOST_CHECK_EQUAL(&getHashes(copy, copy.getName(), 2), &hashes);
+
+  // a longer sequence replaces the cached one
+  BOOST_CHECK(getHashes(*interest, interest->getName()) == computeHashes("/A/B/C/D"));
+  BOOST_CHECK_EQUAL(interest->getTag<HashSequenceTag>()->hashes.size(), 5);
+
+  // a replaced name is hashed again
+  interest->setName("/A/E");
+  BOOST_CHECK(getHashes(*interest, interest->getName()) == computeHashes("/A/E"));
+}
+
 BOOST_AUTO_TEST_SUITE(Hashtable)
 using name_tree::Hashtable;
 
@@ -183,6 +204,59 @@ BOOST_AUTO_TEST_CASE(Resize)
   BOOST_CHECK_EQUAL(ht.getNBuckets(), 6);
 }
 
+BOOST_AUTO_TEST_CASE(OpenAddressing)
+{
+  HashtableOptions options(16);
+  options.useOpenAddressing = true;
+  Hashtable ht(options);
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 21);
+
+  std::vector<Name> names;
+  for (int i = 0; i < 500; ++i) {
+    names.push_back(Name("/open").appendNumber(i));
+  }
+
+  std::vector<const Node*> nodes;
+  for (const Name& name : names) {
+    HashSequence hashes = computeHashes(name);
+    const Node* node = nullptr;
+    bool isNew = false;
+    std::tie(node, isNew) = ht.insert(name, name.size(), hashes);
+    BOOST_CHECK_EQUAL(isNew, true);
+    nodes.push_back(node);
+  }
+  BOOST_CHECK_EQUAL(ht.size(), 500);
+  BOOST_CHECK_EQUAL(ht.getNBuckets() % 7, 0);
+  BOOST_CHECK_GT(ht.getNBuckets(), 1000);
+
+  for (size_t i = 0; i < names.size(); ++i) {
+    BOOST_CHECK_EQUAL(ht.find(names[i], names[i].size()), nodes[i]);
+    BOOST_CHECK_EQUAL(ht.getBucket(ht.getBucketIndex(nodes[i])), nodes[i]);
+  }
+  BOOST_CHECK(ht.find(Name("/open/none"), 2) == nullptr);
+
+  // erasing must neither move the remaining nodes nor hide them behind the erased buckets
+  for (size_t i = 0; i < names.size(); i += 2) {
+    ht.erase(const_cast<Node*>(nodes[i]));
+  }
+  BOOST_CHECK_EQUAL(ht.size(), 250);
+  for (size_t i = 0; i < names.size(); ++i) {
+    BOOST_CHECK_EQUAL(ht.find(names[i], names[i].size()), i % 2 == 0 ? nullptr : nodes[i]);
+  }
+
+  size_t nNodes = 0;
+  for (size_t b = 0; b < ht.getNBuckets(); ++b) {
+    nNodes += ht.getBucket(b) != nullptr;
+  }
+  BOOST_CHECK_EQUAL(nNodes, 250);
+
+  for (size_t i = 1; i < names.size(); i += 2) {
+    ht.erase(const_cast<Node*>(nodes[i]));
+  }
+  BOOST_CHECK_EQUAL(ht.size(), 0);
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 21);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // Hashtable
 
 BOOST_AUTO_TEST_SUITE(TestEntry)
@@ -691,6 +765,46 @@ BOOST_FIXTURE_TEST_CASE(IteratorFindAllMatches, EnumerationFixture)
     .end();
 }
 
+BOOST_AUTO_TEST_CASE(BinarySearchLpm)
+{
+  NameTree nt;
+  BOOST_CHECK_EQUAL(nt.isBinarySearchLpm(), false);
+  nt.setBinarySearchLpm(true);
+  BOOST_CHECK_EQUAL(nt.isBinarySearchLpm(), true);
+
+  BOOST_CHECK(nt.findLongestPrefixMatch(Name("/a/b")) == nullptr);
+
+  Entry& a = nt.lookup("/a");
+  Entry& abcd = nt.lookup("/a/b/c/d");
+  nt.lookup("/a/b/x/y/z");
+  nt.lookup("/e/f");
+  Entry& root = *nt.findExactMatch("/");
+  Entry& abc = *nt.findExactMatch("/a/b/c");
+
+  BOOST_CHECK_EQUAL(nt.findLongestPrefixMatch(Name("/")), &root);
+  BOOST_CHECK_EQUAL(nt.findLongestPrefixMatch(Name("/g/h/i/j/k/l/m/n/o/p")), &root);
+  BOOST_CHECK_EQUAL(nt.findLongestPrefixMatch(Name("/a")), &a);
+  BOOST_CHECK_EQUAL(nt.findLongestPrefixMatch(Name("/a/g/h/i/j/k/l/m/n/o/p")), &a);
+  BOOST_CHECK_EQUAL(nt.findLongestPrefixMatch(Name("/a/b/c/d")), &abcd);
+  BOOST_CHECK_EQUAL(nt.findLongestPrefixMatch(Name("/a/b/c/d/e/f/g/h/i/j/k")), &abcd);
+  BOOST_CHECK_EQUAL(nt.findLongestPrefixMatch(Name("/a/b/c/e/f/g/h/i/j/k/l")), &abc);
+
+  // entry selector is applied to ancestors of the deepest existing prefix
+  auto isAOrAbc = [&] (const Entry& entry) { return &entry == &a || &entry == &abc; };
+  BOOST_CHECK_EQUAL(nt.findLongestPrefixMatch(Name("/a/b/c/d/e/f/g/h"), isAOrAbc), &abc);
+  BOOST_CHECK_EQUAL(nt.findLongestPrefixMatch(Name("/a/b/x/y/z/1/2/3"), isAOrAbc), &a);
+  BOOST_CHECK(nt.findLongestPrefixMatch(Name("/e/f/g"), isAOrAbc) == nullptr);
+
+  // results agree with the linear search for every prefix of a long name
+  Name name("/a/b/x/y/z/1/2/3/4/5/6/7/8/9");
+  for (size_t i = 0; i <= name.size(); ++i) {
+    nt.setBinarySearchLpm(true);
+    Entry* found = nt.findLongestPrefixMatch(name.getPrefix(i));
+    nt.setBinarySearchLpm(false);
+    BOOST_CHECK_EQUAL(found, nt.findLongestPrefixMatch(name.getPrefix(i)));
+  }
+}
+
 BOOST_AUTO_TEST_CASE(HashTableResizeShrink)
 {
   size_t nBuckets = 16;
@@ -0,0 +1,130 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2025  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "agg-name.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+
+namespace ns3 {
+namespace ndn {
+
+constexpr size_t ChildIndex::NOT_FOUND;
+
+ChildIndex::ChildIndex(ChildIndex&& other)
+{
+  TakeKeys(std::move(other));
+}
+
+ChildIndex&
+ChildIndex::operator=(ChildIndex&& other)
+{
+  if (this != &other) {
+    TakeKeys(std::move(other));
+  }
+  return *this;
+}
+
+void
+ChildIndex::TakeKeys(ChildIndex&& other)
+{
+  m_keys = std::move(other.m_keys);
+  m_types = std::move(other.m_types);
+  other.m_keys.clear();
+  other.m_types.clear();
+  other.m_index.clear();
+  BuildIndex();
+}
+
+void
+ChildIndex::Assign(const std::vector<Name>& prefixes)
+{
+  m_keys.clear();
+  m_types.clear();
+  m_keys.reserve(prefixes.size());
+  m_types.reserve(prefixes.size());
+
+  for (const Name& prefix : prefixes) {
+    if (prefix.empty()) {
+      m_keys.emplace_back();
+      m_types.push_back(0); // no component has TLV-TYPE 0, so this child is never found
+      continue;
+    }
+    const name::Component& first = prefix.get(0);
+    m_keys.emplace_back(reinterpret_cast<const char*>(first.value()), first.value_size());
+    m_types.push_back(first.type());
+  }
+  BuildIndex();
+}
+
+void
+ChildIndex::BuildIndex()
+{
+  // keys must not move once viewed by m_index
+  m_index.clear();
+  m_index.reserve(m_keys.size());
+  for (size_t i = 0; i < m_keys.size(); ++i) {
+    if (m_types[i] != 0) {
+      m_index.emplace(m_keys[i], i);
+    }
+  }
+}
+
+size_t
+ChildIndex::Find(const name::Component& component) const
+{
+  auto it = m_index.find(std::string_view(reinterpret_cast<const char*>(component.value()),
+                                          component.value_size()));
+  if (it == m_index.end() || m_types[it->second] != component.type()) {
+    return NOT_FOUND;
+  }
+  return it->second;
+}
+
+bool
+ReadRoundNumber(const name::Component& component, uint64_t& seq)
+{
+  if (component.isSequenceNumber()) {
+    seq = component.toSequenceNumber();
+    return true;
+  }
+
+  if (!component.isGeneric() || component.value_size() == 0 || component.value_size() > 19) {
+    return false;
+  }
+  uint64_t value = 0;
+  const uint8_t* end = component.value() + component.value_size();
+  for (const uint8_t* it = component.value(); it != end; ++it) {
+    if (*it < '0' || *it > '9') {
+      return false;
+    }
+    value = value * 10 + (*it - '0');
+  }
+  seq = value;
+  return true;
+}
+
+uint32_t
+ReadContributions(const Data& data)
+{
+  const Block* block = data.getMetaInfo().findAppMetaInfo(AGG_TLV_CONTRIBUTIONS);
+  return block == nullptr ? 1 : ::ndn::encoding::readNonNegativeIntegerAs<uint32_t>(*block);
+}
+
+} // namespace ndn
+} // namespace ns3
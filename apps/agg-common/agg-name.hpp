@@ -0,0 +1,125 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2025  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_AGG_NAME_HPP
+#define NDN_AGG_NAME_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Maps the first name component of a child's Data to the child's index
+ *
+ * Children are keyed on the component's TLV-TYPE and raw TLV-VALUE bytes, so identifying
+ * the sender of an incoming Data is a single hash lookup that builds no strings (unlike
+ * comparing Component::toUri() against every child name).
+ */
+class ChildIndex
+{
+public:
+  static constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+
+  ChildIndex() = default;
+
+  // The index views the strings of this object, which a copy would not own
+  ChildIndex(const ChildIndex&) = delete;
+
+  ChildIndex&
+  operator=(const ChildIndex&) = delete;
+
+  ChildIndex(ChildIndex&& other);
+
+  ChildIndex&
+  operator=(ChildIndex&& other);
+
+  /**
+   * @brief Index the children by the first component of each prefix, in order
+   *
+   * Prefixes with the same first component keep the lowest index.
+   */
+  void
+  Assign(const std::vector<Name>& prefixes);
+
+  /**
+   * @brief Index of the child whose first component equals @p component, or NOT_FOUND
+   */
+  size_t
+  Find(const name::Component& component) const;
+
+  size_t
+  Size() const
+  {
+    return m_types.size();
+  }
+
+private:
+  // Take the children of @p other, leaving it empty, and index them
+  void
+  TakeKeys(ChildIndex&& other);
+
+  // Index every child of m_keys and m_types
+  void
+  BuildIndex();
+
+private:
+  std::vector<std::string> m_keys; // owned TLV-VALUE bytes, viewed by m_index
+  std::vector<uint32_t> m_types;
+  std::unordered_map<std::string_view, size_t> m_index;
+};
+
+/**
+ * @brief Read an aggregation round number from a name component
+ *
+ * Accepts a typed SequenceNumber component, or a generic component holding decimal
+ * digits (the older cfnagg naming), without converting the component to a string.
+ *
+ * @return false if the component is neither
+ */
+bool
+ReadRoundNumber(const name::Component& component, uint64_t& seq);
+
+/**
+ * @brief AppMetaInfo TLV-TYPE of the number of leaf contributions an aggregate combines
+ *
+ * A MEAN aggregate travels upstream as the sum of its contributions and carries their
+ * count in this element, so that only the root divides, by the number of leaves that
+ * contributed to the round (a mean of the children's means would weigh a leaf under a
+ * small subtree more than one under a large subtree).
+ */
+const uint32_t AGG_TLV_CONTRIBUTIONS = 129;
+
+/**
+ * @brief Number of leaf contributions @p data combines: its AGG_TLV_CONTRIBUTIONS element,
+ *        or 1 if it has none (a leaf's own value)
+ */
+uint32_t
+ReadContributions(const Data& data);
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_AGG_NAME_HPP
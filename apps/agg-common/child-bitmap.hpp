@@ -0,0 +1,116 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2025  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_CHILD_BITMAP_HPP
+#define NDN_CHILD_BITMAP_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Fixed-size set of child indices, one bit per child of an aggregation round
+ *
+ * Storage is sized once (per round-table slot) and Clear() keeps it, so starting a new
+ * round does not allocate.
+ */
+class ChildBitmap
+{
+public:
+  explicit
+  ChildBitmap(size_t size = 0)
+  {
+    Resize(size);
+  }
+
+  void
+  Resize(size_t size)
+  {
+    m_size = size;
+    m_words.assign((size + 63) / 64, 0);
+  }
+
+  size_t
+  Size() const
+  {
+    return m_size;
+  }
+
+  bool
+  Test(size_t index) const
+  {
+    return (m_words[index >> 6] >> (index & 63)) & 1;
+  }
+
+  /**
+   * @brief Mark child @p index
+   * @return true if the bit was newly set, false if it was already set
+   */
+  bool
+  Set(size_t index)
+  {
+    uint64_t mask = uint64_t(1) << (index & 63);
+    uint64_t& word = m_words[index >> 6];
+    bool isNew = (word & mask) == 0;
+    word |= mask;
+    return isNew;
+  }
+
+  /**
+   * @brief Unmark child @p index
+   */
+  void
+  Reset(size_t index)
+  {
+    m_words[index >> 6] &= ~(uint64_t(1) << (index & 63));
+  }
+
+  void
+  Clear()
+  {
+    std::fill(m_words.begin(), m_words.end(), 0);
+  }
+
+  /**
+   * @brief Number of marked children
+   */
+  size_t
+  Count() const
+  {
+    size_t count = 0;
+    for (uint64_t word : m_words) {
+      count += static_cast<size_t>(__builtin_popcountll(word));
+    }
+    return count;
+  }
+
+private:
+  std::vector<uint64_t> m_words;
+  size_t m_size;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CHILD_BITMAP_HPP
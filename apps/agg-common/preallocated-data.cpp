@@ -0,0 +1,191 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2025  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "preallocated-data.hpp"
+
+#include "ns3/assert.h"
+
+#include <ndn-cxx/encoding/tlv.hpp>
+
+#include <algorithm>
+
+namespace ns3 {
+namespace ndn {
+
+namespace {
+
+// SignatureInfo carrying only SignatureType 255, same as the apps' dummy signature
+const uint8_t DUMMY_SIGNATURE[] = {
+  ::ndn::tlv::SignatureInfo, 3, ::ndn::tlv::SignatureType, 1, 255,
+  ::ndn::tlv::SignatureValue, 0
+};
+
+uint8_t*
+writeVarNumber(uint8_t* pos, uint64_t number)
+{
+  if (number < 253) {
+    *pos++ = static_cast<uint8_t>(number);
+    return pos;
+  }
+
+  size_t len;
+  if (number <= 0xFFFF) {
+    *pos++ = 253;
+    len = 2;
+  }
+  else if (number <= 0xFFFFFFFF) {
+    *pos++ = 254;
+    len = 4;
+  }
+  else {
+    *pos++ = 255;
+    len = 8;
+  }
+  for (size_t i = len; i > 0; --i) {
+    *pos++ = static_cast<uint8_t>(number >> (8 * (i - 1)));
+  }
+  return pos;
+}
+
+size_t
+sizeOfTlv(uint32_t type, size_t length)
+{
+  return ::ndn::tlv::sizeOfVarNumber(type) + ::ndn::tlv::sizeOfVarNumber(length) + length;
+}
+
+} // namespace
+
+constexpr size_t PreallocatedData::MAX_APP_META_INFO;
+
+PreallocatedData::PreallocatedData()
+  : m_contentOffset(0)
+  , m_contentSize(0)
+  , m_nAppMetaInfo(0)
+{
+}
+
+void
+PreallocatedData::Prepare(const Name& name, time::milliseconds freshnessPeriod, size_t contentSize,
+                          std::initializer_list<uint32_t> appMetaInfoTypes)
+{
+  m_nAppMetaInfo = 0;
+  for (uint32_t type : appMetaInfoTypes) {
+    if (type == 0) {
+      continue;
+    }
+    NS_ASSERT_MSG(type >= 128 && type <= 252, "AppMetaInfo TLV-TYPE must be in [128, 252]");
+    NS_ASSERT_MSG(m_nAppMetaInfo < MAX_APP_META_INFO, "too many AppMetaInfo elements");
+    m_appMetaInfoTypes[m_nAppMetaInfo++] = type;
+  }
+
+  const Block& nameWire = name.wireEncode(); // cached if the name came off an Interest
+
+  // MetaInfo carries FreshnessPeriod only when it differs from the default, as in ndn-cxx
+  uint64_t freshness = static_cast<uint64_t>(freshnessPeriod.count());
+  size_t freshnessSize = freshness > 0 ? ::ndn::tlv::sizeOfNonNegativeInteger(freshness) : 0;
+  size_t metaInfoLength = freshness > 0 ? sizeOfTlv(::ndn::tlv::FreshnessPeriod, freshnessSize) : 0;
+  for (size_t i = 0; i < m_nAppMetaInfo; ++i) {
+    metaInfoLength += sizeOfTlv(m_appMetaInfoTypes[i], sizeof(uint32_t));
+  }
+
+  size_t dataLength = nameWire.size()
+                    + sizeOfTlv(::ndn::tlv::MetaInfo, metaInfoLength)
+                    + sizeOfTlv(::ndn::tlv::Content, contentSize)
+                    + sizeof(DUMMY_SIGNATURE);
+
+  m_buffer = make_shared<::ndn::Buffer>(sizeOfTlv(::ndn::tlv::Data, dataLength));
+  uint8_t* pos = m_buffer->data();
+
+  pos = writeVarNumber(pos, ::ndn::tlv::Data);
+  pos = writeVarNumber(pos, dataLength);
+  pos = std::copy(nameWire.begin(), nameWire.end(), pos);
+
+  pos = writeVarNumber(pos, ::ndn::tlv::MetaInfo);
+  pos = writeVarNumber(pos, metaInfoLength);
+  if (freshness > 0) {
+    pos = writeVarNumber(pos, ::ndn::tlv::FreshnessPeriod);
+    pos = writeVarNumber(pos, freshnessSize);
+    for (size_t i = freshnessSize; i > 0; --i) {
+      *pos++ = static_cast<uint8_t>(freshness >> (8 * (i - 1)));
+    }
+  }
+  for (size_t i = 0; i < m_nAppMetaInfo; ++i) {
+    pos = writeVarNumber(pos, m_appMetaInfoTypes[i]);
+    pos = writeVarNumber(pos, sizeof(uint32_t));
+    m_appMetaInfoOffsets[i] = static_cast<size_t>(pos - m_buffer->data());
+    pos = std::fill_n(pos, sizeof(uint32_t), 0);
+  }
+
+  pos = writeVarNumber(pos, ::ndn::tlv::Content);
+  pos = writeVarNumber(pos, contentSize);
+  m_contentOffset = static_cast<size_t>(pos - m_buffer->data());
+  m_contentSize = contentSize;
+  std::fill_n(pos, contentSize, 0);
+  pos += contentSize;
+
+  std::copy(std::begin(DUMMY_SIGNATURE), std::end(DUMMY_SIGNATURE), pos);
+}
+
+void
+PreallocatedData::SetAppMetaInfo(uint32_t value)
+{
+  NS_ASSERT_MSG(m_buffer != nullptr && m_nAppMetaInfo > 0, "no AppMetaInfo reserved");
+
+  SetAppMetaInfo(m_appMetaInfoTypes[0], value);
+}
+
+void
+PreallocatedData::SetAppMetaInfo(uint32_t type, uint32_t value)
+{
+  NS_ASSERT_MSG(m_buffer != nullptr, "no AppMetaInfo reserved");
+
+  size_t i = 0;
+  while (i < m_nAppMetaInfo && m_appMetaInfoTypes[i] != type) {
+    ++i;
+  }
+  NS_ASSERT_MSG(i < m_nAppMetaInfo, "no AppMetaInfo of type " << type << " reserved");
+
+  uint8_t* pos = m_buffer->data() + m_appMetaInfoOffsets[i];
+  for (size_t i = sizeof(uint32_t); i > 0; --i) {
+    *pos++ = static_cast<uint8_t>(value >> (8 * (i - 1)));
+  }
+}
+
+shared_ptr<Data>
+PreallocatedData::Finalize()
+{
+  NS_ASSERT_MSG(m_buffer != nullptr, "PreallocatedData::Finalize() called before Prepare()");
+
+  // Data(const Block&) keeps the wire as-is; wireEncode() on the result returns it unchanged
+  auto data = make_shared<Data>(Block(::ndn::ConstBufferPtr(std::move(m_buffer))));
+  Reset();
+  return data;
+}
+
+void
+PreallocatedData::Reset()
+{
+  m_buffer.reset();
+  m_contentOffset = 0;
+  m_contentSize = 0;
+  m_nAppMetaInfo = 0;
+}
+
+} // namespace ndn
+} // namespace ns3
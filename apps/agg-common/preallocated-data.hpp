@@ -0,0 +1,137 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2025  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_PREALLOCATED_DATA_HPP
+#define NDN_PREALLOCATED_DATA_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <ndn-cxx/encoding/buffer.hpp>
+
+#include <initializer_list>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Data packet whose wire encoding is laid out once, before its content is known
+ *
+ * Prepare() writes Name, MetaInfo, a Content element with a zero-filled value region of
+ * the requested size, and a dummy signature (SignatureType 255, empty SignatureValue)
+ * into a single exactly-sized buffer. The aggregation apps then write or accumulate the
+ * result straight into Content(), and Finalize() wraps the buffer into a Data packet that
+ * already has its wire encoding: no setContent() copy, no re-encode and no signing pass.
+ *
+ * The buffer is handed over to the returned Data (which may end up in the Content Store),
+ * so the object must be prepared again before it can be reused.
+ */
+class PreallocatedData
+{
+public:
+  /**
+   * @brief Number of AppMetaInfo elements a prepared wire can reserve
+   */
+  static constexpr size_t MAX_APP_META_INFO = 2;
+
+  PreallocatedData();
+
+  /**
+   * @brief Lay out the wire encoding of a Data packet with @p contentSize reserved bytes
+   *
+   * If @p appMetaInfoType is non-zero (128..252), MetaInfo also carries an AppMetaInfo
+   * element of that type holding a 4-byte NonNegativeInteger, initially 0, which can be
+   * filled in later with SetAppMetaInfo().
+   */
+  void
+  Prepare(const Name& name, time::milliseconds freshnessPeriod, size_t contentSize,
+          uint32_t appMetaInfoType = 0)
+  {
+    Prepare(name, freshnessPeriod, contentSize, {appMetaInfoType});
+  }
+
+  /**
+   * @brief Lay out a Data packet reserving an AppMetaInfo element for each non-zero type of
+   *        @p appMetaInfoTypes (at most MAX_APP_META_INFO), in order
+   */
+  void
+  Prepare(const Name& name, time::milliseconds freshnessPeriod, size_t contentSize,
+          std::initializer_list<uint32_t> appMetaInfoTypes);
+
+  /**
+   * @brief Check whether Prepare() has been called since the last Finalize()/Reset()
+   */
+  bool
+  IsPrepared() const
+  {
+    return m_buffer != nullptr;
+  }
+
+  /**
+   * @brief Writable view of the reserved Content value region
+   */
+  uint8_t*
+  Content()
+  {
+    return m_buffer->data() + m_contentOffset;
+  }
+
+  size_t
+  ContentSize() const
+  {
+    return m_contentSize;
+  }
+
+  /**
+   * @brief Set the value of the (first) AppMetaInfo element reserved by Prepare()
+   */
+  void
+  SetAppMetaInfo(uint32_t value);
+
+  /**
+   * @brief Set the value of the AppMetaInfo element of type @p type reserved by Prepare()
+   */
+  void
+  SetAppMetaInfo(uint32_t type, uint32_t value);
+
+  /**
+   * @brief Wrap the prepared wire into a Data packet and release the buffer
+   */
+  shared_ptr<Data>
+  Finalize();
+
+  /**
+   * @brief Drop a prepared buffer without producing a packet
+   */
+  void
+  Reset();
+
+private:
+  shared_ptr<::ndn::Buffer> m_buffer;
+  size_t m_contentOffset;
+  size_t m_contentSize;
+  size_t m_nAppMetaInfo; // AppMetaInfo elements reserved
+  uint32_t m_appMetaInfoTypes[MAX_APP_META_INFO];
+  size_t m_appMetaInfoOffsets[MAX_APP_META_INFO]; // of each element's value
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_PREALLOCATED_DATA_HPP
@@ -0,0 +1,69 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2025  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "reduction.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+bool
+ParseReduceOp(const std::string& name, ReduceOp& op)
+{
+  static const struct {
+    const char* name;
+    ReduceOp op;
+  } ops[] = {
+    {"sum", ReduceOp::SUM},
+    {"max", ReduceOp::MAX},
+    {"min", ReduceOp::MIN},
+    {"mean", ReduceOp::MEAN},
+    {"topk", ReduceOp::TOP_K},
+    {"or", ReduceOp::BIT_OR},
+  };
+  for (const auto& entry : ops) {
+    if (name == entry.name) {
+      op = entry.op;
+      return true;
+    }
+  }
+  return false;
+}
+
+const char*
+ReduceOpName(ReduceOp op)
+{
+  switch (op) {
+  case ReduceOp::SUM:
+    return "sum";
+  case ReduceOp::MAX:
+    return "max";
+  case ReduceOp::MIN:
+    return "min";
+  case ReduceOp::MEAN:
+    return "mean";
+  case ReduceOp::TOP_K:
+    return "topk";
+  case ReduceOp::BIT_OR:
+    return "or";
+  }
+  return "unknown";
+}
+
+} // namespace ndn
+} // namespace ns3
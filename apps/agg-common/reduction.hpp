@@ -0,0 +1,347 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2025  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_REDUCTION_HPP
+#define NDN_REDUCTION_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Reduction an aggregation tree applies to the contributions of a round
+ */
+enum class ReduceOp {
+  SUM,    ///< element-wise sum
+  MAX,    ///< element-wise maximum
+  MIN,    ///< element-wise minimum
+  MEAN,   ///< element-wise mean over all leaf contributions of the round
+  TOP_K,  ///< the k largest values over all contributions (k = the aggregate's element count)
+  BIT_OR  ///< element-wise bitwise or (integer values only)
+};
+
+/**
+ * @brief Parse a reduction name (sum, max, min, mean, topk, or; case-sensitive)
+ * @return false if @p name is none of them
+ */
+bool
+ParseReduceOp(const std::string& name, ReduceOp& op);
+
+const char*
+ReduceOpName(ReduceOp op);
+
+namespace reduction {
+
+struct Sum
+{
+  template<typename T>
+  static T
+  Identity()
+  {
+    return T(0);
+  }
+
+  template<typename T>
+  static T
+  Combine(T acc, T value)
+  {
+    return acc + value;
+  }
+};
+
+struct Max
+{
+  template<typename T>
+  static T
+  Identity()
+  {
+    return std::numeric_limits<T>::lowest();
+  }
+
+  template<typename T>
+  static T
+  Combine(T acc, T value)
+  {
+    return std::max(acc, value);
+  }
+};
+
+struct Min
+{
+  template<typename T>
+  static T
+  Identity()
+  {
+    return std::numeric_limits<T>::max();
+  }
+
+  template<typename T>
+  static T
+  Combine(T acc, T value)
+  {
+    return std::min(acc, value);
+  }
+};
+
+struct BitOr
+{
+  template<typename T>
+  static T
+  Identity()
+  {
+    return T(0);
+  }
+
+  template<typename T>
+  static T
+  Combine(T acc, T value)
+  {
+    if constexpr (std::is_integral<T>::value) {
+      return acc | value;
+    }
+    else {
+      return acc + value; // not reached: Reducer refuses BIT_OR on non-integer types
+    }
+  }
+};
+
+/**
+ * @brief Fold @p count elements of @p in into @p acc with operator @p Op
+ *
+ * Both regions are raw bytes of T that need not be aligned (they are usually the content
+ * of a Data wire), so elements go through memcpy, which compiles to plain loads and stores.
+ */
+template<typename Op, typename T>
+void
+CombineElements(uint8_t* acc, const uint8_t* in, size_t count)
+{
+  for (size_t i = 0; i < count; ++i) {
+    T a, v;
+    std::memcpy(&a, acc + i * sizeof(T), sizeof(T));
+    std::memcpy(&v, in + i * sizeof(T), sizeof(T));
+    a = Op::template Combine<T>(a, v);
+    std::memcpy(acc + i * sizeof(T), &a, sizeof(T));
+  }
+}
+
+/**
+ * @brief Merge @p count values of @p in into the @p k largest values held in @p acc
+ *
+ * @p acc is kept sorted in decreasing order; @p in need not be sorted.
+ */
+template<typename T>
+void
+MergeTopK(uint8_t* acc, size_t k, const uint8_t* in, size_t count)
+{
+  for (size_t i = 0; i < count; ++i) {
+    T v;
+    std::memcpy(&v, in + i * sizeof(T), sizeof(T));
+    T last;
+    std::memcpy(&last, acc + (k - 1) * sizeof(T), sizeof(T));
+    if (!(v > last)) {
+      continue;
+    }
+    // Shift the smaller values down one slot and insert v in order
+    size_t pos = k - 1;
+    while (pos > 0) {
+      T prev;
+      std::memcpy(&prev, acc + (pos - 1) * sizeof(T), sizeof(T));
+      if (!(v > prev)) {
+        break;
+      }
+      std::memcpy(acc + pos * sizeof(T), &prev, sizeof(T));
+      --pos;
+    }
+    std::memcpy(acc + pos * sizeof(T), &v, sizeof(T));
+  }
+}
+
+} // namespace reduction
+
+/**
+ * @ingroup ndn-apps
+ * @brief Aggregation core shared by the aggregation apps: folds contributions of value type
+ *        @p T into a round's aggregate with a run-time selected ReduceOp
+ *
+ * The operator is chosen once per call and the per-element loop is instantiated for it, so
+ * an app shell only decodes its wire format and hands the values (or the raw element arrays)
+ * over. An aggregate starts at Identity() (Fill() for arrays); MEAN combines like SUM, and
+ * intermediate nodes forward the sum with the number of leaf contributions it holds
+ * (AGG_TLV_CONTRIBUTIONS): only the root calls Finalize(), which divides by the total, so
+ * the tree reports the mean over all leaves rather than a mean of the subtrees' means.
+ * TOP_K keeps an array sorted in decreasing order; for a single value it is MAX.
+ */
+template<typename T>
+class Reducer
+{
+public:
+  explicit
+  Reducer(ReduceOp op = ReduceOp::SUM)
+    : m_op(op)
+  {
+  }
+
+  /**
+   * @brief Whether @p op can reduce values of type T (BIT_OR needs an integer type)
+   */
+  static bool
+  Supports(ReduceOp op)
+  {
+    return op != ReduceOp::BIT_OR || std::is_integral<T>::value;
+  }
+
+  ReduceOp
+  GetOp() const
+  {
+    return m_op;
+  }
+
+  T
+  Identity() const
+  {
+    switch (m_op) {
+    case ReduceOp::MAX:
+    case ReduceOp::TOP_K:
+      return reduction::Max::Identity<T>();
+    case ReduceOp::MIN:
+      return reduction::Min::Identity<T>();
+    default:
+      return T(0);
+    }
+  }
+
+  /**
+   * @brief Fold one value into a single-value aggregate
+   */
+  T
+  Combine(T acc, T value) const
+  {
+    switch (m_op) {
+    case ReduceOp::MAX:
+    case ReduceOp::TOP_K:
+      return reduction::Max::Combine<T>(acc, value);
+    case ReduceOp::MIN:
+      return reduction::Min::Combine<T>(acc, value);
+    case ReduceOp::BIT_OR:
+      return reduction::BitOr::Combine<T>(acc, value);
+    default:
+      return reduction::Sum::Combine<T>(acc, value);
+    }
+  }
+
+  /**
+   * @brief Reset an aggregate of @p count elements (raw, possibly unaligned bytes of T)
+   */
+  void
+  Fill(uint8_t* acc, size_t count) const
+  {
+    T identity = Identity();
+    for (size_t i = 0; i < count; ++i) {
+      std::memcpy(acc + i * sizeof(T), &identity, sizeof(T));
+    }
+  }
+
+  /**
+   * @brief Fold @p inCount elements of a contribution into an aggregate of @p accCount
+   *
+   * Element-wise operators use the first min(accCount, inCount) elements; TOP_K merges all
+   * @p inCount values into the accCount largest.
+   */
+  void
+  Combine(uint8_t* acc, size_t accCount, const uint8_t* in, size_t inCount) const
+  {
+    if (accCount == 0) {
+      return;
+    }
+    size_t count = std::min(accCount, inCount);
+    switch (m_op) {
+    case ReduceOp::MAX:
+      reduction::CombineElements<reduction::Max, T>(acc, in, count);
+      break;
+    case ReduceOp::MIN:
+      reduction::CombineElements<reduction::Min, T>(acc, in, count);
+      break;
+    case ReduceOp::BIT_OR:
+      reduction::CombineElements<reduction::BitOr, T>(acc, in, count);
+      break;
+    case ReduceOp::TOP_K:
+      reduction::MergeTopK<T>(acc, accCount, in, inCount);
+      break;
+    default:
+      reduction::CombineElements<reduction::Sum, T>(acc, in, count);
+      break;
+    }
+  }
+
+  /**
+   * @brief Whether an aggregate sent upstream must carry its contribution count (MEAN)
+   */
+  bool
+  CountsContributions() const
+  {
+    return m_op == ReduceOp::MEAN;
+  }
+
+  /**
+   * @brief Value a single-value aggregate of @p contributions leaf values reports at the root
+   *        (MEAN divides)
+   */
+  T
+  Finalize(T acc, uint32_t contributions) const
+  {
+    if (m_op == ReduceOp::MEAN && contributions > 0) {
+      return static_cast<T>(acc / static_cast<T>(contributions));
+    }
+    return acc;
+  }
+
+  /**
+   * @brief Turn an array aggregate of @p contributions leaf values into what the root reports,
+   *        in place
+   */
+  void
+  Finalize(uint8_t* acc, size_t count, uint32_t contributions) const
+  {
+    if (m_op != ReduceOp::MEAN || contributions == 0) {
+      return;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      T a;
+      std::memcpy(&a, acc + i * sizeof(T), sizeof(T));
+      a = Finalize(a, contributions);
+      std::memcpy(acc + i * sizeof(T), &a, sizeof(T));
+    }
+  }
+
+private:
+  ReduceOp m_op;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_REDUCTION_HPP
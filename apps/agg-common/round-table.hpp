@@ -0,0 +1,192 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2025  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_ROUND_TABLE_HPP
+#define NDN_ROUND_TABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Fixed-capacity table of in-flight aggregation rounds indexed by sequence number
+ *
+ * Rounds are dense and bounded by the congestion window (or BufferCapacity), so the table
+ * is a power-of-two ring: round @c seq lives in slot <tt>seq & mask</tt> and the slot keeps
+ * @c seq as its generation tag, which tells a live round apart from a stale one that maps
+ * to the same slot. All slots are allocated up front as copies of a prototype entry (for
+ * example with child bitmaps already sized), and Insert() re-initializes a slot by assigning
+ * the prototype, so steady-state lookups and inserts do not allocate.
+ *
+ * A round can only be inserted while its slot is free; callers treat a failed Insert() as
+ * "too many rounds in flight".
+ */
+template<typename Entry>
+class RoundTable
+{
+public:
+  explicit
+  RoundTable(size_t capacity = 1, const Entry& prototype = Entry())
+  {
+    Reset(capacity, prototype);
+  }
+
+  /**
+   * @brief Drop all rounds and resize to @p capacity (rounded up to a power of two)
+   */
+  void
+  Reset(size_t capacity, const Entry& prototype = Entry())
+  {
+    size_t size = 1;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    m_prototype = prototype;
+    m_slots.assign(size, Slot{false, 0, prototype});
+    m_mask = size - 1;
+    m_size = 0;
+  }
+
+  size_t
+  Capacity() const
+  {
+    return m_slots.size();
+  }
+
+  /**
+   * @brief Number of rounds currently in the table
+   */
+  size_t
+  Size() const
+  {
+    return m_size;
+  }
+
+  bool
+  Empty() const
+  {
+    return m_size == 0;
+  }
+
+  /**
+   * @brief Entry of round @p seq, or nullptr if that round is not in the table
+   */
+  Entry*
+  Find(uint64_t seq)
+  {
+    Slot& slot = m_slots[seq & m_mask];
+    return slot.used && slot.seq == seq ? &slot.entry : nullptr;
+  }
+
+  const Entry*
+  Find(uint64_t seq) const
+  {
+    const Slot& slot = m_slots[seq & m_mask];
+    return slot.used && slot.seq == seq ? &slot.entry : nullptr;
+  }
+
+  /**
+   * @brief Whether round @p seq could be inserted now (its slot is free)
+   */
+  bool
+  CanInsert(uint64_t seq) const
+  {
+    return !m_slots[seq & m_mask].used;
+  }
+
+  /**
+   * @brief Start round @p seq with a fresh copy of the prototype entry
+   * @return the entry, or nullptr if the slot is taken (by @p seq itself or by an
+   *         older round that is still in flight)
+   */
+  Entry*
+  Insert(uint64_t seq)
+  {
+    Slot& slot = m_slots[seq & m_mask];
+    if (slot.used) {
+      return nullptr;
+    }
+    slot.used = true;
+    slot.seq = seq;
+    slot.entry = m_prototype;
+    ++m_size;
+    return &slot.entry;
+  }
+
+  /**
+   * @brief Finish round @p seq
+   * @return false if the round was not in the table
+   */
+  bool
+  Erase(uint64_t seq)
+  {
+    Slot& slot = m_slots[seq & m_mask];
+    if (!slot.used || slot.seq != seq) {
+      return false;
+    }
+    slot.used = false;
+    --m_size;
+    return true;
+  }
+
+  void
+  Clear()
+  {
+    for (Slot& slot : m_slots) {
+      slot.used = false;
+    }
+    m_size = 0;
+  }
+
+  /**
+   * @brief Call @p f(seq, entry) for every round in the table, in slot order
+   */
+  template<typename F>
+  void
+  ForEach(F&& f)
+  {
+    for (Slot& slot : m_slots) {
+      if (slot.used) {
+        f(slot.seq, slot.entry);
+      }
+    }
+  }
+
+private:
+  struct Slot
+  {
+    bool used;
+    uint64_t seq; // generation tag
+    Entry entry;
+  };
+
+  std::vector<Slot> m_slots;
+  Entry m_prototype;
+  uint64_t m_mask;
+  size_t m_size;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_ROUND_TABLE_HPP
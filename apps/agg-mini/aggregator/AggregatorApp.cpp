@@ -1,6 +1,7 @@
 #include "AggregatorApp.hpp"
 #include "ns3/object.h"                // for NS_OBJECT_ENSURE_REGISTERED
 #include "helper/ndn-fib-helper.hpp"
+#include "helper/ndn-network-region-table-helper.hpp"
 // #include "ns3/log.h" // Replaced with iostream
 #include "ns3/names.h"
 #include "ns3/string.h"
@@ -15,6 +16,8 @@
 #include <ndn-cxx/signature-info.hpp>     // for ndn::SignatureInfo
 #include <ndn-cxx/encoding/estimator.hpp> // for ndn::EncodingEstimator
 #include <ndn-cxx/encoding/buffer.hpp>    // for ndn::EncodingBuffer
+#include <ndn-cxx/link.hpp>               // for ndn::Link (Bypass redirect)
+#include <ndn-cxx/lp/nack.hpp>            // for lp::Nack
 
 // NS_LOG_COMPONENT_DEFINE("ndn.AggregatorApp"); // Replaced with std::cout
 
@@ -47,13 +50,37 @@ AggregatorApp::GetTypeId()
       .AddAttribute("StragglerTimeout", "Wait for missing children",
                     TimeValue(Seconds(1.0)),
                     MakeTimeAccessor(&AggregatorApp::m_stragglerTimeout),
-                    MakeTimeChecker());
+                    MakeTimeChecker())
+      .AddAttribute("PayloadSize", "Bytes of each round's aggregate (children's payloads are host ints)",
+                    UintegerValue(sizeof(int)),
+                    MakeUintegerAccessor(&AggregatorApp::m_payloadSize),
+                    MakeUintegerChecker<uint32_t>(1))
+      .AddAttribute("MemoryBudget", "Bytes of aggregation state for all in-flight sequences (0 = unlimited)",
+                    UintegerValue(0),
+                    MakeUintegerAccessor(&AggregatorApp::m_memoryBudget),
+                    MakeUintegerChecker<uint32_t>())
+      .AddAttribute("OverflowPolicy",
+                    "New sequence when BufferCapacity or MemoryBudget is exhausted: "
+                    "Drop, Nack, Evict (send the oldest partial aggregate up early) "
+                    "or Bypass (redirect the parent to the raw child data)",
+                    StringValue("Drop"),
+                    MakeStringAccessor(&AggregatorApp::m_overflowPolicyRaw),
+                    MakeStringChecker())
+      .AddAttribute("Reduction",
+                    "How children's payloads are combined element-wise: sum, max, min, mean, "
+                    "topk (the PayloadSize/4 largest values) or or (bitwise)",
+                    StringValue("sum"),
+                    MakeStringAccessor(&AggregatorApp::m_reductionRaw),
+                    MakeStringChecker());
   return tid;
 }
 
 AggregatorApp::AggregatorApp()
   : m_bufferCapacity(0)
   , m_stragglerTimeout(Seconds(0))
+  , m_payloadSize(sizeof(int))
+  , m_memoryBudget(0)
+  , m_overflowPolicy(OverflowPolicy::DROP)
   , m_bufferMgr(0, Seconds(0)) // Will be re-initialized in StartApplication
 {
     std::cout << "AggregatorApp: Constructor called." << std::endl;
@@ -97,10 +124,37 @@ AggregatorApp::StartApplication()
     }
   }
 
+  if (m_overflowPolicyRaw == "Drop") {
+    m_overflowPolicy = OverflowPolicy::DROP;
+  } else if (m_overflowPolicyRaw == "Nack") {
+    m_overflowPolicy = OverflowPolicy::NACK;
+  } else if (m_overflowPolicyRaw == "Evict") {
+    m_overflowPolicy = OverflowPolicy::EVICT;
+  } else if (m_overflowPolicyRaw == "Bypass") {
+    m_overflowPolicy = OverflowPolicy::BYPASS;
+  } else {
+    std::cerr << "[" << nodeName << "] AggregatorApp: ERROR - Unknown OverflowPolicy '" << m_overflowPolicyRaw
+              << "', using Drop" << std::endl;
+    m_overflowPolicy = OverflowPolicy::DROP;
+  }
+
+  if (m_overflowPolicy == OverflowPolicy::BYPASS) {
+    // A redirected parent fetches the child data with our prefix as forwarding hint; being the
+    // producer region of that prefix makes this node strip the hint and route by the child name
+    NetworkRegionTableHelper::AddRegionName(GetNode(), m_downPrefix);
+  }
+
+  ReduceOp reduction = ReduceOp::SUM;
+  if (!ParseReduceOp(m_reductionRaw, reduction)) {
+    std::cerr << "[" << nodeName << "] AggregatorApp: ERROR - Unknown Reduction '" << m_reductionRaw
+              << "', using sum" << std::endl;
+  }
+
   // init manager with real attrs read from config
-  m_bufferMgr = AggBufferManager(m_bufferCapacity, m_stragglerTimeout);
+  m_bufferMgr = AggBufferManager(m_bufferCapacity, m_stragglerTimeout, m_memoryBudget, reduction);
   std::cout << "[" << nodeName << "] AggregatorApp: BufferManager re-initialized with capacity="
-            << m_bufferCapacity << ", timeout=" << m_stragglerTimeout.ToDouble(Time::S) << "s" << std::endl;
+            << m_bufferCapacity << ", timeout=" << m_stragglerTimeout.ToDouble(Time::S) << "s"
+            << ", memoryBudget=" << m_memoryBudget << "B, overflowPolicy=" << m_overflowPolicyRaw << std::endl;
 
   std::cout << "[" << nodeName << "] AggregatorApp: Serving " << m_downPrefix
                << " -> children={" << m_childPrefixesRaw << "}" << std::endl;
@@ -123,9 +177,15 @@ AggregatorApp::OnInterest(std::shared_ptr<const Interest> interest)
   uint32_t seq = interest->getName().get(-1).toSequenceNumber();
   std::cout << "[" << nodeName << "] AggregatorApp: RX Interest " << interest->getName() << std::endl;
 
+  // A retransmitted Interest for a buffered sequence is not an overflow; Insert reports it as duplicate
+  if (!m_bufferMgr.Contains(seq) && !m_bufferMgr.CanInsert(m_payloadSize) && !HandleOverflow(interest)) {
+    return;
+  }
+
   if (!m_bufferMgr.Insert(seq,
                           interest->getName(),
                           m_childPrefixes.size(),
+                          m_payloadSize,
                           MakeCallback(&AggregatorApp::OnStragglerTimeout, this)))
   {
     // Buffer manager already printed the reason (full or duplicate)
@@ -135,12 +195,7 @@ AggregatorApp::OnInterest(std::shared_ptr<const Interest> interest)
 
   // fan‑out to children
   for (auto const& childPrefix : m_childPrefixes) {
-    // build full child name = childPrefix + suffix after m_downPrefix
-    Name childName = childPrefix;
-    if (interest->getName().size() > m_downPrefix.size()) {
-      auto suffix = interest->getName().getSubName(m_downPrefix.size());
-      childName.append(suffix);
-    }
+    Name childName = MakeChildName(childPrefix, interest->getName());
     auto childInterest = std::make_shared<Interest>();
     childInterest->setName(childName);
     childInterest->setCanBePrefix(false); // Assuming leaves expect exact match
@@ -184,48 +239,41 @@ AggregatorApp::OnData(std::shared_ptr<const Data> data)
     return;
   }
 
-  // extract integer payload safely
-  int value = 0;
-  {
-    const ::ndn::Block& block = data->getContent();
-    if (block.hasValue()) {
-        size_t copyLen = std::min(block.value_size(), sizeof(value));
-        std::memcpy(&value, block.value(), copyLen);
-        if (copyLen < sizeof(value)) {
-             std::cout << "[" << nodeName << "] AggregatorApp: WARNING - Received Data payload smaller than expected size for seq=" << seq
-                       << ". Size=" << block.value_size() << ", expected=" << sizeof(value) << ". Using partial value." << std::endl;
-        }
-    } else {
-         std::cout << "[" << nodeName << "] AggregatorApp: WARNING - Received Data has no content payload for seq=" << seq << ". Using value 0." << std::endl;
+  if (data->getContentType() == ::ndn::tlv::ContentType_Link) {
+    // The child aggregator had no room: its raw children count toward this round instead
+    FetchBypassChildren(*data, *buf);
+    return;
+  }
+
+  // accumulate the integer payload element-wise, straight into the parent Data
+  const ::ndn::Block& block = data->getContent();
+  if (block.hasValue()) {
+    size_t added = buf->AddPayload(block.value(), block.value_size(), ReadContributions(*data));
+    if (added * sizeof(int) < m_payloadSize) {
+      std::cout << "[" << nodeName << "] AggregatorApp: WARNING - Received Data payload smaller than expected size for seq=" << seq
+                << ". Size=" << block.value_size() << ", expected=" << m_payloadSize << ". Using partial value." << std::endl;
     }
+  } else {
+    std::cout << "[" << nodeName << "] AggregatorApp: WARNING - Received Data has no content payload for seq=" << seq << ". Using value 0." << std::endl;
   }
 
-  buf->AddValue(value);
   buf->IncrementResponse();
-  std::cout << "[" << nodeName << "] AggregatorApp: Added value=" << value << " to buffer seq=" << seq
-            << ". Count=" << buf->GetReceivedCount() << "/" << buf->GetExpectedCount() << std::endl;
+  std::cout << "[" << nodeName << "] AggregatorApp: Added payload to buffer seq=" << seq
+            << ", aggregate=" << buf->GetSum() << ". Count=" << buf->GetReceivedCount() << "/" << buf->GetExpectedCount() << std::endl;
 
 
   if (buf->IsComplete()) {
     std::cout << "[" << nodeName << "] AggregatorApp: Buffer complete for seq=" << seq << ". Sending aggregated data up." << std::endl;
     Name upName = buf->GetParentInterestName();
-    auto aggData = std::make_shared<Data>();
-    aggData->setName(upName);
-    aggData->setFreshnessPeriod(ndn::time::milliseconds(0)); // Data is immediately stale
-
-    // marshal the sum into a local so & is valid
     int sum = buf->GetSum();
     std::cout << "[" << nodeName << "] AggregatorApp: Aggregated sum=" << sum << " for seq=" << seq << std::endl;
-    // Copy the sum directly into Data’s content (Data::setContent makes an internal copy)
-    aggData->setContent(reinterpret_cast<const uint8_t*>(&sum), sizeof(sum));
-
-    ns3::ndn::common::SetDummySignature(aggData); // Using common utils is fine
-    // aggData->wireEncode(); // Ensure wire format is ready
+    // The sum was accumulated straight into the Data wire laid out at Interest arrival,
+    // so there is nothing left to copy, sign or encode (freshness 0: immediately stale)
+    auto aggData = buf->TakeAggregateData();
 
     std::cout << "[" << nodeName << "] AggregatorApp: AGG send up " << upName << std::endl;
 
     if (m_appLink) {
-      aggData->wireEncode();                             // new
       m_transmittedDatas(aggData, this, m_face);         // optional trace
       m_appLink->onReceiveData(*aggData); // Correct way to send Data up
     } else {
@@ -257,37 +305,166 @@ AggregatorApp::OnStragglerTimeout(uint32_t seq)
       return;
   }
 
-  Name upName = buf->GetParentInterestName();
-  auto aggData = std::make_shared<Data>();
-  aggData->setName(upName);
-  aggData->setFreshnessPeriod(ndn::time::milliseconds(0));
-
-  // local sum for addressability
-  int sum = buf->GetSum();
-  std::cout << "[" << nodeName << "] AggregatorApp: Timeout - Aggregated sum=" << sum << " for seq=" << seq << std::endl;
+  SendPartialUp(seq, *buf, "Timeout");
+}
 
-  // Copy the sum directly into Data’s content
-  aggData->setContent(reinterpret_cast<const uint8_t*>(&sum), sizeof(sum));
+void
+AggregatorApp::SendPartialUp(uint32_t seq, AggBuffer& buf, const std::string& reason)
+{
+  std::string nodeName = Names::FindName(GetNode());
+  Name upName = buf.GetParentInterestName();
+  int sum = buf.GetSum();
+  std::cout << "[" << nodeName << "] AggregatorApp: " << reason << " - Aggregated sum=" << sum << " for seq=" << seq << std::endl;
 
-  ns3::ndn::common::SetDummySignature(aggData);
-  // aggData->wireEncode(); // Ensure wire format is ready
+  // Partial sum is already in place in the preallocated wire
+  auto aggData = buf.TakeAggregateData();
 
-  std::cout << "[" << nodeName << "] AggregatorApp: Timeout-AGG send up " << upName
-               << " (Received " << buf->GetReceivedCount() << "/" << buf->GetExpectedCount() << ")" << std::endl;
+  std::cout << "[" << nodeName << "] AggregatorApp: " << reason << "-AGG send up " << upName
+               << " (Received " << buf.GetReceivedCount() << "/" << buf.GetExpectedCount() << ")" << std::endl;
 
   // Send Data up via AppLink
   if (m_appLink) {
-    aggData->wireEncode();                             // new
     m_transmittedDatas(aggData, this, m_face);         // optional trace
     m_appLink->onReceiveData(*aggData);
   } else {
-     std::cerr << "[" << nodeName << "] AggregatorApp: ERROR - m_appLink is null during timeout handling for " << upName << std::endl;
+     std::cerr << "[" << nodeName << "] AggregatorApp: ERROR - m_appLink is null during " << reason << " handling for " << upName << std::endl;
   }
 
-  buf->MarkReplied(); // Mark as replied *before* removing to prevent race conditions
+  buf.MarkReplied(); // Mark as replied *before* removing to prevent race conditions
   m_bufferMgr.Remove(seq); // Remove after sending
 }
 
+bool
+AggregatorApp::HandleOverflow(std::shared_ptr<const Interest> interest)
+{
+  std::string nodeName = Names::FindName(GetNode());
+  switch (m_overflowPolicy) {
+  case OverflowPolicy::NACK:
+    SendNack(interest);
+    return false;
+
+  case OverflowPolicy::BYPASS:
+    SendBypass(interest);
+    return false;
+
+  case OverflowPolicy::EVICT: {
+    // Oldest rounds are the likeliest to be waiting on stragglers: answer them with what they have
+    uint32_t oldest = 0;
+    while (!m_bufferMgr.CanInsert(m_payloadSize) && m_bufferMgr.FindOldest(oldest)) {
+      std::cout << "[" << nodeName << "] AggregatorApp: Evicting seq=" << oldest
+                << " to make room for " << interest->getName() << std::endl;
+      SendPartialUp(oldest, *m_bufferMgr.Get(oldest), "Evict");
+    }
+    if (m_bufferMgr.CanInsert(m_payloadSize)) {
+      return true;
+    }
+    std::cout << "[" << nodeName << "] AggregatorApp: PayloadSize=" << m_payloadSize
+              << " exceeds MemoryBudget, dropping " << interest->getName() << std::endl;
+    return false;
+  }
+
+  case OverflowPolicy::DROP:
+  default:
+    std::cout << "[" << nodeName << "] AggregatorApp: Buffer full, dropping " << interest->getName() << std::endl;
+    return false;
+  }
+}
+
+void
+AggregatorApp::SendNack(std::shared_ptr<const Interest> interest)
+{
+  std::string nodeName = Names::FindName(GetNode());
+  auto nack = std::make_shared<lp::Nack>(*interest);
+  nack->setReason(lp::NackReason::CONGESTION);
+  std::cout << "[" << nodeName << "] AggregatorApp: Buffer full, NACK(Congestion) " << interest->getName() << std::endl;
+
+  if (m_appLink) {
+    m_transmittedNacks(nack, this, m_face);            // optional trace
+    m_appLink->onReceiveNack(*nack);
+  } else {
+    std::cerr << "[" << nodeName << "] AggregatorApp: ERROR - m_appLink is null when sending NACK for " << interest->getName() << std::endl;
+  }
+}
+
+void
+AggregatorApp::SendBypass(std::shared_ptr<const Interest> interest)
+{
+  std::string nodeName = Names::FindName(GetNode());
+  // Nothing is buffered: the parent gets a Link listing the child data names and fetches the raw
+  // contributions itself (forwarding hint = our prefix, so they are still routed through this node)
+  std::vector<Name> childNames;
+  for (auto const& childPrefix : m_childPrefixes) {
+    childNames.push_back(MakeChildName(childPrefix, interest->getName()));
+  }
+  auto link = std::make_shared<::ndn::Link>(interest->getName());
+  link->setDelegationList(std::move(childNames));
+  link->setFreshnessPeriod(::ndn::time::milliseconds(0));
+  common::SetDummySignature(link);
+  link->wireEncode();
+
+  std::cout << "[" << nodeName << "] AggregatorApp: Buffer full, BYPASS " << interest->getName()
+            << " -> " << m_childPrefixes.size() << " raw children" << std::endl;
+
+  if (m_appLink) {
+    m_transmittedDatas(link, this, m_face);            // optional trace
+    m_appLink->onReceiveData(*link);
+  } else {
+    std::cerr << "[" << nodeName << "] AggregatorApp: ERROR - m_appLink is null when sending bypass for " << interest->getName() << std::endl;
+  }
+}
+
+void
+AggregatorApp::FetchBypassChildren(const Data& redirect, AggBuffer& buf)
+{
+  std::string nodeName = Names::FindName(GetNode());
+  std::vector<Name> children;
+  try {
+    auto delegations = ::ndn::Link(redirect.wireEncode()).getDelegationList();
+    children.assign(delegations.begin(), delegations.end());
+  } catch (const std::exception& e) {
+    std::cerr << "[" << nodeName << "] AggregatorApp: ERROR - Malformed bypass redirect " << redirect.getName()
+              << ": " << e.what() << std::endl;
+    return;
+  }
+
+  if (children.empty()) {
+    return; // that child's share is left to the straggler timeout
+  }
+
+  buf.ReplaceChild(children.size());
+  std::cout << "[" << nodeName << "] AggregatorApp: Bypass redirect " << redirect.getName()
+            << ", fetching " << children.size() << " raw children" << std::endl;
+
+  // As in RootApp: the hint (the child aggregator's prefix) routes the Interests through its node,
+  // which forwards them by name; the child Data then land in this round's buffer by sequence number
+  Name hint = redirect.getName().getPrefix(-1);
+  for (const Name& child : children) {
+    auto interest = std::make_shared<Interest>(child);
+    interest->setCanBePrefix(false);
+    interest->setForwardingHint({hint});
+    interest->setInterestLifetime(::ndn::time::milliseconds(m_stragglerTimeout.GetMilliSeconds()));
+
+    if (m_appLink) {
+      interest->wireEncode();
+      m_transmittedInterests(interest, this, m_face);  // optional trace
+      m_appLink->onReceiveInterest(*interest);
+    } else {
+      std::cerr << "[" << nodeName << "] AggregatorApp: ERROR - m_appLink is null when fetching " << child << std::endl;
+    }
+  }
+}
+
+Name
+AggregatorApp::MakeChildName(const Name& childPrefix, const Name& parentName) const
+{
+  // full child name = childPrefix + suffix after m_downPrefix
+  Name childName = childPrefix;
+  if (parentName.size() > m_downPrefix.size()) {
+    childName.append(parentName.getSubName(m_downPrefix.size()));
+  }
+  return childName;
+}
+
 void
 AggregatorApp::StopApplication()
 {
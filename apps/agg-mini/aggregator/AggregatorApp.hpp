@@ -28,7 +28,24 @@ protected:
   virtual void StopApplication() override;
 
 private:
+  /// What to do with a new round when BufferCapacity or MemoryBudget is exhausted
+  enum class OverflowPolicy {
+    DROP,   ///< drop the parent Interest (it times out upstream)
+    NACK,   ///< answer the parent with a Congestion Nack
+    EVICT,  ///< reply early with the oldest partial aggregate(s) to free room
+    BYPASS  ///< no aggregation: redirect the parent to the raw child rounds
+  };
+
   void OnStragglerTimeout(uint32_t seq);
+  /// Send the (possibly partial) aggregate of seq upstream and release its buffer
+  void SendPartialUp(uint32_t seq, AggBuffer& buf, const std::string& reason);
+  /// Apply the overflow policy to an Interest whose round does not fit; true if it may now be inserted
+  bool HandleOverflow(std::shared_ptr<const Interest> interest);
+  void SendNack(std::shared_ptr<const Interest> interest);
+  void SendBypass(std::shared_ptr<const Interest> interest);
+  /// A child aggregator redirected round seq (Bypass): fetch its listed children into our buffer
+  void FetchBypassChildren(const Data& redirect, AggBuffer& buf);
+  Name MakeChildName(const Name& childPrefix, const Name& parentName) const;
 
   Name                       m_downPrefix;
   std::string                m_childPrefixesRaw;
@@ -36,6 +53,11 @@ private:
 
   uint32_t                   m_bufferCapacity;      // max concurrent seqs
   Time                       m_stragglerTimeout;    // timeout for stragglers
+  uint32_t                   m_payloadSize;         // bytes of each round's aggregate
+  uint32_t                   m_memoryBudget;        // bytes of aggregation state (0 = unlimited)
+  std::string                m_overflowPolicyRaw;
+  std::string                m_reductionRaw;
+  OverflowPolicy             m_overflowPolicy;
   AggBufferManager           m_bufferMgr;           // <<< manager instance
 };
 
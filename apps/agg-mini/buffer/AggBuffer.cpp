@@ -1,25 +1,57 @@
 #include "AggBuffer.hpp"
+#include <algorithm>
+#include <cstring>
 
 namespace ns3 {
 namespace ndn {
 
-AggBuffer::AggBuffer(uint32_t expectedCount, const ::ndn::Name& parentInterestName)
-  : m_expectedCount(expectedCount)
+AggBuffer::AggBuffer()
+  : m_expectedCount(0)
   , m_receivedCount(0)
+  , m_contributions(0)
   , m_sum(0)
+  , m_elements(0)
+  , m_replied(false)
+{
+}
+
+AggBuffer::AggBuffer(uint32_t expectedCount, const ::ndn::Name& parentInterestName, size_t payloadSize,
+                     ReduceOp reduction)
+  : m_expectedCount(expectedCount)
+  , m_receivedCount(0)
+  , m_contributions(0)
+  , m_reducer(reduction)
+  , m_elements(ElementCount(payloadSize))
   , m_replied(false)
   , m_parentInterestName(parentInterestName)
+  , m_created(Simulator::Now())
 {
+  // Name, MetaInfo (freshness 0), zeroed Content and dummy signature are encoded once here
+  m_outData.Prepare(m_parentInterestName, ::ndn::time::milliseconds(0), m_elements * sizeof(int),
+                    m_reducer.CountsContributions() ? AGG_TLV_CONTRIBUTIONS : 0);
+  m_reducer.Fill(m_outData.Content(), m_elements);
+  m_sum = m_reducer.Identity();
 }
 
 AggBuffer::~AggBuffer()
 {
 }
 
-void
-AggBuffer::AddValue(int value)
+size_t
+AggBuffer::ElementCount(size_t payloadSize)
 {
-  m_sum += value;
+  return std::max<size_t>(1, (payloadSize + sizeof(int) - 1) / sizeof(int));
+}
+
+size_t
+AggBuffer::AddPayload(const uint8_t* value, size_t size, uint32_t contributions)
+{
+  m_contributions += contributions;
+  size_t n = size / sizeof(int);
+  uint8_t* out = m_outData.Content();
+  m_reducer.Combine(out, m_elements, value, n);
+  std::memcpy(&m_sum, out, sizeof(m_sum));
+  return std::min(m_elements, n);
 }
 
 void
@@ -28,6 +60,12 @@ AggBuffer::IncrementResponse()
   ++m_receivedCount;
 }
 
+void
+AggBuffer::ReplaceChild(uint32_t count)
+{
+  m_expectedCount = m_expectedCount - 1 + count;
+}
+
 uint32_t
 AggBuffer::GetExpectedCount() const
 {
@@ -40,6 +78,12 @@ AggBuffer::GetReceivedCount() const
   return m_receivedCount;
 }
 
+uint32_t
+AggBuffer::GetContributions() const
+{
+  return m_contributions;
+}
+
 int
 AggBuffer::GetSum() const
 {
@@ -90,5 +134,26 @@ AggBuffer::GetParentInterestName() const
   return m_parentInterestName;
 }
 
+Time
+AggBuffer::GetCreationTime() const
+{
+  return m_created;
+}
+
+size_t
+AggBuffer::GetMemoryBytes() const
+{
+  return m_elements * sizeof(int);
+}
+
+std::shared_ptr<Data>
+AggBuffer::TakeAggregateData()
+{
+  if (m_reducer.CountsContributions()) {
+    m_outData.SetAppMetaInfo(m_contributions);
+  }
+  return m_outData.Finalize();
+}
+
 } // namespace ndn
 } // namespace ns3
\ No newline at end of file
@@ -4,19 +4,31 @@
 #include <ndn-cxx/name.hpp>
 #include "ns3/event-id.h"
 #include "ns3/simulator.h"
+#include "../../agg-common/agg-name.hpp"
+#include "../../agg-common/preallocated-data.hpp"
+#include "../../agg-common/reduction.hpp"
 
 namespace ns3 {
 namespace ndn {
 
 class AggBuffer {
 public:
-  AggBuffer(uint32_t expectedCount, const ::ndn::Name& parentInterest);
+  AggBuffer(); // empty round-table slot; no Data wire is laid out
+  /// \param payloadSize bytes of the aggregate (rounded up to whole int elements, at least one)
+  /// \param reduction   how child payloads are combined
+  AggBuffer(uint32_t expectedCount, const ::ndn::Name& parentInterest, size_t payloadSize = sizeof(int),
+            ReduceOp reduction = ReduceOp::SUM);
   ~AggBuffer();
 
-  void AddValue(int value);
+  /// Fold a child payload (host ints, as leaves send them) covering \p contributions leaf
+  /// values into the aggregate; returns the elements it provided, up to the aggregate's
+  size_t   AddPayload(const uint8_t* value, size_t size, uint32_t contributions = 1);
   void IncrementResponse();
+  /// A child answered with a Bypass redirect: its \p count listed children answer in its place
+  void ReplaceChild(uint32_t count);
   uint32_t GetExpectedCount() const;
   uint32_t GetReceivedCount() const;
+  uint32_t GetContributions() const;
   int      GetSum() const;
   bool     IsComplete() const;
   void     MarkReplied();
@@ -27,14 +39,29 @@ public:
   void     CancelTimeoutEvent();
 
   const ::ndn::Name& GetParentInterestName() const;
+  Time     GetCreationTime() const;
+  /// Bytes of aggregation state this round holds (its accumulator)
+  size_t   GetMemoryBytes() const;
+
+  /// Ints an aggregate of payloadSize bytes is accumulated in
+  static size_t ElementCount(size_t payloadSize);
+
+  /// Data answering the parent; its content region holds the running aggregate (a mean
+  /// undivided, with its leaf count in AppMetaInfo: only the root divides)
+  std::shared_ptr<Data> TakeAggregateData();
 
 private:
   uint32_t       m_expectedCount;
   uint32_t       m_receivedCount;
-  int            m_sum;
+  uint32_t       m_contributions; // leaf values the aggregate covers
+  int            m_sum;           // first element of the aggregate
+  Reducer<int>   m_reducer;
+  size_t         m_elements;      // ints in the aggregate
   bool           m_replied;
   ::ndn::Name    m_parentInterestName;
+  Time           m_created;
   EventId        m_timeoutEvent;
+  PreallocatedData m_outData;   // parent Data wire, laid out when the Interest arrives
 };
 
 } // namespace ndn
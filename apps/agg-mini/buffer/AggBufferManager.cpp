@@ -8,44 +8,66 @@
 namespace ns3 {
 namespace ndn {
 
-AggBufferManager::AggBufferManager(uint32_t capacity, Time timeout)
+AggBufferManager::AggBufferManager(uint32_t capacity, Time timeout, size_t memoryBudget,
+                                   ReduceOp reduction)
   : m_capacity(capacity)
   , m_timeout(timeout)
+  , m_memoryBudget(memoryBudget)
+  , m_bytesInUse(0)
+  , m_reduction(reduction)
+  , m_map(capacity)
 {
   std::cout << "AggBufferManager: Initialized with capacity=" << m_capacity
-            << ", timeout=" << m_timeout.ToDouble(Time::S) << "s" << std::endl;
+            << ", timeout=" << m_timeout.ToDouble(Time::S) << "s"
+            << ", memoryBudget=" << m_memoryBudget << "B"
+            << ", reduction=" << ReduceOpName(m_reduction) << std::endl;
 }
 
 bool
-AggBufferManager::CanInsert() const
+AggBufferManager::CanInsert(size_t payloadSize) const
 {
-  bool can = m_map.size() < m_capacity;
-  if (!can) {
-      std::cout << "AggBufferManager: Cannot insert, buffer full (size=" << m_map.size()
+  if (m_map.Size() >= m_capacity) {
+      std::cout << "AggBufferManager: Cannot insert, buffer full (size=" << m_map.Size()
                 << ", capacity=" << m_capacity << ")" << std::endl;
+      return false;
   }
-  return can;
+  size_t bytes = AggBuffer::ElementCount(payloadSize) * sizeof(int);
+  if (m_memoryBudget != 0 && m_bytesInUse + bytes > m_memoryBudget) {
+      std::cout << "AggBufferManager: Cannot insert, memory budget exhausted (inUse=" << m_bytesInUse
+                << "B, need=" << bytes << "B, budget=" << m_memoryBudget << "B)" << std::endl;
+      return false;
+  }
+  return true;
 }
 
 bool
 AggBufferManager::Insert(uint32_t seq,
                          const ::ndn::Name& parentName,
                          uint32_t expectedCount,
+                         size_t payloadSize,
                          TimeoutCallback onTimeout)
 {
-  if (m_map.count(seq) > 0) {
+  if (m_map.Find(seq) != nullptr) {
     std::cout << "AggBufferManager: Cannot insert, duplicate seq=" << seq << std::endl;
     return false;
   }
-  if (!CanInsert()) {
+  if (!CanInsert(payloadSize)) {
     // CanInsert already printed the reason
     return false;
   }
 
-  // Create one buffer entry
-  auto buf = std::make_unique<AggBuffer>(expectedCount, parentName);
+  // Claim the sequence's slot and create the buffer entry in place
+  AggBuffer* buf = m_map.Insert(seq);
+  if (!buf) {
+    std::cout << "AggBufferManager: Cannot insert seq=" << seq
+              << ", its slot is held by an older sequence (table size=" << m_map.Capacity() << ")" << std::endl;
+    return false;
+  }
+  *buf = AggBuffer(expectedCount, parentName, payloadSize, m_reduction);
+  m_bytesInUse += buf->GetMemoryBytes();
   std::cout << "AggBufferManager: Inserting buffer for seq=" << seq
-            << ", parent=" << parentName << ", expecting=" << expectedCount << std::endl;
+            << ", parent=" << parentName << ", expecting=" << expectedCount
+            << ", bytesInUse=" << m_bytesInUse << std::endl;
 
   // Schedule a lambda that simply calls your onTimeout(seq)
   auto timeoutFn = [onTimeout, seq]() {
@@ -57,15 +79,13 @@ AggBufferManager::Insert(uint32_t seq,
   std::cout << "AggBufferManager: Scheduled timeout event " << ev.GetUid()
             << " for seq=" << seq << " in " << m_timeout.ToDouble(Time::S) << "s" << std::endl;
 
-  m_map.emplace(seq, std::move(buf));
   return true;
 }
 
 AggBuffer*
-AggBufferManager::Get(uint32_t seq) const
+AggBufferManager::Get(uint32_t seq)
 {
-  auto it = m_map.find(seq);
-  AggBuffer* bufPtr = (it == m_map.end()) ? nullptr : it->second.get();
+  AggBuffer* bufPtr = m_map.Find(seq);
   if (!bufPtr) {
       std::cout << "AggBufferManager: Get failed for seq=" << seq << ", buffer not found." << std::endl;
   } else {
@@ -74,14 +94,48 @@ AggBufferManager::Get(uint32_t seq) const
   return bufPtr;
 }
 
+bool
+AggBufferManager::Contains(uint32_t seq) const
+{
+  return m_map.Find(seq) != nullptr;
+}
+
+bool
+AggBufferManager::FindOldest(uint32_t& seq)
+{
+  bool found = false;
+  Time oldest;
+  m_map.ForEach([&] (uint64_t s, AggBuffer& buf) {
+    if (!found || buf.GetCreationTime() < oldest) {
+      found = true;
+      oldest = buf.GetCreationTime();
+      seq = static_cast<uint32_t>(s);
+    }
+  });
+  return found;
+}
+
+size_t
+AggBufferManager::GetBytesInUse() const
+{
+  return m_bytesInUse;
+}
+
+size_t
+AggBufferManager::GetMemoryBudget() const
+{
+  return m_memoryBudget;
+}
+
 void
 AggBufferManager::Remove(uint32_t seq)
 {
-  auto it = m_map.find(seq);
-  if (it != m_map.end()) {
+  AggBuffer* buf = m_map.Find(seq);
+  if (buf) {
     std::cout << "AggBufferManager: Removing buffer for seq=" << seq << std::endl;
-    it->second->CancelTimeoutEvent(); // Cancel associated timeout event
-    m_map.erase(it);
+    buf->CancelTimeoutEvent(); // Cancel associated timeout event
+    m_bytesInUse -= buf->GetMemoryBytes();
+    m_map.Erase(seq);
   } else {
     std::cout << "AggBufferManager: Remove called for non-existent seq=" << seq << std::endl;
   }
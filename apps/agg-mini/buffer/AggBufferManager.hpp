@@ -2,10 +2,9 @@
 #define AGG_BUFFER_MANAGER_HPP
 
 #include "AggBuffer.hpp"
+#include "../../agg-common/round-table.hpp"
 #include "ns3/callback.h"
 #include "ns3/simulator.h"
-#include <map>
-#include <memory>
 
 namespace ns3 {
 namespace ndn {
@@ -14,6 +13,13 @@ namespace ndn {
  * \brief Manages multiple AggBuffer entries (one per sequence).
  * Enforces a maximum capacity (number of parallel sequences),
  * and schedules a timeout event per entry.
+ *
+ * Entries live in a RoundTable sized to the capacity (rounded up to a
+ * power of two), so lookups are O(1) and inserting does not allocate.
+ *
+ * Besides the entry count, the bytes of aggregation state held by the
+ * entries (their accumulators, see AggBuffer::GetMemoryBytes) can be
+ * capped by a memory budget (0 = no byte limit).
  */
 class AggBufferManager {
 public:
@@ -23,27 +29,42 @@ public:
   /**
    * \param capacity    Max concurrent sequence buffers
    * \param timeout     Straggler timeout duration
+   * \param memoryBudget  Max bytes of aggregation state (0 = unlimited)
+   * \param reduction   How the entries combine child payloads
    */
-  AggBufferManager(uint32_t capacity, Time timeout);
+  AggBufferManager(uint32_t capacity, Time timeout, size_t memoryBudget = 0,
+                   ReduceOp reduction = ReduceOp::SUM);
 
-  /// Can we insert a new sequence?
-  bool CanInsert() const;
+  /// Can we insert a new sequence holding a payloadSize-byte aggregate?
+  bool CanInsert(size_t payloadSize = sizeof(int)) const;
 
   /**
    * Insert a new buffer entry for seq.
    * \param seq           Sequence ID
    * \param parentName    Name of the incoming Interest
    * \param expectedCount Number of child contributions to wait for
+   * \param payloadSize   Bytes of the aggregate
    * \param onTimeout     Callback(seq) when straggler‐timeout fires
-   * \returns true if inserted; false if capacity exceeded
+   * \returns true if inserted; false if capacity or memory budget exceeded,
+   *          or seq's slot is still held by an older, unfinished sequence
    */
   bool Insert(uint32_t seq,
               const ::ndn::Name& parentName,
               uint32_t expectedCount,
+              size_t payloadSize,
               TimeoutCallback onTimeout);
 
   /// Retrieve the buffer entry for seq (or nullptr if missing)
-  AggBuffer* Get(uint32_t seq) const;
+  AggBuffer* Get(uint32_t seq);
+
+  /// Is there an entry for seq? (quiet lookup)
+  bool Contains(uint32_t seq) const;
+
+  /// Sequence of the oldest entry; false if there are none
+  bool FindOldest(uint32_t& seq);
+
+  size_t GetBytesInUse() const;
+  size_t GetMemoryBudget() const;
 
   /// Erase and cancel timeout for seq
   void Remove(uint32_t seq);
@@ -51,7 +72,10 @@ public:
 private:
   uint32_t                                            m_capacity;
   Time                                                m_timeout;
-  std::map<uint32_t, std::unique_ptr<AggBuffer>>      m_map;
+  size_t                                              m_memoryBudget;
+  size_t                                              m_bytesInUse;
+  ReduceOp                                            m_reduction;
+  RoundTable<AggBuffer>                               m_map;
 };
 
 } // namespace ndn
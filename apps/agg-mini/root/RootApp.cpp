@@ -10,6 +10,8 @@
 #include "ns3/names.h"     // For Names::FindName
 #include <iostream>        // For std::cout, std::endl
 #include <string>          // For std::string
+#include <limits>
+#include <ndn-cxx/link.hpp> // For ndn::Link (bypass redirects)
 
 // NS_LOG_COMPONENT_DEFINE("ndn.RootApp"); // Replaced with std::cout
 
@@ -34,7 +36,12 @@ RootApp::GetTypeId()
                     UintegerValue(100),
                     MakeUintegerAccessor(&RootApp::GetMaxSeq,  // Use RootApp methods
                                         &RootApp::SetMaxSeq),  // Not Consumer methods
-                    MakeUintegerChecker<uint32_t>());
+                    MakeUintegerChecker<uint32_t>())
+      .AddAttribute("Reduction", "How the raw child data of bypassed rounds is combined "
+                    "(sum, max, min, mean, topk, or; the aggregators' Reduction)",
+                    StringValue("sum"),
+                    MakeStringAccessor(&RootApp::m_reductionRaw),
+                    MakeStringChecker());
   return tid;
 }
 
@@ -70,6 +77,12 @@ RootApp::StartApplication() // Override to add logging
 {
     Consumer::StartApplication(); // Call base class
     std::string nodeName = Names::FindName(GetNode());
+    ReduceOp reduction = ReduceOp::SUM;
+    if (!ParseReduceOp(m_reductionRaw, reduction)) {
+        std::cerr << "[" << nodeName << "] RootApp: ERROR - Unknown Reduction '" << m_reductionRaw
+                  << "', using sum" << std::endl;
+    }
+    m_reducer = Reducer<int>(reduction);
     std::cout << "[" << nodeName << "] RootApp: StartApplication called. Sending Interests for prefix "
               << m_interestName << " up to seq=" << m_seqMax << " every " << m_interval << "s." << std::endl;
     // ScheduleNextPacket is called by Consumer::StartApplication
@@ -79,6 +92,10 @@ void
 RootApp::StopApplication() // Override to add logging
 {
     Consumer::StopApplication(); // Call base class
+    for (auto& entry : m_bypassRounds) {
+        Simulator::Cancel(entry.second.timeout);
+    }
+    m_bypassRounds.clear();
     std::string nodeName = Names::FindName(GetNode());
     std::cout << "[" << nodeName << "] RootApp: StopApplication called." << std::endl;
 }
@@ -137,12 +154,26 @@ RootApp::OnData(std::shared_ptr<const Data> data)
     std::string nodeName = Names::FindName(GetNode());
     std::cout << "[" << nodeName << "] RootApp: Received Data " << data->getName() << std::endl;
 
-    // Extract and print the sum (assuming it's an int)
+    if (!m_interestName.isPrefixOf(data->getName())) {
+        // Raw child data of a bypassed round; it answers none of Consumer's Interests
+        App::OnData(data);
+        OnBypassChildData(*data);
+        return;
+    }
+    if (data->getContentType() == ::ndn::tlv::ContentType_Link) {
+        // The aggregator had no room for this round and pointed us at its children instead
+        FetchBypassChildren(*data);
+        Consumer::OnData(data);
+        return;
+    }
+
+    // Extract and print the sum (assuming it's an int); a mean arrives undivided with its leaf count
     int receivedSum = 0;
     const auto& content = data->getContent();
     if (content.hasValue() && content.value_size() >= sizeof(receivedSum)) {
         std::memcpy(&receivedSum, content.value(), sizeof(receivedSum));
-        std::cout << "[" << nodeName << "] RootApp: Received aggregated sum = " << receivedSum << " for " << data->getName() << std::endl;
+        receivedSum = m_reducer.Finalize(receivedSum, ReadContributions(*data));
+        std::cout << "[" << nodeName << "] RootApp: Received aggregated " << ReduceOpName(m_reducer.GetOp()) << " = " << receivedSum << " for " << data->getName() << std::endl;
     } else {
         std::cout << "[" << nodeName << "] RootApp: WARNING - Received Data has missing or undersized content for " << data->getName() << std::endl;
     }
@@ -151,6 +182,98 @@ RootApp::OnData(std::shared_ptr<const Data> data)
     Consumer::OnData(data);
 }
 
+void
+RootApp::FetchBypassChildren(const Data& redirect)
+{
+    std::string nodeName = Names::FindName(GetNode());
+    std::vector<Name> children;
+    try {
+        auto delegations = ::ndn::Link(redirect.wireEncode()).getDelegationList();
+        children.assign(delegations.begin(), delegations.end());
+    } catch (const std::exception& e) {
+        std::cout << "[" << nodeName << "] RootApp: WARNING - Malformed bypass redirect " << redirect.getName()
+                  << ": " << e.what() << std::endl;
+        return;
+    }
+    uint32_t seq = redirect.getName().get(-1).toSequenceNumber();
+    if (m_bypassRounds.count(seq) > 0 || children.empty()) {
+        return;
+    }
+
+    BypassRound& round = m_bypassRounds[seq];
+    round.name = redirect.getName();
+    round.expected = children.size();
+    std::cout << "[" << nodeName << "] RootApp: Bypass redirect for " << redirect.getName()
+              << ", fetching " << children.size() << " raw children" << std::endl;
+
+    // The hint (the aggregator's prefix) routes the child Interests through the aggregator node,
+    // which forwards them by name to its children without involving its app
+    Name hint = redirect.getName().getPrefix(-1);
+    for (const Name& child : children) {
+        auto interest = std::make_shared<Interest>(child);
+        interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
+        interest->setCanBePrefix(false);
+        interest->setForwardingHint({hint});
+        interest->setInterestLifetime(time::milliseconds(m_interestLifeTime.GetMilliSeconds()));
+        m_transmittedInterests(interest, this, m_face);
+        m_appLink->onReceiveInterest(*interest);
+    }
+    round.timeout = Simulator::Schedule(m_interestLifeTime, &RootApp::FinishBypassRound, this, seq);
+}
+
+void
+RootApp::OnBypassChildData(const Data& data)
+{
+    std::string nodeName = Names::FindName(GetNode());
+    if (data.getName().empty() || !data.getName().get(-1).isSequenceNumber()) {
+        std::cout << "[" << nodeName << "] RootApp: WARNING - Unexpected Data " << data.getName() << std::endl;
+        return;
+    }
+    auto it = m_bypassRounds.find(data.getName().get(-1).toSequenceNumber());
+    if (it == m_bypassRounds.end()) {
+        std::cout << "[" << nodeName << "] RootApp: Late child Data " << data.getName() << ", ignoring." << std::endl;
+        return;
+    }
+
+    // Reduce the whole payload like an aggregator would; a longer child grows the aggregate
+    BypassRound& round = it->second;
+    const auto& content = data.getContent();
+    size_t count = content.value_size() / sizeof(int);
+    size_t elements = round.aggregate.size() / sizeof(int);
+    if (count > elements) {
+        round.aggregate.resize(count * sizeof(int));
+        m_reducer.Fill(round.aggregate.data() + elements * sizeof(int), count - elements);
+        elements = count;
+    }
+    m_reducer.Combine(round.aggregate.data(), elements, content.value(), count);
+    round.contributions += ReadContributions(data);
+    round.received++;
+    if (round.received >= round.expected) {
+        FinishBypassRound(it->first);
+    }
+}
+
+void
+RootApp::FinishBypassRound(uint32_t seq)
+{
+    auto it = m_bypassRounds.find(seq);
+    if (it == m_bypassRounds.end()) {
+        return;
+    }
+    BypassRound& round = it->second;
+    int value = m_reducer.Identity();
+    if (!round.aggregate.empty()) {
+        m_reducer.Finalize(round.aggregate.data(), round.aggregate.size() / sizeof(int), round.contributions);
+        std::memcpy(&value, round.aggregate.data(), sizeof(value));
+    }
+    std::string nodeName = Names::FindName(GetNode());
+    std::cout << "[" << nodeName << "] RootApp: Received aggregated " << ReduceOpName(m_reducer.GetOp()) << " = "
+              << value << " for " << round.name
+              << " (bypassed, " << round.received << "/" << round.expected << " children)" << std::endl;
+    Simulator::Cancel(round.timeout);
+    m_bypassRounds.erase(it);
+}
+
 // Override OnNack if needed
 // void RootApp::OnNack(std::shared_ptr<const lp::Nack> nack) { ... }
 
@@ -3,6 +3,12 @@
 #define NDN_ROOT_APP_H
 
 #include "../../ndn-consumer.hpp"
+#include "../../agg-common/agg-name.hpp"
+#include "../../agg-common/reduction.hpp"
+#include "ns3/event-id.h"
+#include <map>
+#include <string>
+#include <vector>
 
 namespace ns3 {
 namespace ndn {
@@ -34,7 +40,24 @@ protected:
   virtual void ScheduleNextPacket() override;
 
 private:
+  /// A round an aggregator answered with a Link (OverflowPolicy=Bypass): its raw child data is reduced here
+  struct BypassRound {
+    Name     name;                // the round's own Data name
+    uint32_t expected = 0;
+    uint32_t received = 0;
+    uint32_t contributions = 0;     // leaf values the aggregate covers (a mean's divisor)
+    std::vector<uint8_t> aggregate; // running aggregate of the children's int payloads, element-wise
+    EventId  timeout;
+  };
+
+  void FetchBypassChildren(const Data& redirect);
+  void OnBypassChildData(const Data& data);
+  void FinishBypassRound(uint32_t seq);
+
   double m_interval; ///< seconds between Interests
+  std::string m_reductionRaw; ///< reduction of bypassed rounds (the aggregators' Reduction)
+  Reducer<int> m_reducer;
+  std::map<uint32_t, BypassRound> m_bypassRounds;
 };
 
 } // namespace ndn
@@ -3,10 +3,13 @@
 namespace ns3 {
 namespace ndn {
 
-AggregationBuffer::AggregationBuffer(uint32_t expectedCount, const Name& parentInterestName)
+AggregationBuffer::AggregationBuffer(uint32_t expectedCount, const Name& parentInterestName,
+                                     ReduceOp reduction)
   : m_expectedCount(expectedCount)
   , m_receivedCount(0)
-  , m_sum(0)
+  , m_contributions(0)
+  , m_sum(Reducer<int>(reduction).Identity())
+  , m_reducer(reduction)
   , m_replied(false)
   , m_parentInterestName(parentInterestName)
 {
@@ -17,9 +20,10 @@ AggregationBuffer::~AggregationBuffer()
 }
 
 void
-AggregationBuffer::AddValue(int value)
+AggregationBuffer::AddValue(int value, uint32_t contributions)
 {
-  m_sum += value;
+  m_sum = m_reducer.Combine(m_sum, value);
+  m_contributions += contributions;
 }
 
 void
@@ -46,6 +50,24 @@ AggregationBuffer::GetSum() const
   return m_sum;
 }
 
+uint32_t
+AggregationBuffer::GetContributions() const
+{
+  return m_contributions;
+}
+
+bool
+AggregationBuffer::CountsContributions() const
+{
+  return m_reducer.CountsContributions();
+}
+
+int
+AggregationBuffer::GetResult() const
+{
+  return m_reducer.Finalize(m_sum, m_contributions);
+}
+
 bool
 AggregationBuffer::IsComplete() const
 {
@@ -4,6 +4,7 @@
 #include <ndn-cxx/name.hpp>
 #include "ns3/event-id.h"
 #include "ns3/simulator.h"
+#include "../agg-common/reduction.hpp"
 
 namespace ns3 {
 namespace ndn {
@@ -12,11 +13,12 @@ using ::ndn::Name;
 
 class AggregationBuffer {
 public:
-  AggregationBuffer(uint32_t expectedCount, const Name& parentInterestName);
+  AggregationBuffer(uint32_t expectedCount = 0, const Name& parentInterestName = Name(),
+                    ReduceOp reduction = ReduceOp::SUM);
   ~AggregationBuffer();
 
-  // Add a numeric value from a child Data packet.
-  void AddValue(int value);
+  // Fold a numeric value from a child Data packet, covering 'contributions' leaf values, into the aggregate.
+  void AddValue(int value, uint32_t contributions = 1);
 
   // Increment the counter of received responses.
   void IncrementResponse();
@@ -27,9 +29,18 @@ public:
   // Return the number of responses received so far.
   uint32_t GetReceivedCount() const;
 
-  // Return the running sum.
+  // Return the running aggregate (the sum with the default reduction).
   int GetSum() const;
 
+  // Return the number of leaf values the aggregate covers.
+  uint32_t GetContributions() const;
+
+  // Return whether the aggregate goes upstream with its contribution count (a mean, which only the root divides).
+  bool CountsContributions() const;
+
+  // Return the value to log: the aggregate, or for a mean, its division by the leaf values it covers.
+  int GetResult() const;
+
   // Returns true if responses received meet or exceed expected count.
   bool IsComplete() const;
 
@@ -50,7 +61,9 @@ public:
 private:
   uint32_t m_expectedCount;
   uint32_t m_receivedCount;
+  uint32_t m_contributions;
   int m_sum;
+  Reducer<int> m_reducer;
   bool m_replied;
   Name m_parentInterestName;
   ns3::EventId m_timeoutEvent;
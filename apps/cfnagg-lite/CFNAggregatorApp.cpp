@@ -1,10 +1,13 @@
 #include "CFNAggregatorApp.hpp"
 #include "ns3/log.h"
+#include "ns3/uinteger.h"
+#include "ns3/string.h"
 #include "ns3/simulator.h"
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 #include "ns3/ndnSIM/helper/ndn-fib-helper.hpp"
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
-#include <sstream>
+#include "../agg-common/agg-name.hpp"
+#include <charconv>
 #include <cstdlib>
 
 NS_LOG_COMPONENT_DEFINE("ndn.CFNAggregatorApp");
@@ -31,12 +34,24 @@ CFNAggregatorApp::GetTypeId(void)
                             "Prefix that the aggregator will serve to its parent.",
                             NameValue("/"), // Default value
                             MakeNameAccessor(&CFNAggregatorApp::m_prefix),
-                            MakeNameChecker());
+                            MakeNameChecker())
+                          .AddAttribute("MaxRounds",
+                                        "Maximum number of concurrently aggregated rounds (rounded up to a power of two)",
+                                        UintegerValue(256),
+                                        MakeUintegerAccessor(&CFNAggregatorApp::m_maxRounds),
+                                        MakeUintegerChecker<uint32_t>(1))
+                          .AddAttribute("Reduction",
+                                        "How children's values are combined: sum, max, min, mean, topk (max) or or",
+                                        StringValue("sum"),
+                                        MakeStringAccessor(&CFNAggregatorApp::m_reductionName),
+                                        MakeStringChecker());
   return tid;
 }
 
 CFNAggregatorApp::CFNAggregatorApp()
   : m_partialTimeout(MilliSeconds(20))
+  , m_maxRounds(256)
+  , m_reduction(ReduceOp::SUM)
 {
   NS_LOG_FUNCTION(this);
 }
@@ -50,6 +65,12 @@ CFNAggregatorApp::StartApplication()
 {
   App::StartApplication(); // creates m_face
 
+  m_aggBufferMap.Reset(m_maxRounds);
+  m_reduction = ReduceOp::SUM;
+  if (!ParseReduceOp(m_reductionName, m_reduction)) {
+    NS_LOG_WARN("CFNAggregatorApp: Unknown Reduction '" << m_reductionName << "', using sum");
+  }
+
   // Schedule re-insertion after global routing
   Simulator::Schedule(Seconds(0.02), [this] {
     FibHelper::AddRoute(GetNode(), m_prefix, m_face, 0);
@@ -62,10 +83,10 @@ CFNAggregatorApp::StopApplication()
 {
   NS_LOG_FUNCTION(this);
   // Cancel any pending timeout events.
-  for (auto& entry : m_aggBufferMap) {
-    entry.second.CancelTimeoutEvent();
-  }
-  m_aggBufferMap.clear();
+  m_aggBufferMap.ForEach([] (uint64_t, AggregationBuffer& buffer) {
+    buffer.CancelTimeoutEvent();
+  });
+  m_aggBufferMap.Clear();
   App::StopApplication();
 }
 
@@ -88,10 +109,15 @@ CFNAggregatorApp::OnInterest(shared_ptr<const Interest> interest)
   // Create an aggregation buffer entry for this sequence.
   uint32_t expected = m_childrenPrefixes.size();
   
-  // Use emplace to properly construct the AggregationBuffer
-  auto result = m_aggBufferMap.emplace(seq, AggregationBuffer(expected, interest->getName()));
-  auto& buffer = result.first->second;
-  
+  AggregationBuffer* slot = m_aggBufferMap.Insert(seq);
+  if (slot == nullptr) {
+    NS_LOG_WARN("CFNAggregatorApp: Cannot start seq=" << seq << ", already active or round table full ("
+                << m_aggBufferMap.Size() << "/" << m_aggBufferMap.Capacity() << ")");
+    return;
+  }
+  AggregationBuffer& buffer = *slot;
+  buffer = AggregationBuffer(expected, interest->getName(), m_reduction);
+
   // Schedule a timeout for partial aggregation.
   EventId timeoutEvent = Simulator::Schedule(m_partialTimeout, &CFNAggregatorApp::AggregationTimeout, this, seq);
   buffer.SetTimeoutEvent(timeoutEvent);
@@ -128,45 +154,26 @@ void
 CFNAggregatorApp::AggregationTimeout(uint32_t seq)
 {
   NS_LOG_FUNCTION(this << seq);
-  auto it = m_aggBufferMap.find(seq);
-  if (it == m_aggBufferMap.end())
+  AggregationBuffer* found = m_aggBufferMap.Find(seq);
+  if (found == nullptr)
     return;
-  AggregationBuffer& buffer = it->second;
+  AggregationBuffer& buffer = *found;
   
   if (buffer.HasReplied())
     return;
     
-  NS_LOG_INFO("CFNAggregatorApp: Timeout for seq=" << seq << " with partial aggregation sum=" << buffer.GetSum()
+  NS_LOG_INFO("CFNAggregatorApp: Timeout for seq=" << seq << " with partial aggregation result=" << buffer.GetResult()
               << " (" << buffer.GetReceivedCount() << "/" << buffer.GetExpectedCount() << " responses)");
 
   // Produce a Data packet with the (partial) aggregated result.
-  auto data = make_shared<Data>();
-  data->setName(buffer.GetParentInterestName());
-  
-  // Convert ns3::Time to ndn::time::milliseconds
-  ::ndn::time::milliseconds freshness(1000); // 1 second
-  data->setFreshnessPeriod(freshness);
-  
-  std::ostringstream oss;
-  oss << buffer.GetSum();
-  std::string sumStr = oss.str();
-  
-  // Use proper ndn buffer creation
-  auto buffer_content = ::ndn::make_shared<::ndn::Buffer>(sumStr.begin(), sumStr.end());
-  data->setContent(buffer_content);
+  auto data = MakeAggregateData(buffer);
 
-  // Properly create signature info with namespace
-  ::ndn::SignatureInfo signatureInfo(static_cast<::ndn::tlv::SignatureTypeValue>(255));
-  data->setSignatureInfo(signatureInfo);
-  
-  data->wireEncode();
-
-  NS_LOG_INFO("CFNAggregatorApp: Sending (partial) aggregated Data for seq=" << seq << " with sum=" << sumStr);
+  NS_LOG_INFO("CFNAggregatorApp: Sending (partial) aggregated Data for seq=" << seq << " with result=" << buffer.GetResult());
   m_transmittedDatas(data, this, m_face);
   m_appLink->onReceiveData(*data);
 
   buffer.MarkReplied();
-  m_aggBufferMap.erase(it);
+  m_aggBufferMap.Erase(seq);
 }
 
 void
@@ -178,12 +185,12 @@ CFNAggregatorApp::OnData(shared_ptr<const Data> data)
   uint32_t seq = ExtractSequenceNumber(data->getName());
   NS_LOG_INFO("CFNAggregatorApp: Received child Data " << data->getName() << " for seq=" << seq);
 
-  auto it = m_aggBufferMap.find(seq);
-  if (it == m_aggBufferMap.end()) {
+  AggregationBuffer* found = m_aggBufferMap.Find(seq);
+  if (found == nullptr) {
     NS_LOG_WARN("CFNAggregatorApp: No aggregation buffer for seq=" << seq << ", ignoring Data");
     return;
   }
-  AggregationBuffer& buffer = it->second;
+  AggregationBuffer& buffer = *found;
 
   if (buffer.HasReplied()) {
     NS_LOG_WARN("CFNAggregatorApp: Already replied for seq=" << seq << ", ignoring late Data");
@@ -195,44 +202,47 @@ CFNAggregatorApp::OnData(shared_ptr<const Data> data)
                       data->getContent().value_size());
   int value = std::stoi(content);
   
-  buffer.AddValue(value);
+  buffer.AddValue(value, ReadContributions(*data));
   buffer.IncrementResponse();
 
-  NS_LOG_INFO("CFNAggregatorApp: Updated aggregation for seq=" << seq << ": sum=" << buffer.GetSum()
+  NS_LOG_INFO("CFNAggregatorApp: Updated aggregation for seq=" << seq << ": " << ReduceOpName(m_reduction)
+              << "=" << buffer.GetSum()
               << " (" << buffer.GetReceivedCount() << "/" << buffer.GetExpectedCount() << ")");
 
   // If all child responses have been received, cancel the timeout and reply.
   if (buffer.IsComplete()) {
     buffer.CancelTimeoutEvent();
 
-    auto aggData = make_shared<Data>();
-    aggData->setName(buffer.GetParentInterestName());
-    
-    // Convert to proper ndn time format
-    ::ndn::time::milliseconds freshness(1000); // 1 second
-    aggData->setFreshnessPeriod(freshness);
-    
-    std::ostringstream oss;
-    oss << buffer.GetSum();
-    std::string sumStr = oss.str();
-    
-    // Use proper ndn buffer creation
-    auto buffer_content = ::ndn::make_shared<::ndn::Buffer>(sumStr.begin(), sumStr.end());
-    aggData->setContent(buffer_content);
+    auto aggData = MakeAggregateData(buffer);
 
-    // Properly create signature info with namespace
-    ::ndn::SignatureInfo signatureInfo(static_cast<::ndn::tlv::SignatureTypeValue>(255));
-    aggData->setSignatureInfo(signatureInfo);
-    
-    aggData->wireEncode();
-
-    NS_LOG_INFO("CFNAggregatorApp: Sending final aggregated Data for seq=" << seq << " with sum=" << sumStr);
+    NS_LOG_INFO("CFNAggregatorApp: Sending final aggregated Data for seq=" << seq << " with result=" << buffer.GetResult());
     m_transmittedDatas(aggData, this, m_face);
     m_appLink->onReceiveData(*aggData);
 
     buffer.MarkReplied();
-    m_aggBufferMap.erase(it);
+    m_aggBufferMap.Erase(seq);
+  }
+}
+
+shared_ptr<Data>
+CFNAggregatorApp::MakeAggregateData(const AggregationBuffer& buffer)
+{
+  // The result travels as a decimal string, so its length is only known now: lay out the
+  // wire (name, 1 s freshness, dummy signature) and print the digits straight into it.
+  // A mean goes up undivided, with the number of leaf values it covers; the root divides.
+  bool mean = buffer.CountsContributions();
+  char digits[16];
+  auto res = std::to_chars(std::begin(digits), std::end(digits), mean ? buffer.GetSum() : buffer.GetResult());
+  size_t length = static_cast<size_t>(res.ptr - digits);
+
+  PreallocatedData wire;
+  wire.Prepare(buffer.GetParentInterestName(), ::ndn::time::milliseconds(1000), length,
+               mean ? AGG_TLV_CONTRIBUTIONS : 0);
+  std::copy_n(digits, length, wire.Content());
+  if (mean) {
+    wire.SetAppMetaInfo(buffer.GetContributions());
   }
+  return wire.Finalize();
 }
 
 void
@@ -3,9 +3,11 @@
 
 #include "../apps/ndn-app.hpp"
 #include "AggregationBuffer.hpp" // Include the separate class
+#include "../agg-common/preallocated-data.hpp"
+#include "../agg-common/round-table.hpp"
 #include "ns3/simulator.h"
+#include <string>
 #include <vector>
-#include <map>
 
 namespace ns3 {
 namespace ndn {
@@ -37,8 +39,8 @@ private:
   // application's prefix
   Name m_prefix;
 
-  // Map sequence numbers to AggregationBuffer objects
-  std::map<uint32_t, AggregationBuffer> m_aggBufferMap;
+  // Ring of in-flight rounds indexed by sequence number
+  RoundTable<AggregationBuffer> m_aggBufferMap;
 
   // List of child prefixes.
   std::vector<Name> m_childrenPrefixes;
@@ -46,6 +48,13 @@ private:
   // Partial aggregation timeout.
   Time m_partialTimeout;
 
+  // Capacity of the round table
+  uint32_t m_maxRounds;
+
+  // Reduction applied to the children's values ("sum", "max", ...; see ParseReduceOp)
+  std::string m_reductionName;
+  ReduceOp m_reduction;
+
   // Helper to forward an Interest to all child nodes.
   void ForwardInterestToChildren(uint32_t seq);
 
@@ -54,6 +63,9 @@ private:
 
   // Extract the sequence number (assumed to be the last name component).
   uint32_t ExtractSequenceNumber(const Name& name);
+
+  // Build the Data carrying a round's result directly in its preallocated wire encoding.
+  shared_ptr<Data> MakeAggregateData(const AggregationBuffer& buffer);
 };
 
 } // namespace ndn
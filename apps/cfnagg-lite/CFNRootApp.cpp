@@ -4,6 +4,8 @@
 #include "ns3/simulator.h"
 #include "ns3/integer.h" // Include for IntegerValue
 #include "ns3/uinteger.h" // Include for UintegerValue if needed, or just use Integer
+#include "../agg-common/agg-name.hpp"
+#include "../agg-common/reduction.hpp"
 
 // ... other includes ...
 
@@ -148,6 +150,14 @@ CFNRootApp::OnData(shared_ptr<const Data> data)
   uint32_t received_seq = data->getName().at(data->getName().size() - 1).toSequenceNumber();
   std::string content(reinterpret_cast<const char*>(data->getContent().value()),
                       data->getContent().value_size());
+  if (data->getMetaInfo().findAppMetaInfo(AGG_TLV_CONTRIBUTIONS) != nullptr) {
+    // A mean arrives as the sum of all leaf values with their count: divide only here
+    uint32_t contributions = ReadContributions(*data);
+    int mean = Reducer<int>(ReduceOp::MEAN).Finalize(std::stoi(content), contributions);
+    NS_LOG_INFO("CFNRootApp: Received aggregated Data for seq=" << received_seq << " with mean=" << mean
+                << " (sum=" << content << " over " << contributions << " values)");
+    return;
+  }
   NS_LOG_INFO("CFNRootApp: Received aggregated Data for seq=" << received_seq << " with sum=" << content);
 }
 
@@ -3,25 +3,160 @@
 
 #include <vector>
 #include <cstdint>
+#include <algorithm>
 #include "ns3/event-id.h"
-#include "ndn-cxx/name.hpp"
+#include "ns3/nstime.h"
+#include "ndn-cxx/interest.hpp"
+#include "ndn-cxx/data.hpp"
+#include "ndn-cxx/lp/tags.hpp"
+#include "congestion-control.hpp"
+#include "tensor-reduce.hpp"
+#include "../agg-common/preallocated-data.hpp"
+#include "../agg-common/child-bitmap.hpp"
+#include "../agg-common/reduction.hpp"
 
 /** AggregationBuffer: holds partial aggregate data for one sequence round. */
 struct AggregationBuffer {
   uint32_t expectedCount;               // number of children expected
   uint32_t receivedCount;               // number of children responses received so far
-  uint64_t partialSum;                  // aggregated sum of child values received
+  uint64_t partialSum;                  // aggregate of child values received (a sum by default)
+  uint32_t contributions;               // leaf values partialSum combines (a mean's divisor)
+  uint64_t receivedBytes;               // content bytes received from children (congestion control)
+  bool congestionMarked;                // some child Data carried a congestion mark
   ns3::EventId timeoutEvent;           // scheduled timeout event for this round
-  ndn::Name parentInterestName;        // the Interest name from the parent (for aggregator nodes)
-  std::vector<bool> childrenReceived;  // flags to mark which children have responded
+  ns3::Time startTime;                 // when the root sent the round's Interests (RTT samples)
+  std::shared_ptr<const ndn::Interest> parentInterest; // Interest from the parent (aggregator nodes; shared, not copied)
+  ns3::ndn::ChildBitmap childrenReceived; // one bit per child that has responded
+  ns3::ndn::ChildBitmap childrenRequested; // children the round's Interest has gone to (aggregators pace them)
+  ns3::ndn::ChildBitmap groupsReceived; // coded mode: one bit per coding group covered (empty when off)
+  std::vector<ns3::Time> requestTime;  // when each requested child's Interest went out
+  ns3::Time childTimeout;              // straggler deadline of each child, counted from its own request
+  ns3::Time parentExpiry;              // last moment the parent Interest is pending here: the round answers by then
+  ns3::ndn::PreallocatedData outData;  // wire of the Data answering the parent, laid out up front
+
+  // Late-delta mode: the round stays open after its (partial) result went upstream
+  bool partialSent;                    // result already sent/logged; accumulation now holds the delta
+  bool hasDelta;                       // late contributions accumulated since the last report
+  ns3::ndn::ChildBitmap pendingDeltas; // children whose own aggregate was incomplete (deltas to pull)
+  std::vector<uint32_t> childDeltaCount; // delta Interests sent to each child so far
+  std::shared_ptr<const ndn::Interest> deltaInterest; // parent's pending delta request (aggregators)
+
+  bool tensorMode;                     // children carry element arrays instead of one scalar
+  ns3::TensorDType dtype;              // element type of tensor payloads
+  size_t elementCount;                 // number of elements accumulated so far
+  std::vector<uint64_t> accumulator;   // 8-byte aligned storage viewed as an array of dtype
+  ns3::ndn::Reducer<uint64_t> reducer; // how scalar values are combined (tensors are always summed)
 
   AggregationBuffer(uint32_t expCount = 0)
     : expectedCount(expCount)
     , receivedCount(0)
-    , partialSum(0) {
-    if (expCount > 0) {
-      childrenReceived.resize(expCount, false);
+    , partialSum(0)
+    , contributions(0)
+    , receivedBytes(0)
+    , congestionMarked(false)
+    , childrenReceived(expCount)
+    , childrenRequested(expCount)
+    , groupsReceived(0)
+    , requestTime(expCount)
+    , partialSent(false)
+    , hasDelta(false)
+    , pendingDeltas(expCount)
+    , childDeltaCount(expCount, 0)
+    , tensorMode(false)
+    , dtype(ns3::TensorDType::INT64)
+    , elementCount(0) {
+  }
+
+  // Children we may still hear from: never responded, or responded with an incomplete aggregate
+  // (in coded mode, one per group no share has covered yet)
+  uint32_t Outstanding() const {
+    size_t missing = groupsReceived.Size() > 0 ? groupsReceived.Size() - groupsReceived.Count()
+                                               : expectedCount - childrenReceived.Count();
+    return static_cast<uint32_t>(missing + pendingDeltas.Count());
+  }
+
+  // Whether every contribution is in: all children, or in coded mode one share of every group
+  bool Complete() const {
+    if (groupsReceived.Size() > 0) {
+      return groupsReceived.Count() == groupsReceived.Size();
+    }
+    return receivedCount >= expectedCount;
+  }
+
+  // Fold one child's Data content into the round (tensor, or a big-endian value of up to 8 bytes)
+  // covering 'leaves' leaf values (see ndn::ReadContributions)
+  void Accumulate(const ndn::Block& content, uint32_t leaves = 1) {
+    contributions += leaves;
+    if (tensorMode) {
+      AccumulateTensor(content.value(), content.value_size());
+      return;
     }
+    uint64_t val = 0;
+    const uint8_t* contentData = content.value();
+    for (size_t i = 0; i < std::min<size_t>(content.value_size(), 8); ++i) {
+      val = (val << 8) | contentData[i];
+    }
+    partialSum = reducer.Combine(partialSum, val);
+  }
+
+  // Account one child's Data for congestion control: its size and NDNLP congestion mark
+  DeliverySample RecordDelivery(const ndn::Data& data) {
+    DeliverySample sample;
+    sample.bytes = data.getContent().value_size();
+    auto mark = data.getTag<::ndn::lp::CongestionMarkTag>();
+    sample.congestionMarked = mark != nullptr && *mark > 0;
+    receivedBytes += sample.bytes;
+    congestionMarked = congestionMarked || sample.congestionMarked;
+    return sample;
+  }
+
+  // Zero the accumulated value (keeping tensor storage) to start collecting a delta
+  void ResetAccumulation() {
+    partialSum = reducer.Identity();
+    contributions = 0;
+    std::fill(accumulator.begin(), accumulator.end(), 0);
+    elementCount = 0;
+  }
+
+  // Combine scalar values with 'op' instead of summing them
+  void SetReduction(ns3::ndn::ReduceOp op) {
+    reducer = ns3::ndn::Reducer<uint64_t>(op);
+    partialSum = reducer.Identity();
+  }
+
+  // Switch this round to tensor accumulation with the given element type
+  void EnableTensor(ns3::TensorDType type) {
+    tensorMode = true;
+    dtype = type;
+  }
+
+  // Fold one child's payload into the accumulator; a longer child grows it (zero-filled)
+  void AccumulateTensor(const uint8_t* payload, size_t size) {
+    size_t count = size / ns3::TensorWireElementSize(dtype);
+    if (count > elementCount) {
+      size_t bytes = count * ns3::TensorAccumElementSize(dtype);
+      accumulator.resize((bytes + sizeof(uint64_t) - 1) / sizeof(uint64_t), 0);
+      elementCount = count;
+    }
+    ns3::TensorAccumulate(dtype, accumulator.data(), payload, count);
+  }
+
+  // Size in bytes of the wire-encoded aggregate tensor
+  size_t EncodedTensorSize() const {
+    return elementCount * ns3::TensorWireElementSize(dtype);
+  }
+
+  // Write the aggregate tensor (EncodedTensorSize() bytes) to dst
+  void EncodeTensor(uint8_t* dst) const {
+    ns3::TensorEncode(dtype, accumulator.data(), dst, elementCount);
+  }
+
+  // Value reported in logs and traces: the scalar aggregate (a mean divided by the leaf values it
+  // covers), or a checksum of the aggregate tensor. Upstream, a mean travels as partialSum with
+  // its contributions count, so that only the root divides.
+  uint64_t Result() const {
+    return tensorMode ? ns3::TensorChecksum(dtype, accumulator.data(), elementCount)
+                      : reducer.Finalize(partialSum, contributions);
   }
 };
 
@@ -56,17 +56,88 @@ CFNAggregatorApp::GetTypeId() {
                   MakeStringChecker())
     .AddAttribute("ChildTimeout", "Maximum wait time for child Data (seconds)",
                   DoubleValue(1.0), MakeDoubleAccessor(&CFNAggregatorApp::m_childTimeout),
-                  MakeDoubleChecker<double>());
+                  MakeDoubleChecker<double>())
+    .AddAttribute("TimeoutMode", "Straggler timeout: 'fixed' (ChildTimeout) or 'adaptive' "
+                  "(per-child RTT estimate, capped by ChildTimeout)",
+                  StringValue("fixed"), MakeStringAccessor(&CFNAggregatorApp::m_timeoutMode),
+                  MakeStringChecker())
+    .AddAttribute("TimeoutQuantile", "Adaptive mode: quantile of the slowest child's RTT to wait for",
+                  DoubleValue(0.99), MakeDoubleAccessor(&CFNAggregatorApp::m_timeoutQuantile),
+                  MakeDoubleChecker<double>(0.5, 1.0))
+    .AddAttribute("MinChildTimeout", "Adaptive mode: lower bound of the straggler timeout (seconds)",
+                  DoubleValue(0.0001), MakeDoubleAccessor(&CFNAggregatorApp::m_minChildTimeout),
+                  MakeDoubleChecker<double>(0.0))
+    .AddAttribute("TensorType", "Element type of child tensor payloads (int32, int64, float32, bf16); "
+                  "empty to aggregate a single 64-bit value",
+                  StringValue(""), MakeStringAccessor(&CFNAggregatorApp::m_tensorType),
+                  MakeStringChecker())
+    .AddAttribute("MaxRounds", "Maximum number of concurrently aggregated rounds of one job "
+                  "(rounded up to a power of two)",
+                  UintegerValue(256), MakeUintegerAccessor(&CFNAggregatorApp::m_maxRounds),
+                  MakeUintegerChecker<uint32_t>(1))
+    .AddAttribute("MaxNodeRounds", "Rounds aggregated at once across all jobs (0 for no limit); "
+                  "further parent Interests wait and are admitted fairly across jobs",
+                  UintegerValue(0), MakeUintegerAccessor(&CFNAggregatorApp::m_maxNodeRounds),
+                  MakeUintegerChecker<uint32_t>())
+    .AddAttribute("CongestionControl", "Per-child congestion window (None, AIMD, CUBIC, BBR); "
+                  "None forwards every round to every child at once",
+                  StringValue("None"), MakeStringAccessor(&CFNAggregatorApp::m_ccName),
+                  MakeStringChecker())
+    .AddAttribute("MaxPipelinedRounds", "Maximum rounds in flight to each child (0 for no limit); "
+                  "further rounds are queued",
+                  UintegerValue(0), MakeUintegerAccessor(&CFNAggregatorApp::m_maxPipelined),
+                  MakeUintegerChecker<uint32_t>())
+    .AddAttribute("LateDelta", "Keep a round open after a partial result and forward late child "
+                  "contributions to the parent as delta Data",
+                  BooleanValue(false), MakeBooleanAccessor(&CFNAggregatorApp::m_lateDelta),
+                  MakeBooleanChecker())
+    .AddAttribute("LateDeltaWindow", "How long a partially reported round accepts late contributions (seconds)",
+                  DoubleValue(1.0), MakeDoubleAccessor(&CFNAggregatorApp::m_lateDeltaWindow),
+                  MakeDoubleChecker<double>(0.0))
+    .AddAttribute("CodingRedundancy", "Coded aggregation: number of children a round may lose (0 = off). "
+                  "Children form groups of CodingRedundancy+1 whose producers send the same coded share "
+                  "(see their PartitionValues), and a round completes once every group has answered",
+                  UintegerValue(0), MakeUintegerAccessor(&CFNAggregatorApp::m_codingRedundancy),
+                  MakeUintegerChecker<uint32_t>())
+    .AddAttribute("Reduction", "How child values are combined: sum, max, min, mean (over the leaf "
+                  "values received), topk (max for a single value) or or; tensors are always summed",
+                  StringValue("sum"), MakeStringAccessor(&CFNAggregatorApp::m_reductionName),
+                  MakeStringChecker());
   return tid;
 }
 
 CFNAggregatorApp::CFNAggregatorApp()
-  : m_childTimeout(1.0) {
+  : m_childTimeout(1.0)
+  , m_adaptiveTimeout(false)
+  , m_timeoutQuantile(0.99)
+  , m_minChildTimeout(0.0001)
+  , m_traceNode(0)
+  , m_maxRounds(256)
+  , m_maxNodeRounds(0)
+  , m_activeRounds(0)
+  , m_headCredited(false)
+  , m_admitting(false)
+  , m_quantum(1.0)
+  , m_maxPipelined(0)
+  , m_lateDelta(false)
+  , m_lateDeltaWindow(1.0)
+  , m_tensorMode(false)
+  , m_dtype(TensorDType::INT64)
+  , m_codingRedundancy(0)
+  , m_reduction(ndn::ReduceOp::SUM) {
 }
 
 void 
 CFNAggregatorApp::SetChildren(const std::vector<std::string>& children) {
-  m_children = children;
+  AddJob(0, children);
+}
+
+void
+CFNAggregatorApp::AddJob(uint32_t job, const std::vector<std::string>& children, double weight) {
+  Job& entry = m_jobs[job];
+  entry.id = job;
+  entry.children = children;
+  entry.weight = weight > 0 ? weight : 1.0;
 }
 
 void
@@ -87,7 +158,7 @@ CFNAggregatorApp::StartApplication() {
   m_prodFace->setMetric(1);
   // Add producer face to the NDN stack.
   GetNode()->GetObject<ndn::L3Protocol>()->addFace(m_prodFace);
-  // Register the aggregator's prefix on the producer face.
+  // Register the aggregator's prefix on the producer face (it covers every job's /<prefix>/<job>/...).
   ndn::FibHelper::AddRoute(GetNode(), m_prefix, m_prodFace, 0);
   std::cout << "Aggregator " << Names::FindName(GetNode())
             << ": added FIB route for exact prefix " << m_prefix 
@@ -104,23 +175,120 @@ CFNAggregatorApp::StartApplication() {
   
   // Initialize random nonce generator etc.
   m_rand = CreateObject<UniformRandomVariable>();
+
+  m_tensorMode = false;
+  if (!m_tensorType.empty()) {
+    m_tensorMode = ParseTensorDType(m_tensorType, m_dtype);
+    if (!m_tensorMode) {
+      NS_LOG_WARN("Unknown TensorType '" << m_tensorType << "', falling back to scalar aggregation");
+    } else {
+      NS_LOG_INFO("Tensor aggregation enabled [type=" << TensorDTypeToString(m_dtype)
+                  << ", kernel=" << TensorKernelName() << "]");
+    }
+  }
+  m_reduction = ndn::ReduceOp::SUM;
+  if (!ndn::ParseReduceOp(m_reductionName, m_reduction)) {
+    NS_LOG_WARN("Unknown Reduction '" << m_reductionName << "', summing child values");
+  } else if (m_reduction != ndn::ReduceOp::SUM && m_tensorMode) {
+    NS_LOG_WARN("Reduction '" << m_reductionName << "' does not apply to tensors, summing them");
+    m_reduction = ndn::ReduceOp::SUM;
+  }
+  if (m_reduction != ndn::ReduceOp::SUM && m_codingRedundancy > 0) {
+    // Coded shares are sums of partitions
+    NS_LOG_WARN("CodingRedundancy needs Reduction 'sum', coding disabled");
+    m_codingRedundancy = 0;
+  }
+  m_traceNode = TraceCollector::Intern(Names::FindName(GetNode()));
+
+  m_adaptiveTimeout = (m_timeoutMode == "adaptive");
+  if (!m_adaptiveTimeout && m_timeoutMode != "fixed") {
+    NS_LOG_WARN("Unknown TimeoutMode '" << m_timeoutMode << "', using the fixed ChildTimeout");
+  }
+  bool useCc = !(m_ccName.empty() || m_ccName == "None" || m_ccName == "none");
+
+  m_activeRounds = 0;
+  m_activeJobs.clear();
+  m_headCredited = false;
+  m_quantum = 1.0;
+  for (auto& entry : m_jobs) {
+    Job& job = entry.second;
+    // Child Interest prefixes are built once; incoming Data is matched on its first component
+    job.childPrefixes.clear();
+    for (const std::string& child : job.children) {
+      job.childPrefixes.push_back(MakeJobPrefix(child, job.id));
+    }
+    job.childIndex.Assign(job.childPrefixes);
+    job.rtt.Reset(job.children.size(), m_timeoutQuantile);
+
+    // One admission window per child; without congestion control only MaxPipelinedRounds applies
+    job.childWindows.clear();
+    job.childWindows.resize(job.children.size());
+    for (ChildWindow& win : job.childWindows) {
+      if (useCc) {
+        win.cc = MakeCongestionControl(m_ccName);
+      }
+    }
+
+    // Coded mode: one share per group decodes the round's sum
+    uint32_t groups = CodingGroupCount(job.children.size(), m_codingRedundancy);
+    job.childGroup.clear();
+    if (groups > 0) {
+      for (size_t i = 0; i < job.children.size(); ++i) {
+        job.childGroup.push_back(CodingGroupOf(i, job.children.size(), m_codingRedundancy));
+      }
+    } else if (m_codingRedundancy > 0) {
+      NS_LOG_WARN("CodingRedundancy=" << m_codingRedundancy << " needs more than " << m_codingRedundancy
+                  << " children, job " << job.id << " has " << job.children.size() << ": coding disabled");
+    }
+
+    // Every slot starts from this prototype: child bitmap sized, tensor mode decided
+    AggregationBuffer prototype(job.children.size());
+    prototype.groupsReceived.Resize(groups);
+    prototype.SetReduction(m_reduction);
+    if (m_tensorMode) {
+      prototype.EnableTensor(m_dtype);
+    }
+    job.buffers.Reset(m_maxRounds, prototype);
+    job.waiting.clear();
+    job.deficit = 0;
+    // A quantum of the largest round cost lets every job admit a round per turn (at weight 1)
+    m_quantum = std::max(m_quantum, RoundCost(job));
+    NS_LOG_INFO("CFNAggregatorApp job " << job.id << " [children=" << job.children.size()
+                << ", weight=" << job.weight << ", coding groups=" << groups << "]");
+  }
   NS_LOG_INFO("CFNAggregatorApp started on node " << Names::FindName(GetNode())
-              << " [prefix=" << m_prefix << ", children=" << m_children.size() << "]");
+              << " [prefix=" << m_prefix << ", jobs=" << m_jobs.size() << "]");
 }
 
 
 void 
 CFNAggregatorApp::StopApplication() {
-  // Cancel any pending timeouts
-  for (auto& entry : m_buffers) {
-    if (entry.second.timeoutEvent.IsRunning()) {
-      StragglerManager::Cancel(entry.second.timeoutEvent);
+  for (auto& entry : m_jobs) {
+    Job& job = entry.second;
+    // Cancel any pending timeouts
+    job.buffers.ForEach([] (uint64_t, AggregationBuffer& buf) {
+      if (buf.timeoutEvent.IsRunning()) {
+        StragglerManager::Cancel(buf.timeoutEvent);
+      }
+    });
+    job.buffers.Clear();
+    job.waiting.clear();
+    for (ChildWindow& win : job.childWindows) {
+      win.pending.clear();
+      win.inFlight = 0;
     }
   }
-  m_buffers.clear();
+  m_activeRounds = 0;
+  m_activeJobs.clear();
   ndn::App::StopApplication();
 }
 
+CFNAggregatorApp::Job*
+CFNAggregatorApp::FindJob(const ndn::Name& name) {
+  auto it = m_jobs.find(ReadJobId(name));
+  return it == m_jobs.end() ? nullptr : &it->second;
+}
+
 void 
 CFNAggregatorApp::OnInterest(std::shared_ptr<const ndn::Interest> interest) {
   std::cout << "====== INTEREST ARRIVED ======" << std::endl;
@@ -129,47 +297,139 @@ CFNAggregatorApp::OnInterest(std::shared_ptr<const ndn::Interest> interest) {
   NS_LOG_INFO("Aggregator [" << Names::FindName(GetNode()) << "] received Interest: " 
               << interest->getName());
 
+  const ndn::Name& interestName = interest->getName();
+  Job* job = FindJob(interestName);
+  if (job == nullptr) {
+    NS_LOG_WARN("Aggregator is not part of the tree of job " << ReadJobId(interestName)
+                << ", Interest " << interestName << " dropped");
+    return;
+  }
+
   // Parse sequence number from the Interest name (assuming the last name component is a sequence number)
-  ndn::Name interestName = interest->getName();
-  int seq = -1;
-  if (interestName.size() > 0) {
-    std::string seqStr = interestName.get(-1).toUri();
-    try {
-      seq = std::stoi(seqStr);
-    } catch (...) {
-      seq = -1;
-    }
+  uint64_t seq = 0;
+  if (ParseDeltaName(interestName, seq)) {
+    // Parent pulls the late contributions to a round we already reported
+    OnDeltaInterest(*job, interest, seq);
+    return;
   }
-  if (seq < 0) {
+  if (interestName.empty() || !ndn::ReadRoundNumber(interestName.get(-1), seq)) {
     NS_LOG_ERROR("Aggregator could not parse sequence from Interest name " << interestName);
     return;
   }
+  ScheduleRound(*job, interest, seq);
+}
+
+void
+CFNAggregatorApp::ScheduleRound(Job& job, std::shared_ptr<const ndn::Interest> interest, uint64_t seq) {
+  if (m_activeJobs.empty() && NodeHasRoom()) {
+    // No contention: start right away
+    StartRound(job, interest, seq, Simulator::Now());
+    return;
+  }
+  if (job.waiting.empty()) {
+    m_activeJobs.push_back(job.id);
+  }
+  job.waiting.push_back(WaitingRound{interest, seq, Simulator::Now()});
+  NS_LOG_INFO("Aggregator queued job " << job.id << " seq " << seq << " (" << m_activeRounds
+              << " rounds open, " << job.waiting.size() << " of this job waiting)");
+  AdmitWaitingRounds();
+}
+
+bool
+CFNAggregatorApp::NodeHasRoom() const {
+  return m_maxNodeRounds == 0 || m_activeRounds < m_maxNodeRounds;
+}
+
+double
+CFNAggregatorApp::RoundCost(const Job& job) {
+  return std::max<double>(1.0, job.children.size());
+}
 
-  // Create a new AggregationBuffer for this sequence
-  AggregationBuffer buf(m_children.size());
-  buf.parentInterestName = interestName;
-  buf.partialSum = 0;
-  buf.receivedCount = 0;
-  // (childrenReceived vector is initialized to false by AggregationBuffer constructor)
-  m_buffers[seq] = buf;
+void
+CFNAggregatorApp::AdmitWaitingRounds() {
+  // Deficit round robin: each turn credits the head job weight * quantum, and it admits rounds
+  // while its credit covers their cost, so jobs get round capacity in proportion to their weights
+  // whatever their fan-in. A job that runs out of waiting rounds leaves the list and forfeits its credit.
+  if (m_admitting) {
+    return; // a round started below finished at once; the outer loop sees the freed room
+  }
+  m_admitting = true;
+  while (!m_activeJobs.empty() && NodeHasRoom()) {
+    Job& job = m_jobs[m_activeJobs.front()];
+    if (!m_headCredited) {
+      job.deficit += job.weight * m_quantum;
+      m_headCredited = true;
+    }
+    double cost = RoundCost(job);
+    while (!job.waiting.empty() && job.deficit >= cost && NodeHasRoom()) {
+      WaitingRound round = std::move(job.waiting.front());
+      job.waiting.pop_front();
+      if (Simulator::Now() - round.arrival >= MilliSeconds(round.interest->getInterestLifetime().count())) {
+        // The parent has given up on this Interest by now
+        NS_LOG_INFO("Aggregator dropping expired job " << job.id << " seq " << round.seq);
+        continue;
+      }
+      if (StartRound(job, round.interest, round.seq, round.arrival)) {
+        job.deficit -= cost; // a round that could not start costs nothing
+      }
+    }
+    if (job.waiting.empty()) {
+      job.deficit = 0;
+      m_activeJobs.pop_front();
+      m_headCredited = false;
+    } else if (NodeHasRoom()) {
+      // Credit used up: next job's turn
+      m_activeJobs.push_back(m_activeJobs.front());
+      m_activeJobs.pop_front();
+      m_headCredited = false;
+    }
+    // else: the node is full; this job resumes with its remaining credit when a round closes
+  }
+  m_admitting = false;
+}
 
-  // Forward an Interest to each child
-  for (size_t i = 0; i < m_children.size(); ++i) {
-    const std::string& childName = m_children[i];
-    std::string childInterestName = "/" + childName + "/" + std::to_string(seq);
-    auto childInterest = std::make_shared<ndn::Interest>(childInterestName);
-    childInterest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
-    childInterest->setInterestLifetime(ndn::time::milliseconds(static_cast<int>(m_childTimeout * 1000)));
+bool
+CFNAggregatorApp::StartRound(Job& job, std::shared_ptr<const ndn::Interest> interest, uint64_t seq,
+                             Time arrival) {
+  // Claim the round's slot (a fresh copy of the prototype buffer)
+  AggregationBuffer* buf = job.buffers.Insert(seq);
+  if (buf == nullptr) {
+    NS_LOG_WARN("Aggregator cannot start job " << job.id << " seq " << seq << ": already active or round table full"
+                << " (" << job.buffers.Size() << "/" << job.buffers.Capacity() << " rounds), Interest dropped");
+    return false;
+  }
+  ++m_activeRounds;
+  buf->parentInterest = interest;
+  // One tick before the PIT entry of the parent Interest expires (its timer fires first on a tie)
+  buf->parentExpiry = arrival + MilliSeconds(interest->getInterestLifetime().count()) - NanoSeconds(1);
+  if (!buf->tensorMode) {
+    // Lay out the reply now; the 8-byte sum is written into it when the round completes
+    PrepareReply(*buf, interest->getName(), sizeof(uint64_t));
+  }
 
-    NS_LOG_INFO("Aggregator forwarding Interest " << childInterest->getName() 
-                << " to child [" << childName << "]");
-    m_transmittedInterests(childInterest, this, m_face);
-    // m_appLink->onReceiveInterest(*childInterest);
-    m_consFace->sendInterest(*childInterest); // use consumer face
+  // Forward an Interest to each child whose window has room; queue the round for the others
+  for (size_t i = 0; i < job.children.size(); ++i) {
+    if (ChildWindowOpen(job.childWindows[i])) {
+      RequestFromChild(job, seq, *buf, i);
+    } else {
+      job.childWindows[i].pending.push_back(seq);
+    }
   }
 
-  // Schedule a straggler timeout to finalize this aggregation after ChildTimeout seconds
-  m_buffers[seq].timeoutEvent = StragglerManager::ScheduleAggregator(this, seq, m_childTimeout);
+  // Schedule a straggler timeout to finalize this aggregation after ChildTimeout seconds; a child
+  // whose request waits for a window slot gets the same time from when its Interest goes out
+  buf->childTimeout = Seconds(RoundTimeout(job));
+  Time timeout = std::min(buf->childTimeout, buf->parentExpiry - Simulator::Now());
+  buf->timeoutEvent = StragglerManager::ScheduleAggregator(this, job.id, seq, timeout.GetSeconds());
+  return true;
+}
+
+void
+CFNAggregatorApp::ReleaseRound(Job& job, uint64_t seq) {
+  if (job.buffers.Erase(seq)) {
+    --m_activeRounds;
+    AdmitWaitingRounds();
+  }
 }
 
 void 
@@ -177,122 +437,383 @@ CFNAggregatorApp::OnData(std::shared_ptr<const ndn::Data> data) {
   // This is called for Data coming from one of the children
   NS_LOG_INFO("Aggregator [" << Names::FindName(GetNode()) << "] received Data: " 
               << data->getName());
-  // Determine which sequence this data corresponds to
-  ndn::Name dataName = data->getName();
-  int seq = -1;
-  if (dataName.size() > 0) {
-    std::string seqStr = dataName.get(-1).toUri();
-    try {
-      seq = std::stoi(seqStr);
-    } catch (...) {
-      seq = -1;
-    }
+  // Determine which job and sequence this data corresponds to
+  const ndn::Name& dataName = data->getName();
+  Job* job = FindJob(dataName);
+  if (job == nullptr) {
+    NS_LOG_WARN("Aggregator received Data " << dataName << " of an unknown job (ignored)");
+    return;
   }
-  if (seq < 0) {
+  uint64_t seq = 0;
+  bool isDelta = ParseDeltaName(dataName, seq);
+  if (!isDelta && (dataName.empty() || !ndn::ReadRoundNumber(dataName.get(-1), seq))) {
     NS_LOG_WARN("Aggregator couldn't parse sequence from Data name " << dataName);
     return;
   }
 
-  auto it = m_buffers.find(seq);
-  if (it == m_buffers.end()) {
+  AggregationBuffer* found = job->buffers.Find(seq);
+  if (found == nullptr) {
     // This might occur if data arrives after finalization (late straggler)
-    NS_LOG_WARN("Aggregator received unexpected Data for seq " << seq << " (ignored)");
+    NS_LOG_WARN("Aggregator received unexpected Data for job " << job->id << " seq " << seq << " (ignored)");
     return;
   }
-  AggregationBuffer& buf = it->second;
-
-  // Mark one child response received
-  buf.receivedCount++;
-  // Identify which child responded (based on prefix in Data name) and mark as received
-  if (dataName.size() > 0) {
-    std::string childPrefix = dataName.get(0).toUri();
-    for (size_t j = 0; j < m_children.size(); ++j) {
-      if (m_children[j] == childPrefix) {
-        buf.childrenReceived[j] = true;
-        break;
-      }
+  AggregationBuffer& buf = *found;
+
+  // Identify which child responded (based on prefix in Data name)
+  size_t child = job->childIndex.Find(dataName.get(0));
+  if (child == ndn::ChildIndex::NOT_FOUND) {
+    NS_LOG_WARN("Aggregator received Data " << dataName << " from an unknown child (ignored)");
+    return;
+  }
+  if (isDelta) {
+    if (!buf.partialSent || !buf.pendingDeltas.Test(child)) {
+      NS_LOG_WARN("Aggregator received unrequested delta " << dataName << " (ignored)");
+      return;
+    }
+  } else if (!buf.childrenReceived.Set(child)) {
+    // A retransmitted or duplicated reply must not be counted (or summed) twice
+    NS_LOG_INFO("Aggregator ignoring duplicate Data from child [" << job->children[child]
+                << "] for seq " << seq);
+    return;
+  }
+  buf.receivedCount = buf.childrenReceived.Count();
+  if (!isDelta && buf.childrenRequested.Test(child)) {
+    SampleChildRtt(*job, buf, child);
+    DeliverySample sample = buf.RecordDelivery(*data);
+    if (!buf.partialSent) {
+      // (a late straggler's slot was already given up at the round's timeout)
+      sample.rtt = (Simulator::Now() - buf.requestTime[child]).GetSeconds();
+      ReleaseChildWindow(*job, child, &sample);
+    }
+  }
+
+  // Coded mode: a share of a group already covered repeats its sum and is left out
+  if (!isDelta && !job->childGroup.empty() && !buf.groupsReceived.Set(job->childGroup[child])) {
+    NS_LOG_INFO("Aggregator skipping redundant share of child [" << job->children[child]
+                << "] for seq " << seq);
+    return;
+  }
+
+  // Add the child's value (or tensor) to the round, with the leaf values it covers
+  buf.Accumulate(data->getContent(), ndn::ReadContributions(*data));
+  if (m_lateDelta) {
+    // A child that is itself still waiting on part of its subtree will have a delta to pull
+    if (ReadOutstanding(*data) > 0) {
+      buf.pendingDeltas.Set(child);
+    } else {
+      buf.pendingDeltas.Reset(child);
     }
   }
 
-  // Extract the numeric value from the Data content and add to partial sum
-  if (data->getContent().value_size() >= 8) {
-    // If payload is at least 8 bytes, interpret first 8 bytes as network-order 64-bit integer
-    uint64_t netVal;
-    std::memcpy(&netVal, data->getContent().value(), 8);
-    uint64_t val = be64toh(netVal);
-    buf.partialSum += val;
-  } else if (data->getContent().value_size() > 0) {
-    // If payload is smaller, accumulate byte-by-byte as a number
-    uint64_t val = 0;
-    const uint8_t* contentData = data->getContent().value();
-    for (size_t i = 0; i < data->getContent().value_size(); ++i) {
-      val = (val << 8) | contentData[i];
+  if (buf.partialSent) {
+    // Late contribution to a round already reported upstream: it becomes part of the next delta
+    buf.hasDelta = true;
+    if (buf.pendingDeltas.Test(child)) {
+      RequestDelta(*job, seq, buf, child);
     }
-    buf.partialSum += val;
+    TryReportDelta(*job, seq, buf);
+    return;
   }
 
-  // Check if all children have responded
-  if (buf.receivedCount >= buf.expectedCount) {
+  // Check if all children (in coded mode, all groups) have responded
+  if (buf.Complete()) {
     // All expected child data received: cancel the straggler timeout
     if (buf.timeoutEvent.IsRunning()) {
       StragglerManager::Cancel(buf.timeoutEvent);
     }
+    if (!job->childGroup.empty()) {
+      // Children yet to answer would only repeat covered groups: free their slots (no loss signal)
+      for (size_t i = 0; i < job->children.size(); ++i) {
+        if (buf.childrenRequested.Test(i) && !buf.childrenReceived.Test(i)) {
+          ChildWindow& win = job->childWindows[i];
+          if (win.inFlight > 0) {
+            win.inFlight--;
+          }
+          PumpChild(*job, i);
+        }
+      }
+    }
     // Aggregate complete: produce Data to satisfy parent's Interest
-    ndn::Name parentName = buf.parentInterestName;
-    auto outData = std::make_shared<ndn::Data>(parentName);
-    outData->setFreshnessPeriod(ndn::time::seconds(1));
-    // Set content to aggregated sum (8-byte network-order value)
-    uint64_t netSum = htobe64(buf.partialSum);
-    outData->setContent(reinterpret_cast<const uint8_t*>(&netSum), sizeof(netSum));
-    ndn::StackHelper::getKeyChain().sign(*outData);
-
-    NS_LOG_INFO("Aggregator sending aggregated Data " << outData->getName() 
-                << " [aggregated value=" << buf.partialSum << "]");
-    m_transmittedDatas(outData, this, m_face);
-    m_appLink->onReceiveData(*outData);
-
-    // Log the aggregation completion
-    TraceCollector::LogAggregate(Names::FindName(GetNode()), seq, buf.partialSum, 
-                                 buf.expectedCount, buf.receivedCount);
-
-    // Clean up the buffer
-    m_buffers.erase(it);
+    SendAggregate(*job, seq, buf, false);
   }
   // else: still waiting for other children, do nothing until timeout or all arrive
 }
 
 void 
-CFNAggregatorApp::OnStragglerTimeout(int seq) {
+CFNAggregatorApp::OnStragglerTimeout(uint32_t jobId, int seq) {
   // Timeout triggered: not all children responded in time for this sequence
-  auto it = m_buffers.find(seq);
-  if (it == m_buffers.end()) {
+  Job& job = m_jobs[jobId];
+  AggregationBuffer* found = job.buffers.Find(seq);
+  if (found == nullptr || found->partialSent) {
     return; // already finalized
   }
-  AggregationBuffer& buf = it->second;
-  NS_LOG_INFO("Aggregator straggler timeout for seq " << seq 
+  AggregationBuffer& buf = *found;
+
+  // A child asked late (its request was queued behind a full window) or not yet asked at all
+  // still has time: wait for the last of their deadlines, but answer before the parent gives up
+  Time deadline = Simulator::Now();
+  for (size_t i = 0; i < job.children.size(); ++i) {
+    if (buf.childrenReceived.Test(i)) {
+      continue;
+    }
+    Time asked = buf.childrenRequested.Test(i) ? buf.requestTime[i] : Simulator::Now();
+    deadline = std::max(deadline, asked + buf.childTimeout);
+  }
+  deadline = std::min(deadline, std::max(buf.parentExpiry, Simulator::Now()));
+  if (deadline > Simulator::Now()) {
+    buf.timeoutEvent = StragglerManager::ScheduleAggregator(this, jobId, seq,
+                                                            (deadline - Simulator::Now()).GetSeconds());
+    return;
+  }
+
+  NS_LOG_INFO("Aggregator straggler timeout for job " << jobId << " seq " << seq 
               << " (received " << buf.receivedCount << "/" << buf.expectedCount << " children)");
 
   // Create a Data with whatever partial aggregate we have
-  ndn::Name parentName = buf.parentInterestName;
-  auto outData = std::make_shared<ndn::Data>(parentName);
-  outData->setFreshnessPeriod(ndn::time::seconds(1));
-  uint64_t netSum = htobe64(buf.partialSum);
-  outData->setContent(reinterpret_cast<const uint8_t*>(&netSum), sizeof(netSum));
-  ndn::StackHelper::getKeyChain().sign(*outData);
+  for (size_t i = 0; i < job.children.size(); ++i) {
+    if (buf.childrenRequested.Test(i) && !buf.childrenReceived.Test(i)) {
+      if (m_adaptiveTimeout) {
+        // Children still missing took at least this long: let their estimates grow
+        job.rtt.AddSample(i, (Simulator::Now() - buf.requestTime[i]).GetSeconds(), job.buffers.Size());
+      }
+      ReleaseChildWindow(job, i, nullptr);
+    }
+  }
+  SendAggregate(job, seq, buf, true);
+}
 
-  NS_LOG_INFO("Aggregator sending *partial* aggregated Data " << outData->getName() 
-              << " [partial value=" << buf.partialSum 
-              << ", responded " << buf.receivedCount << "/" << buf.expectedCount << "]");
+void
+CFNAggregatorApp::SendAggregate(Job& job, uint64_t seq, AggregationBuffer& buf, bool partial) {
+  // Content is the 8-byte network-order sum, or the summed tensor
+  uint32_t outstanding = m_lateDelta ? buf.Outstanding() : 0;
+  auto outData = MakeAggregateData(buf, buf.parentInterest->getName(), outstanding);
+
+  if (partial) {
+    NS_LOG_INFO("Aggregator sending *partial* aggregated Data " << outData->getName() 
+                << " [partial value=" << buf.Result() 
+                << ", responded " << buf.receivedCount << "/" << buf.expectedCount << "]");
+  } else {
+    NS_LOG_INFO("Aggregator sending aggregated Data " << outData->getName() 
+                << " [aggregated value=" << buf.Result() << "]");
+  }
+  m_transmittedDatas(outData, this, m_face);
+  m_appLink->onReceiveData(*outData);
+
+  // Log the aggregation (complete or partial) event; a coded round counts groups, not children
+  bool coded = buf.groupsReceived.Size() > 0;
+  TraceCollector::LogAggregate(m_traceNode, seq, buf.Result(),
+                               coded ? buf.groupsReceived.Size() : buf.expectedCount,
+                               coded ? buf.groupsReceived.Count() : buf.receivedCount, job.id);
+
+  if (outstanding == 0) {
+    // Clean up the buffer
+    ReleaseRound(job, seq);
+    return;
+  }
 
+  // Keep the round open: from now on the accumulator collects the delta the parent will pull
+  buf.partialSent = true;
+  buf.ResetAccumulation();
+  buf.timeoutEvent = StragglerManager::ScheduleAggregatorDeltaWindow(this, job.id, seq, m_lateDeltaWindow);
+  for (size_t i = 0; i < buf.pendingDeltas.Size(); ++i) {
+    if (buf.pendingDeltas.Test(i)) {
+      RequestDelta(job, seq, buf, i);
+    }
+  }
+}
+
+void
+CFNAggregatorApp::OnDeltaInterest(Job& job, std::shared_ptr<const ndn::Interest> interest, uint64_t seq) {
+  AggregationBuffer* found = job.buffers.Find(seq);
+  if (found == nullptr || !found->partialSent) {
+    // Round closed (or never reported as partial): nothing more will come, say so
+    AggregationBuffer empty;
+    empty.SetReduction(m_reduction);
+    if (m_tensorMode) {
+      empty.EnableTensor(m_dtype);
+    }
+    auto outData = MakeAggregateData(empty, interest->getName(), 0);
+    NS_LOG_INFO("Aggregator sending final empty delta " << outData->getName());
+    m_transmittedDatas(outData, this, m_face);
+    m_appLink->onReceiveData(*outData);
+    return;
+  }
+  found->deltaInterest = interest;
+  TryReportDelta(job, seq, *found);
+}
+
+double
+CFNAggregatorApp::RoundTimeout(const Job& job) const {
+  return m_adaptiveTimeout ? job.rtt.Deadline(m_minChildTimeout, m_childTimeout) : m_childTimeout;
+}
+
+double
+CFNAggregatorApp::ChildInterestLifetime() const {
+  return m_lateDelta ? m_childTimeout + m_lateDeltaWindow : m_childTimeout;
+}
+
+void
+CFNAggregatorApp::SampleChildRtt(Job& job, const AggregationBuffer& buf, size_t child) {
+  if (m_adaptiveTimeout) {
+    job.rtt.AddSample(child, (Simulator::Now() - buf.requestTime[child]).GetSeconds(), job.buffers.Size());
+  }
+}
+
+bool
+CFNAggregatorApp::ChildWindowOpen(const ChildWindow& win) const {
+  if (m_maxPipelined > 0 && win.inFlight >= m_maxPipelined) {
+    return false;
+  }
+  return win.cc == nullptr || win.inFlight < static_cast<uint32_t>(win.cc->GetCwnd());
+}
+
+void
+CFNAggregatorApp::RequestFromChild(Job& job, uint64_t seq, AggregationBuffer& buf, size_t child) {
+  buf.childrenRequested.Set(child);
+  buf.requestTime[child] = Simulator::Now();
+  job.childWindows[child].inFlight++;
+
+  auto childInterest = std::make_shared<ndn::Interest>(ndn::Name(job.childPrefixes[child]).appendSequenceNumber(seq));
+  childInterest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
+  childInterest->setInterestLifetime(ndn::time::milliseconds(static_cast<int>(ChildInterestLifetime() * 1000)));
+
+  NS_LOG_INFO("Aggregator forwarding Interest " << childInterest->getName() 
+              << " to child [" << job.children[child] << "]");
+  m_transmittedInterests(childInterest, this, m_face);
+  // m_appLink->onReceiveInterest(*childInterest);
+  m_consFace->sendInterest(*childInterest); // use consumer face
+}
+
+void
+CFNAggregatorApp::ReleaseChildWindow(Job& job, size_t child, const DeliverySample* delivered) {
+  ChildWindow& win = job.childWindows[child];
+  if (win.inFlight > 0) {
+    win.inFlight--;
+  }
+  if (win.cc != nullptr) {
+    if (delivered != nullptr) {
+      win.cc->OnData(*delivered);
+    } else {
+      win.cc->OnTimeout();
+    }
+  }
+  PumpChild(job, child);
+}
+
+void
+CFNAggregatorApp::PumpChild(Job& job, size_t child) {
+  ChildWindow& win = job.childWindows[child];
+  while (!win.pending.empty() && ChildWindowOpen(win)) {
+    uint64_t seq = win.pending.front();
+    win.pending.pop_front();
+    AggregationBuffer* buf = job.buffers.Find(seq);
+    if (buf == nullptr || buf->partialSent || buf->childrenRequested.Test(child)) {
+      continue; // round already reported (or timed out) while queued
+    }
+    RequestFromChild(job, seq, *buf, child);
+  }
+}
+
+void
+CFNAggregatorApp::RequestDelta(Job& job, uint64_t seq, AggregationBuffer& buf, size_t child) {
+  uint32_t k = ++buf.childDeltaCount[child];
+  auto deltaInterest = std::make_shared<ndn::Interest>(MakeDeltaName(job.childPrefixes[child], seq, k));
+  deltaInterest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
+  deltaInterest->setInterestLifetime(ndn::time::milliseconds(static_cast<int>(m_lateDeltaWindow * 1000)));
+
+  NS_LOG_INFO("Aggregator requesting delta " << deltaInterest->getName()
+              << " from child [" << job.children[child] << "]");
+  m_transmittedInterests(deltaInterest, this, m_face);
+  m_consFace->sendInterest(*deltaInterest);
+}
+
+void
+CFNAggregatorApp::TryReportDelta(Job& job, uint64_t seq, AggregationBuffer& buf) {
+  uint32_t outstanding = buf.Outstanding();
+  if (!buf.deltaInterest) {
+    if (outstanding == 0 && !buf.hasDelta) {
+      // Nothing left to report: a later delta Interest is answered as final
+      StragglerManager::Cancel(buf.timeoutEvent);
+      ReleaseRound(job, seq);
+    }
+    return; // otherwise report once the parent asks
+  }
+  if (!buf.hasDelta && outstanding > 0) {
+    return; // nothing new yet; the parent's Interest waits
+  }
+
+  auto outData = MakeAggregateData(buf, buf.deltaInterest->getName(), outstanding);
+  NS_LOG_INFO("Aggregator sending delta " << outData->getName() << " [delta value=" << buf.Result()
+              << ", still outstanding " << outstanding << "]");
   m_transmittedDatas(outData, this, m_face);
   m_appLink->onReceiveData(*outData);
+  TraceCollector::LogCorrection(m_traceNode, seq, buf.Result(),
+                                buf.expectedCount, buf.receivedCount, job.id);
+
+  buf.deltaInterest.reset();
+  buf.hasDelta = false;
+  buf.ResetAccumulation();
+  if (outstanding == 0) {
+    StragglerManager::Cancel(buf.timeoutEvent);
+    ReleaseRound(job, seq);
+  }
+}
+
+void
+CFNAggregatorApp::OnDeltaWindowClosed(uint32_t jobId, int seq) {
+  Job& job = m_jobs[jobId];
+  AggregationBuffer* found = job.buffers.Find(seq);
+  if (found == nullptr) {
+    return;
+  }
+  AggregationBuffer& buf = *found;
+  if (buf.deltaInterest) {
+    // Flush whatever arrived and tell the parent nothing more will follow
+    auto outData = MakeAggregateData(buf, buf.deltaInterest->getName(), 0);
+    m_transmittedDatas(outData, this, m_face);
+    m_appLink->onReceiveData(*outData);
+    TraceCollector::LogCorrection(m_traceNode, seq, buf.Result(),
+                                  buf.expectedCount, buf.receivedCount, job.id);
+  } else if (buf.hasDelta) {
+    NS_LOG_WARN("Aggregator delta window closed for job " << jobId << " seq " << seq
+                << " before the parent asked; late contributions dropped");
+  }
+  NS_LOG_INFO("Aggregator closing job " << jobId << " seq " << seq << " (received " << buf.receivedCount
+              << "/" << buf.expectedCount << " children)");
+  ReleaseRound(job, seq);
+}
 
-  // Log the partial aggregate event
-  TraceCollector::LogAggregate(Names::FindName(GetNode()), seq, buf.partialSum, 
-                               buf.expectedCount, buf.receivedCount);
+void
+CFNAggregatorApp::PrepareReply(AggregationBuffer& buf, const ndn::Name& name, size_t contentSize) const {
+  bool mean = buf.reducer.CountsContributions();
+  buf.outData.Prepare(name, ndn::time::seconds(1), contentSize,
+                      {m_lateDelta ? CFN_TLV_OUTSTANDING : 0, mean ? ndn::AGG_TLV_CONTRIBUTIONS : 0});
+}
 
-  // Clean up
-  m_buffers.erase(it);
+std::shared_ptr<ndn::Data>
+CFNAggregatorApp::MakeAggregateData(AggregationBuffer& buf, const ndn::Name& name,
+                                    uint32_t outstanding) const {
+  if (buf.tensorMode) {
+    // Tensor length is only known once children have replied, so the wire is laid out here
+    PrepareReply(buf, name, buf.EncodedTensorSize());
+    buf.EncodeTensor(buf.outData.Content());
+  } else {
+    if (!buf.outData.IsPrepared()) {
+      // Deltas (and empty replies) reuse the layout of the parent's reply
+      PrepareReply(buf, name, sizeof(uint64_t));
+    }
+    // A mean goes up undivided: the root divides by the contributions of the whole tree
+    uint64_t netResult = htobe64(buf.partialSum);
+    std::memcpy(buf.outData.Content(), &netResult, sizeof(netResult));
+  }
+  if (m_lateDelta) {
+    buf.outData.SetAppMetaInfo(CFN_TLV_OUTSTANDING, outstanding);
+  }
+  if (buf.reducer.CountsContributions()) {
+    buf.outData.SetAppMetaInfo(ndn::AGG_TLV_CONTRIBUTIONS, buf.contributions);
+  }
+  // Wire is complete (dummy signature included): no setContent copy, encode or sign pass
+  return buf.outData.Finalize();
 }
 
 } // namespace ns3
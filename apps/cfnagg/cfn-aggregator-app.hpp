@@ -3,14 +3,25 @@
 
 #include "../ndn-app.hpp"
 #include "ns3/random-variable-stream.h"  // Add this include for UniformRandomVariable
-#include <map>
 #include <vector>
+#include <deque>
+#include <map>
 #include <string>
 #include "aggregation-buffer.hpp"
+#include "late-delta.hpp"
+#include "job-name.hpp"
+#include "coded-aggregation.hpp"
+#include "child-rtt-estimator.hpp"
+#include "congestion-control.hpp"
+#include "../agg-common/round-table.hpp"
+#include "../agg-common/agg-name.hpp"
 
 namespace ns3 {
 
-/** CFNAggregatorApp: Aggregation node application that collects data from children and aggregates it. */
+/** CFNAggregatorApp: Aggregation node application that collects data from children and aggregates it.
+ *  One instance serves every aggregation job whose tree passes through the node: each job has its own
+ *  children, rounds and per-child windows, and a deficit round robin scheduler shares the node's
+ *  round capacity (MaxNodeRounds) between the jobs. */
 class CFNAggregatorApp : public ndn::App {
   public:
     static TypeId GetTypeId();
@@ -26,10 +37,17 @@ class CFNAggregatorApp : public ndn::App {
     virtual void OnData(std::shared_ptr<const ndn::Data> data);
   
     // Callback for straggler timeout (when some children did not respond in time)
-    void OnStragglerTimeout(int seq);
+    void OnStragglerTimeout(uint32_t job, int seq);
+
+    // Late-delta mode: stop waiting for late contributions to an already reported round
+    void OnDeltaWindowClosed(uint32_t job, int seq);
   
-    // Configure the list of child node prefixes for this aggregator
+    // Configure the list of child node prefixes for this aggregator (job 0, unnamed)
     void SetChildren(const std::vector<std::string>& children);
+
+    // Configure the children of this node in a job's tree; 'weight' is the job's share of the
+    // node's rounds when jobs contend for them
+    void AddJob(uint32_t job, const std::vector<std::string>& children, double weight = 1.0);
   
   protected:
     // Add separate faces to decouple the producer and consumer roles.
@@ -37,11 +55,129 @@ class CFNAggregatorApp : public ndn::App {
     std::shared_ptr<ndn::Face> m_consFace; // For sending Interests to children
   
   private:
+    // Per-child admission state: rounds are pipelined to a child up to its window, the rest wait
+    struct ChildWindow {
+      std::unique_ptr<CongestionControl> cc; // congestion window (null if CongestionControl is "None")
+      uint32_t inFlight = 0;                 // rounds requested from the child and not yet answered
+      std::deque<uint64_t> pending;          // rounds waiting for a window slot, oldest first
+    };
+
+    // A parent Interest waiting for the node to have room for its round
+    struct WaitingRound {
+      std::shared_ptr<const ndn::Interest> interest;
+      uint64_t seq;
+      Time arrival;
+    };
+
+    // Everything one aggregation job owns on this node
+    struct Job {
+      uint32_t id = 0;
+      double weight = 1.0;                    // DRR share under contention
+      std::vector<std::string> children;      // List of child node names (prefixes)
+      std::vector<ndn::Name> childPrefixes;   // MakeJobPrefix(child, id) for each entry of children
+      ndn::ChildIndex childIndex;             // First component of a child's Data -> index in children
+      ChildRttEstimator rtt;                  // Per-child RTT estimates (adaptive mode)
+      std::vector<ChildWindow> childWindows;  // Admission state of each child
+      ndn::RoundTable<AggregationBuffer> buffers; // Active aggregation buffers indexed by sequence number
+      std::deque<WaitingRound> waiting;       // Rounds not admitted yet, oldest first
+      double deficit = 0;                     // DRR credit, in child contributions
+      std::vector<uint32_t> childGroup;       // Coded mode: coding group of each child (empty when off)
+    };
+
+    // Job of an incoming name, or nullptr if this node is not part of that job's tree
+    Job* FindJob(const ndn::Name& name);
+
+    // Admit a parent's round now if the node has room and no job is waiting, else queue it
+    void ScheduleRound(Job& job, std::shared_ptr<const ndn::Interest> interest, uint64_t seq);
+
+    // Deficit round robin over jobs with waiting rounds, while the node has room
+    void AdmitWaitingRounds();
+
+    // Whether another round fits in the node's shared capacity
+    bool NodeHasRoom() const;
+
+    // DRR cost of one of a job's rounds: the child contributions it aggregates
+    static double RoundCost(const Job& job);
+
+    // Claim a round's buffer and request it from the children; false if the round is already
+    // active or the job's round table is full. arrival is when the parent Interest came in
+    bool StartRound(Job& job, std::shared_ptr<const ndn::Interest> interest, uint64_t seq, Time arrival);
+
+    // Drop a finished round's buffer and give its capacity to the waiting rounds
+    void ReleaseRound(Job& job, uint64_t seq);
+
+    // Lay out the wire of a reply with contentSize bytes of content and the AppMetaInfo it carries
+    void PrepareReply(AggregationBuffer& buf, const ndn::Name& name, size_t contentSize) const;
+
+    // Write the round's result (scalar or tensor) into the preallocated parent Data and finalize it
+    // (with the outstanding child count in its MetaInfo when late-delta mode is on, and for a mean
+    // the unfinalized sum with its contribution count)
+    std::shared_ptr<ndn::Data> MakeAggregateData(AggregationBuffer& buf, const ndn::Name& name,
+                                                 uint32_t outstanding) const;
+
+    // Send the round's result to the parent; the round then closes or, with children still
+    // outstanding in late-delta mode, stays open to collect a delta
+    void SendAggregate(Job& job, uint64_t seq, AggregationBuffer& buf, bool partial);
+
+    // Late-delta mode: answer the parent's delta Interest for a round
+    void OnDeltaInterest(Job& job, std::shared_ptr<const ndn::Interest> interest, uint64_t seq);
+
+    // Straggler timeout for a new round (seconds): ChildTimeout, or the adaptive per-child estimate
+    double RoundTimeout(const Job& job) const;
+
+    // Lifetime of a child Interest (seconds): ChildTimeout, plus LateDeltaWindow in late-delta mode so
+    // that a reply arriving after the straggler deadline still finds its PIT entry
+    double ChildInterestLifetime() const;
+
+    // Adaptive mode: learn a child's RTT from its reply to a round
+    void SampleChildRtt(Job& job, const AggregationBuffer& buf, size_t child);
+
+    // Whether a child can take one more round (congestion window and MaxPipelinedRounds)
+    bool ChildWindowOpen(const ChildWindow& win) const;
+
+    // Send a round's Interest to one child, taking a slot of its window
+    void RequestFromChild(Job& job, uint64_t seq, AggregationBuffer& buf, size_t child);
+
+    // A child's round was answered (with the delivery's RTT, size and mark) or, with a null sample,
+    // given up on: free its slot and send queued rounds
+    void ReleaseChildWindow(Job& job, size_t child, const DeliverySample* delivered);
+
+    // Send a child's queued rounds while its window allows
+    void PumpChild(Job& job, size_t child);
+
+    // Late-delta mode: pull the next delta from a child whose aggregate was incomplete
+    void RequestDelta(Job& job, uint64_t seq, AggregationBuffer& buf, size_t child);
+
+    // Late-delta mode: answer a pending delta Interest once there is something to report
+    void TryReportDelta(Job& job, uint64_t seq, AggregationBuffer& buf);
+
+
     std::string m_prefix;                       // Prefix identifying this aggregator node
-    std::vector<std::string> m_children;        // List of child node names (prefixes)
+    std::map<uint32_t, Job> m_jobs;             // Jobs whose tree passes through this node
     double m_childTimeout;                      // Timeout (seconds) to wait for children data
-    std::map<int, AggregationBuffer> m_buffers; // Active aggregation buffers indexed by sequence number
+    std::string m_timeoutMode;                  // "fixed" or "adaptive" straggler timeout
+    bool m_adaptiveTimeout;                     // True if m_timeoutMode is "adaptive"
+    double m_timeoutQuantile;                   // RTT quantile an adaptive timeout covers
+    double m_minChildTimeout;                   // Lower bound (seconds) of an adaptive timeout
+    uint32_t m_traceNode;                       // This node's interned name in the trace
+    uint32_t m_maxRounds;                       // Capacity of each job's round table
+    uint32_t m_maxNodeRounds;                   // Rounds open at once across all jobs (0 = unlimited)
+    uint32_t m_activeRounds;                    // Rounds currently open across all jobs
+    std::deque<uint32_t> m_activeJobs;          // DRR list: jobs with waiting rounds
+    bool m_headCredited;                        // The DRR head job already got this turn's quantum
+    bool m_admitting;                           // AdmitWaitingRounds is running (reentrancy guard)
+    double m_quantum;                           // DRR quantum per unit weight (largest round cost)
+    std::string m_ccName;                       // Per-child congestion control ("None", "AIMD", "CUBIC", "BBR")
+    uint32_t m_maxPipelined;                    // Rounds in flight per child (0 = unlimited)
+    bool m_lateDelta;                           // Keep rounds open after a partial result to merge stragglers
+    double m_lateDeltaWindow;                   // How long (seconds) a partially reported round stays open
     Ptr<UniformRandomVariable> m_rand;          // RNG for Interest nonces
+    std::string m_tensorType;                   // Element type of child tensors ("" = scalar mode)
+    bool m_tensorMode;                          // True if m_tensorType names a valid element type
+    TensorDType m_dtype;                        // Parsed element type for tensor mode
+    uint32_t m_codingRedundancy;                // Coded mode: children a round may lose (0 = off)
+    std::string m_reductionName;                // How child values are combined ("sum", "max", ...)
+    ndn::ReduceOp m_reduction;                  // Parsed m_reductionName
   };
   
 
@@ -4,7 +4,10 @@
 #include "ndn-cxx/data.hpp"
 #include "ndn-cxx/interest.hpp"
 #include "helper/ndn-stack-helper.hpp"
+#include "ndn-cxx/encoding/tlv.hpp"
+#include "../agg-common/agg-name.hpp"
 #include <cstring>   // for std::memcpy
+#include <sstream>
 #include <arpa/inet.h> // for byte-order functions if needed
 
 // Helper for 64-bit host/network byte order conversion (if not provided by system)
@@ -37,13 +40,28 @@ CFNProducerApp::GetTypeId() {
                   MakeUintegerChecker<uint32_t>())
     .AddAttribute("Value", "64-bit integer value to include in Data content",
                   UintegerValue(1), MakeUintegerAccessor(&CFNProducerApp::m_value),
-                  MakeUintegerChecker<uint64_t>());
+                  MakeUintegerChecker<uint64_t>())
+    .AddAttribute("PartitionValues", "Coded aggregation: space-separated values of the peer producers "
+                  "whose partitions this producer also holds; every Data carries the sum of its own "
+                  "and the peers' contributions",
+                  StringValue(""), MakeStringAccessor(&CFNProducerApp::m_partitionValuesAttr),
+                  MakeStringChecker())
+    .AddAttribute("TensorType", "Element type of produced tensors (int32, int64, float32, bf16); "
+                  "empty to send a single 64-bit value",
+                  StringValue(""), MakeStringAccessor(&CFNProducerApp::m_tensorType),
+                  MakeStringChecker())
+    .AddAttribute("TensorElements", "Number of tensor elements per Data (tensor mode only)",
+                  UintegerValue(1024), MakeUintegerAccessor(&CFNProducerApp::m_tensorElements),
+                  MakeUintegerChecker<uint32_t>());
   return tid;
 }
 
 CFNProducerApp::CFNProducerApp()
   : m_payloadSize(8)
-  , m_value(1) {
+  , m_value(1)
+  , m_tensorElements(1024)
+  , m_tensorMode(false)
+  , m_dtype(TensorDType::INT64) {
 }
 
 void 
@@ -53,10 +71,36 @@ CFNProducerApp::StartApplication() {
     NS_LOG_WARN("CFNProducerApp has no prefix configured");
     return;
   }
+  m_values.assign(1, m_value);
+  std::istringstream peers(m_partitionValuesAttr);
+  uint64_t peerValue;
+  while (peers >> peerValue) {
+    m_values.push_back(peerValue);
+  }
+  if (!peers.eof()) {
+    NS_LOG_WARN("Malformed PartitionValues '" << m_partitionValuesAttr << "', using the values before the error");
+  }
+
+  m_tensorMode = false;
+  if (!m_tensorType.empty()) {
+    m_tensorMode = ParseTensorDType(m_tensorType, m_dtype);
+    if (!m_tensorMode) {
+      NS_LOG_WARN("Unknown TensorType '" << m_tensorType << "', sending scalar payloads");
+    } else {
+      // One Data must stay within the NDN packet size limit (leave room for name and signature)
+      size_t maxElements = (::ndn::MAX_NDN_PACKET_SIZE - 512) / TensorWireElementSize(m_dtype);
+      if (m_tensorElements > maxElements) {
+        NS_LOG_WARN("TensorElements=" << m_tensorElements << " exceeds one packet, clamping to "
+                    << maxElements << "; split larger tensors across rounds");
+        m_tensorElements = maxElements;
+      }
+    }
+  }
+
   // Register prefix with local NFD (so Interests for this prefix are routed to this app)
   ndn::FibHelper::AddRoute(GetNode(), m_prefix, m_face, 0);
   NS_LOG_INFO("CFNProducerApp started on node " << GetNode()->GetId() 
-              << " [prefix=" << m_prefix << "]");
+              << " [prefix=" << m_prefix << ", partitions=" << m_values.size() << "]");
 }
 
 void 
@@ -75,23 +119,62 @@ CFNProducerApp::OnInterest(std::shared_ptr<const ndn::Interest> interest) {
   auto data = std::make_shared<ndn::Data>(interest->getName());
   data->setFreshnessPeriod(ndn::time::seconds(1));  // e.g., 1 second freshness
 
-  // Prepare content buffer of length m_payloadSize
-  std::vector<uint8_t> content(m_payloadSize, 0);
-  // Embed m_value (64-bit) into the first 8 bytes of content (network byte order)
-  uint64_t netValue = htobe64(m_value);
-  size_t copySize = std::min((size_t)m_payloadSize, sizeof(netValue));
-  std::memcpy(content.data(), &netValue, copySize);
+  std::vector<uint8_t> content;
+  if (m_tensorMode) {
+    // Sequence number is the last name component
+    uint64_t seq = 0;
+    if (!interest->getName().empty()) {
+      ndn::ReadRoundNumber(interest->getName().get(-1), seq);
+    }
+    FillTensor(content, static_cast<int>(seq));
+  } else {
+    // Prepare content buffer of length m_payloadSize
+    content.assign(m_payloadSize, 0);
+    // Embed the sum of the held partitions (64-bit) into the first 8 bytes of content (network byte order)
+    uint64_t value = 0;
+    for (uint64_t v : m_values) {
+      value += v;
+    }
+    uint64_t netValue = htobe64(value);
+    size_t copySize = std::min((size_t)m_payloadSize, sizeof(netValue));
+    std::memcpy(content.data(), &netValue, copySize);
+  }
   data->setContent(content.data(), content.size());
 
   // Sign the Data packet with the default ndnSIM key (required by NDN)
   ndn::StackHelper::getKeyChain().sign(*data);
 
   NS_LOG_INFO("Producer sending Data for " << data->getName() 
-              << " [value=" << m_value << ", size=" << m_payloadSize << " bytes]");
+              << " [value=" << m_value << ", size=" << content.size() << " bytes]");
 
   // Send Data packet out
   m_transmittedDatas(data, this, m_face);
   m_appLink->onReceiveData(*data);
 }
 
+void
+CFNProducerApp::FillTensor(std::vector<uint8_t>& content, int seq) const {
+  // Element i of round seq is (value + seq + i % 97) per partition, so sums are easy to check at the root
+  std::vector<uint64_t> acc((m_tensorElements * TensorAccumElementSize(m_dtype) + 7) / 8, 0);
+  for (uint32_t i = 0; i < m_tensorElements; ++i) {
+    for (uint64_t value : m_values) {
+      int64_t v = static_cast<int64_t>(value) + seq + (i % 97);
+      switch (m_dtype) {
+        case TensorDType::INT32:
+          reinterpret_cast<int32_t*>(acc.data())[i] += static_cast<int32_t>(v);
+          break;
+        case TensorDType::INT64:
+          reinterpret_cast<int64_t*>(acc.data())[i] += v;
+          break;
+        case TensorDType::FLOAT32:
+        case TensorDType::BF16:
+          reinterpret_cast<float*>(acc.data())[i] += static_cast<float>(v) * 0.25f;
+          break;
+      }
+    }
+  }
+  content.resize(m_tensorElements * TensorWireElementSize(m_dtype));
+  TensorEncode(m_dtype, acc.data(), content.data(), m_tensorElements);
+}
+
 } // namespace ns3
@@ -3,6 +3,9 @@
 
 #include "../ndn-app.hpp"
 #include "ns3/core-module.h"
+#include "tensor-reduce.hpp"
+#include <string>
+#include <vector>
 
 namespace ns3 {
 
@@ -17,9 +20,19 @@ public:
   virtual void OnInterest(std::shared_ptr<const ndn::Interest> interest);
 
 private:
+  // Fill content with a deterministic tensor for round 'seq': the element-wise sum of the tensors
+  // of every held partition (each depends only on its value and seq)
+  void FillTensor(std::vector<uint8_t>& content, int seq) const;
+
   std::string m_prefix;      // Namespace prefix this producer serves
   uint32_t m_payloadSize;    // Size of the data payload in bytes
   uint64_t m_value;          // Value to include in the data content (e.g., sensor reading)
+  std::string m_partitionValuesAttr; // Coded aggregation: values of the peer partitions also held
+  std::vector<uint64_t> m_values;    // m_value followed by the parsed peer partition values
+  std::string m_tensorType;  // Element type of produced tensors ("" = single 64-bit value)
+  uint32_t m_tensorElements; // Number of tensor elements per Data
+  bool m_tensorMode;         // True if m_tensorType names a valid element type
+  TensorDType m_dtype;       // Parsed element type for tensor mode
 };
 
 } // namespace ns3
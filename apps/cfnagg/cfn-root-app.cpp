@@ -46,18 +46,63 @@ CFNRootApp::GetTypeId() {
     .AddAttribute("Prefix", "Identity prefix of the root (optional, for logging)",
                   StringValue("/"), MakeStringAccessor(&CFNRootApp::m_prefix),
                   MakeStringChecker())
+    .AddAttribute("JobId", "Aggregation job driven by this root; jobs other than 0 carry their id "
+                  "in every Interest name so aggregators can serve several jobs at once",
+                  UintegerValue(0), MakeUintegerAccessor(&CFNRootApp::m_jobId),
+                  MakeUintegerChecker<uint32_t>())
     .AddAttribute("ChildTimeout", "Timeout waiting for all children data (seconds)",
                   DoubleValue(1.0), MakeDoubleAccessor(&CFNRootApp::m_childTimeout),
                   MakeDoubleChecker<double>())
+    .AddAttribute("TimeoutMode", "Straggler timeout: 'fixed' (ChildTimeout) or 'adaptive' "
+                  "(per-child RTT estimate, capped by ChildTimeout)",
+                  StringValue("fixed"), MakeStringAccessor(&CFNRootApp::m_timeoutMode),
+                  MakeStringChecker())
+    .AddAttribute("TimeoutQuantile", "Adaptive mode: quantile of the slowest child's RTT to wait for",
+                  DoubleValue(0.99), MakeDoubleAccessor(&CFNRootApp::m_timeoutQuantile),
+                  MakeDoubleChecker<double>(0.5, 1.0))
+    .AddAttribute("MinChildTimeout", "Adaptive mode: lower bound of the straggler timeout (seconds)",
+                  DoubleValue(0.0001), MakeDoubleAccessor(&CFNRootApp::m_minChildTimeout),
+                  MakeDoubleChecker<double>(0.0))
     .AddAttribute("CongestionControl", "Congestion control algorithm (AIMD, CUBIC, BBR)",
                   StringValue("AIMD"), MakeStringAccessor(&CFNRootApp::m_ccName),
+                  MakeStringChecker())
+    .AddAttribute("TensorType", "Element type of child tensor payloads (int32, int64, float32, bf16); "
+                  "empty to aggregate a single 64-bit value",
+                  StringValue(""), MakeStringAccessor(&CFNRootApp::m_tensorType),
+                  MakeStringChecker())
+    .AddAttribute("MaxRounds", "Maximum number of rounds in flight, whatever the congestion window "
+                  "(rounded up to a power of two)",
+                  UintegerValue(256), MakeUintegerAccessor(&CFNRootApp::m_maxRounds),
+                  MakeUintegerChecker<uint32_t>(1))
+    .AddAttribute("LateDelta", "After a partial result, keep merging late child contributions "
+                  "and log corrected aggregates",
+                  BooleanValue(false), MakeBooleanAccessor(&CFNRootApp::m_lateDelta),
+                  MakeBooleanChecker())
+    .AddAttribute("LateDeltaWindow", "How long a partially reported round accepts late contributions (seconds)",
+                  DoubleValue(1.0), MakeDoubleAccessor(&CFNRootApp::m_lateDeltaWindow),
+                  MakeDoubleChecker<double>(0.0))
+    .AddAttribute("Reduction", "How child values are combined: sum, max, min, mean (over the leaf "
+                  "values received), topk (max for a single value) or or; tensors are always summed",
+                  StringValue("sum"), MakeStringAccessor(&CFNRootApp::m_reductionName),
                   MakeStringChecker());
   return tid;
 }
 
 CFNRootApp::CFNRootApp()
-  : m_childTimeout(1.0)
-  , m_nextSeq(0) {
+  : m_jobId(0)
+  , m_childTimeout(1.0)
+  , m_adaptiveTimeout(false)
+  , m_timeoutQuantile(0.99)
+  , m_minChildTimeout(0.0001)
+  , m_traceNode(0)
+  , m_maxRounds(256)
+  , m_lateDelta(false)
+  , m_lateDeltaWindow(1.0)
+  , m_lateRounds(0)
+  , m_nextSeq(0)
+  , m_tensorMode(false)
+  , m_dtype(TensorDType::INT64)
+  , m_reduction(ndn::ReduceOp::SUM) {
 }
 
 void 
@@ -82,16 +127,48 @@ CFNRootApp::StartApplication() {
   }
 
   // Instantiate the chosen congestion control algorithm
-  if (m_ccName == "CUBIC" || m_ccName == "cubic") {
-    m_congestionCtrl = std::make_unique<CongestionCubic>();
-  } else if (m_ccName == "BBR" || m_ccName == "bbr") {
-    m_congestionCtrl = std::make_unique<CongestionBBR>();
-  } else {
-    // Default to AIMD if unspecified or unknown
-    m_congestionCtrl = std::make_unique<CongestionAIMD>();
-  }
+  m_congestionCtrl = MakeCongestionControl(m_ccName);
   NS_LOG_INFO("CFNRootApp started on node " << Names::FindName(GetNode()) 
-              << " [CongestionControl=" << m_ccName << "]");
+              << " [job=" << m_jobId << ", CongestionControl=" << m_ccName << "]");
+
+  m_tensorMode = false;
+  if (!m_tensorType.empty()) {
+    m_tensorMode = ParseTensorDType(m_tensorType, m_dtype);
+    if (!m_tensorMode) {
+      NS_LOG_WARN("Unknown TensorType '" << m_tensorType << "', falling back to scalar aggregation");
+    }
+  }
+
+  m_reduction = ndn::ReduceOp::SUM;
+  if (!ndn::ParseReduceOp(m_reductionName, m_reduction)) {
+    NS_LOG_WARN("Unknown Reduction '" << m_reductionName << "', summing child values");
+  } else if (m_reduction != ndn::ReduceOp::SUM && m_tensorMode) {
+    NS_LOG_WARN("Reduction '" << m_reductionName << "' does not apply to tensors, summing them");
+    m_reduction = ndn::ReduceOp::SUM;
+  }
+
+  // Child Interest prefixes are built once; incoming Data is matched on its first component
+  m_childPrefixes.clear();
+  for (const std::string& child : m_children) {
+    m_childPrefixes.push_back(MakeJobPrefix(child, m_jobId));
+  }
+  m_childIndex.Assign(m_childPrefixes);
+  m_traceNode = TraceCollector::Intern(Names::FindName(GetNode()));
+
+  m_adaptiveTimeout = (m_timeoutMode == "adaptive");
+  if (!m_adaptiveTimeout && m_timeoutMode != "fixed") {
+    NS_LOG_WARN("Unknown TimeoutMode '" << m_timeoutMode << "', using the fixed ChildTimeout");
+  }
+  m_rtt.Reset(m_children.size(), m_timeoutQuantile);
+
+  // Every slot starts from this prototype: child bitmap sized, tensor mode decided
+  AggregationBuffer prototype(m_children.size());
+  prototype.SetReduction(m_reduction);
+  if (m_tensorMode) {
+    prototype.EnableTensor(m_dtype);
+  }
+  m_buffers.Reset(m_maxRounds, prototype);
+  m_lateRounds = 0;
 
   m_nextSeq = 0;
   // Send initial interests up to the initial congestion window size
@@ -106,12 +183,13 @@ CFNRootApp::StartApplication() {
 void 
 CFNRootApp::StopApplication() {
   // Cancel any outstanding events (e.g., straggler timeouts)
-  for (auto& entry : m_buffers) {
-    if (entry.second.timeoutEvent.IsRunning()) {
-      StragglerManager::Cancel(entry.second.timeoutEvent);
+  m_buffers.ForEach([] (uint64_t, AggregationBuffer& buf) {
+    if (buf.timeoutEvent.IsRunning()) {
+      StragglerManager::Cancel(buf.timeoutEvent);
     }
-  }
-  m_buffers.clear();
+  });
+  m_buffers.Clear();
+  m_lateRounds = 0;
   ndn::App::StopApplication();
 }
 
@@ -121,21 +199,22 @@ CFNRootApp::SendInterest(int seq) {
     NS_LOG_ERROR("CFNRootApp: no children to send interests to");
     return;
   }
-  // Create a new aggregation buffer for this sequence
-  AggregationBuffer buf(m_children.size());
-  buf.parentInterestName = ndn::Name(m_prefix.empty() ? "/" : m_prefix).append(std::to_string(seq));
-  buf.partialSum = 0;
-  buf.receivedCount = 0;
-  m_buffers[seq] = buf;
+  // Claim the round's slot (a fresh copy of the prototype buffer)
+  AggregationBuffer* buf = m_buffers.Insert(seq);
+  if (buf == nullptr) {
+    NS_LOG_WARN("CFNRootApp: cannot start seq " << seq << ", round table full ("
+                << m_buffers.Size() << "/" << m_buffers.Capacity() << " rounds)");
+    return;
+  }
 
   // Send an Interest to each direct child
   Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable>();
-  for (const std::string& childName : m_children) {
-      // Construct the Interest name as "/<childName>/<seq>" 
-      std::string interestName = "/" + childName + "/" + std::to_string(seq);
-      auto interest = std::make_shared<ndn::Interest>(interestName);
+  for (size_t i = 0; i < m_children.size(); ++i) {
+      const std::string& childName = m_children[i];
+      // Construct the Interest name as "/<childName>[/<job>]/seq=<seq>"
+      auto interest = std::make_shared<ndn::Interest>(ndn::Name(m_childPrefixes[i]).appendSequenceNumber(seq));
       interest->setNonce(rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
-      interest->setInterestLifetime(ndn::time::milliseconds(static_cast<int>(m_childTimeout * 1000)));
+      interest->setInterestLifetime(ndn::time::milliseconds(static_cast<int>(ChildInterestLifetime() * 1000)));
 
       NS_LOG_INFO("Root sending Interest " << interest->getName() 
             << " to child [" << childName << "]"
@@ -151,10 +230,11 @@ CFNRootApp::SendInterest(int seq) {
   }
 
   // Schedule a timeout for this sequence aggregation
-  m_buffers[seq].timeoutEvent = StragglerManager::ScheduleRoot(this, seq, m_childTimeout);
+  buf->startTime = Simulator::Now();
+  buf->timeoutEvent = StragglerManager::ScheduleRoot(this, seq, RoundTimeout());
 
   // Log the interest dispatch event (time, node, seq)
-  TraceCollector::LogInterest(Names::FindName(GetNode()), seq, Simulator::Now().GetSeconds());
+  TraceCollector::LogInterest(m_traceNode, seq, m_jobId);
 }
 
 void 
@@ -162,53 +242,65 @@ CFNRootApp::OnData(std::shared_ptr<const ndn::Data> data) {
   // Called when a Data packet from a child is received
   NS_LOG_INFO("Root received Data: " << data->getName());
   // Determine sequence number from Data name
-  ndn::Name dataName = data->getName();
-  int seq = -1;
-  if (dataName.size() > 0) {
-    std::string seqStr = dataName.get(-1).toUri();
-    try {
-      seq = std::stoi(seqStr);
-    } catch (...) {
-      seq = -1;
-    }
-  }
-  if (seq < 0) {
+  const ndn::Name& dataName = data->getName();
+  uint64_t seq = 0;
+  bool isDelta = ParseDeltaName(dataName, seq);
+  if (!isDelta && (dataName.empty() || !ndn::ReadRoundNumber(dataName.get(-1), seq))) {
     NS_LOG_WARN("Root could not parse sequence from Data name");
     return;
   }
-  auto it = m_buffers.find(seq);
-  if (it == m_buffers.end()) {
+  AggregationBuffer* found = m_buffers.Find(seq);
+  if (found == nullptr) {
     // Could be a late packet after finalization
     NS_LOG_WARN("Root received Data for unknown/finished seq " << seq);
     return;
   }
-  AggregationBuffer& buf = it->second;
-
-  // Mark which child responded
-  if (dataName.size() > 0) {
-    std::string childPrefix = dataName.get(0).toUri();
-    for (size_t j = 0; j < m_children.size(); ++j) {
-      if (m_children[j] == childPrefix) {
-        buf.childrenReceived[j] = true;
-        break;
-      }
+  AggregationBuffer& buf = *found;
+
+  // Mark which child responded; unknown children and repeated replies are not counted
+  size_t child = m_childIndex.Find(dataName.get(0));
+  if (child == ndn::ChildIndex::NOT_FOUND) {
+    NS_LOG_WARN("Root received Data " << dataName << " from an unknown child (ignored)");
+    return;
+  }
+  if (isDelta) {
+    if (!buf.partialSent || !buf.pendingDeltas.Test(child)) {
+      NS_LOG_WARN("Root received unrequested delta " << dataName << " (ignored)");
+      return;
     }
+  } else if (!buf.childrenReceived.Set(child)) {
+    NS_LOG_INFO("Root ignoring duplicate Data from child [" << m_children[child] << "] for seq " << seq);
+    return;
+  }
+  buf.receivedCount = buf.childrenReceived.Count();
+  if (!isDelta) {
+    SampleChildRtt(buf, child);
+    buf.RecordDelivery(*data);
   }
-  buf.receivedCount++;
-
-  // Accumulate the child's value into partialSum
-  if (data->getContent().value_size() >= 8) {
-    uint64_t netVal;
-    std::memcpy(&netVal, data->getContent().value(), 8);
-    uint64_t val = be64toh(netVal);
-    buf.partialSum += val;
-  } else if (data->getContent().value_size() > 0) {
-    uint64_t val = 0;
-    const uint8_t* contentData = data->getContent().value();
-    for (size_t i = 0; i < data->getContent().value_size(); ++i) {
-      val = (val << 8) | contentData[i];
+
+  // Fold the child's value into partialSum (or its tensor into the accumulator), with the leaf
+  // values it covers: a mean is divided by them only here
+  buf.Accumulate(data->getContent(), ndn::ReadContributions(*data));
+  if (m_lateDelta) {
+    // A child still waiting on part of its subtree will have a delta to pull
+    if (ReadOutstanding(*data) > 0) {
+      buf.pendingDeltas.Set(child);
+    } else {
+      buf.pendingDeltas.Reset(child);
     }
-    buf.partialSum += val;
+  }
+
+  if (buf.partialSent) {
+    // Late contribution to a reported round: the accumulator now holds the corrected result
+    TraceCollector::LogCorrection(m_traceNode, seq, buf.Result(),
+                                  buf.expectedCount, buf.receivedCount, m_jobId);
+    if (buf.pendingDeltas.Test(child)) {
+      RequestDelta(seq, buf, child);
+    }
+    if (buf.Outstanding() == 0) {
+      CloseLateRound(seq);
+    }
+    return;
   }
 
   // If all children have responded for this sequence, finalize the aggregation
@@ -216,19 +308,7 @@ CFNRootApp::OnData(std::shared_ptr<const ndn::Data> data) {
     if (buf.timeoutEvent.IsRunning()) {
       StragglerManager::Cancel(buf.timeoutEvent);
     }
-    // Treat this as a successfully completed round for congestion control
-    if (buf.receivedCount > 0) {
-      m_congestionCtrl->OnData();
-    } else {
-      m_congestionCtrl->OnTimeout();
-    }
-    // Log the final aggregated result
-    TraceCollector::LogAggregate(Names::FindName(GetNode()), seq, buf.partialSum, 
-                                 buf.expectedCount, buf.receivedCount);
-    // Remove buffer
-    m_buffers.erase(it);
-    // Try to send new Interests if window allows
-    TrySendNext();
+    FinishRound(seq, buf);
   }
   // Else: waiting for more children of this sequence (partial data arrived, but not done)
 }
@@ -236,36 +316,120 @@ CFNRootApp::OnData(std::shared_ptr<const ndn::Data> data) {
 void 
 CFNRootApp::OnStragglerTimeout(int seq) {
   // Timeout: not all children responded in time for this sequence
-  auto it = m_buffers.find(seq);
-  if (it == m_buffers.end()) {
+  AggregationBuffer* found = m_buffers.Find(seq);
+  if (found == nullptr || found->partialSent) {
     return;
   }
-  AggregationBuffer& buf = it->second;
+  AggregationBuffer& buf = *found;
   NS_LOG_INFO("Root straggler timeout for seq " << seq 
               << " (received " << buf.receivedCount << "/" << buf.expectedCount << ")");
-  // Congestion control reaction: consider this round done (partial or failed)
+  if (m_adaptiveTimeout) {
+    // Children still missing took at least this long: let their estimates grow
+    m_rtt.AddTimeouts(buf.childrenReceived, (Simulator::Now() - buf.startTime).GetSeconds(), m_buffers.Size());
+  }
+  FinishRound(seq, buf);
+}
+
+void
+CFNRootApp::FinishRound(uint64_t seq, AggregationBuffer& buf) {
+  // Congestion control reaction: a round with any reply counts as delivered (partial or not),
+  // but only a complete round measures the round-trip time
   if (buf.receivedCount > 0) {
-    m_congestionCtrl->OnData();
+    DeliverySample sample;
+    if (buf.receivedCount >= buf.expectedCount) {
+      sample.rtt = (Simulator::Now() - buf.startTime).GetSeconds();
+    }
+    sample.bytes = buf.receivedBytes;
+    sample.congestionMarked = buf.congestionMarked;
+    m_congestionCtrl->OnData(sample);
   } else {
     m_congestionCtrl->OnTimeout();
   }
-  // Log the partial aggregate outcome
-  TraceCollector::LogAggregate(Names::FindName(GetNode()), seq, buf.partialSum, 
-                               buf.expectedCount, buf.receivedCount);
-  // Remove the buffer
-  m_buffers.erase(it);
-  // Send next interest(s) if window allows
+  // Log the aggregated result (complete or partial)
+  TraceCollector::LogAggregate(m_traceNode, seq, buf.Result(), 
+                               buf.expectedCount, buf.receivedCount, m_jobId);
+
+  if (!m_lateDelta || buf.Outstanding() == 0) {
+    // Remove buffer
+    m_buffers.Erase(seq);
+  } else {
+    // Keep the slot to merge late contributions; it no longer counts against the window
+    buf.partialSent = true;
+    ++m_lateRounds;
+    buf.timeoutEvent = StragglerManager::ScheduleRootDeltaWindow(this, seq, m_lateDeltaWindow);
+    for (size_t i = 0; i < buf.pendingDeltas.Size(); ++i) {
+      if (buf.pendingDeltas.Test(i)) {
+        RequestDelta(seq, buf, i);
+      }
+    }
+  }
+  // Try to send new Interests if window allows
+  TrySendNext();
+}
+
+double
+CFNRootApp::RoundTimeout() const {
+  return m_adaptiveTimeout ? m_rtt.Deadline(m_minChildTimeout, m_childTimeout) : m_childTimeout;
+}
+
+double
+CFNRootApp::ChildInterestLifetime() const {
+  return m_lateDelta ? m_childTimeout + m_lateDeltaWindow : m_childTimeout;
+}
+
+void
+CFNRootApp::SampleChildRtt(const AggregationBuffer& buf, size_t child) {
+  if (m_adaptiveTimeout) {
+    m_rtt.AddSample(child, (Simulator::Now() - buf.startTime).GetSeconds(), m_buffers.Size());
+  }
+}
+
+void
+CFNRootApp::RequestDelta(uint64_t seq, AggregationBuffer& buf, size_t child) {
+  uint32_t k = ++buf.childDeltaCount[child];
+  auto interest = std::make_shared<ndn::Interest>(MakeDeltaName(m_childPrefixes[child], seq, k));
+  Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable>();
+  interest->setNonce(rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
+  interest->setInterestLifetime(ndn::time::milliseconds(static_cast<int>(m_lateDeltaWindow * 1000)));
+
+  NS_LOG_INFO("Root requesting delta " << interest->getName() << " from child [" << m_children[child] << "]");
+  m_transmittedInterests(interest, this, m_face);
+  m_appLink->onReceiveInterest(*interest);
+}
+
+void
+CFNRootApp::OnDeltaWindowClosed(int seq) {
+  AggregationBuffer* found = m_buffers.Find(seq);
+  if (found == nullptr || !found->partialSent) {
+    return;
+  }
+  NS_LOG_INFO("Root closing seq " << seq << " (received " << found->receivedCount
+              << "/" << found->expectedCount << ", final value=" << found->Result() << ")");
+  CloseLateRound(seq);
+}
+
+void
+CFNRootApp::CloseLateRound(uint64_t seq) {
+  AggregationBuffer* found = m_buffers.Find(seq);
+  if (found == nullptr) {
+    return;
+  }
+  StragglerManager::Cancel(found->timeoutEvent);
+  m_buffers.Erase(seq);
+  --m_lateRounds;
+  // The freed slot may be the one the next round was waiting for
   TrySendNext();
 }
 
 void 
 CFNRootApp::TrySendNext() {
   // Check current number of in-flight aggregation rounds vs congestion window
-  int inFlight = m_buffers.size();
+  int inFlight = m_buffers.Size() - m_lateRounds;
   int cwnd = m_congestionCtrl->GetCwnd();
   if (inFlight < cwnd) {
-    // Launch new aggregation rounds until the window is full
-    while (inFlight < cwnd) {
+    // Launch new aggregation rounds until the window is full, or until the next round's
+    // slot is still held by an unfinished round (the table bounds what the window can open)
+    while (inFlight < cwnd && m_buffers.CanInsert(m_nextSeq + 1)) {
       m_nextSeq++;
       SendInterest(m_nextSeq);
       inFlight++;
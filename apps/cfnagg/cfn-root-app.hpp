@@ -2,15 +2,20 @@
 #define CFN_ROOT_APP_HPP
 
 #include "../ndn-app.hpp"
-#include <map>
 #include <vector>
 #include <string>
 #include "aggregation-buffer.hpp"
+#include "late-delta.hpp"
+#include "job-name.hpp"
+#include "child-rtt-estimator.hpp"
+#include "../agg-common/round-table.hpp"
+#include "../agg-common/agg-name.hpp"
 #include "congestion-control.hpp"
 
 namespace ns3 {
 
-/** CFNRootApp: Root aggregator that initiates Interests and uses congestion control. */
+/** CFNRootApp: Root aggregator that initiates Interests and uses congestion control.
+ *  Each root drives one aggregation job (JobId); concurrent jobs run one root each. */
 class CFNRootApp : public ndn::App {
 public:
   static TypeId GetTypeId();
@@ -25,6 +30,9 @@ public:
   // Callback for straggler timeout for a given sequence
   void OnStragglerTimeout(int seq);
 
+  // Late-delta mode: stop correcting a partially reported round
+  void OnDeltaWindowClosed(int seq);
+
   // Set the list of child node prefixes (direct children of the root in the tree)
   void SetChildren(const std::vector<std::string>& children);
 
@@ -36,14 +44,45 @@ private:
   void SendInterest(int seq);
   // Check congestion window and send further Interests if window allows
   void TrySendNext();
+  // Report a round (complete or partial) and release it, or keep it open for late deltas
+  void FinishRound(uint64_t seq, AggregationBuffer& buf);
+  // Straggler timeout for a new round (seconds): ChildTimeout, or the adaptive per-child estimate
+  double RoundTimeout() const;
+  // Lifetime of a child Interest (seconds): ChildTimeout, plus LateDeltaWindow in late-delta mode so
+  // that a reply arriving after the straggler deadline still finds its PIT entry
+  double ChildInterestLifetime() const;
+  // Adaptive mode: learn a child's RTT from its reply to a round
+  void SampleChildRtt(const AggregationBuffer& buf, size_t child);
+  // Late-delta mode: pull the next delta from a child whose aggregate was incomplete
+  void RequestDelta(uint64_t seq, AggregationBuffer& buf, size_t child);
+  // Late-delta mode: release a round that no longer accepts corrections
+  void CloseLateRound(uint64_t seq);
 
   std::string m_prefix;                        // Prefix (identity) of root node (optional)
+  uint32_t m_jobId;                            // Job this root drives (named in its Interests unless 0)
   std::vector<std::string> m_children;         // List of child node names (prefixes)
+  std::vector<ndn::Name> m_childPrefixes;      // MakeJobPrefix(child, m_jobId) for each entry of m_children
+  ndn::ChildIndex m_childIndex;                // First component of a child's Data -> index in m_children
   double m_childTimeout;                       // Timeout for children data
-  std::map<int, AggregationBuffer> m_buffers;  // Buffers for active sequences
+  std::string m_timeoutMode;                   // "fixed" or "adaptive" straggler timeout
+  bool m_adaptiveTimeout;                      // True if m_timeoutMode is "adaptive"
+  double m_timeoutQuantile;                    // RTT quantile an adaptive timeout covers
+  double m_minChildTimeout;                    // Lower bound (seconds) of an adaptive timeout
+  ChildRttEstimator m_rtt;                     // Per-child RTT estimates (adaptive mode)
+  uint32_t m_traceNode;                        // This node's interned name in the trace
+  uint32_t m_maxRounds;                        // Capacity of the round table
+  bool m_lateDelta;                            // Keep rounds open after a partial result to merge stragglers
+  double m_lateDeltaWindow;                    // How long (seconds) a partially reported round stays open
+  int m_lateRounds;                            // Reported rounds still open for corrections (not in flight)
+  ndn::RoundTable<AggregationBuffer> m_buffers; // Buffers for active sequences
   std::string m_ccName;                        // Name of congestion control algorithm
   std::unique_ptr<CongestionControl> m_congestionCtrl; // Active congestion control instance
   int m_nextSeq;                               // Sequence number to use for next new interest
+  std::string m_tensorType;                    // Element type of child tensors ("" = scalar mode)
+  bool m_tensorMode;                           // True if m_tensorType names a valid element type
+  TensorDType m_dtype;                         // Parsed element type for tensor mode
+  std::string m_reductionName;                 // How child values are combined ("sum", "max", ...)
+  ndn::ReduceOp m_reduction;                   // Parsed m_reductionName
 };
 
 } // namespace ns3
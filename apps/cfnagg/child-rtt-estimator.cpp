@@ -0,0 +1,81 @@
+#include "child-rtt-estimator.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace ns3 {
+
+// For normally distributed samples the mean deviation tracked by RFC 6298 estimators
+// (RTTVAR) is sqrt(2/pi) ~ 0.8 of the standard deviation
+static const double STDDEV_PER_MEANDEV = 1.2533;
+
+ChildRttEstimator::ChildRttEstimator()
+  : m_z(NormalQuantile(0.99)) {
+}
+
+void ChildRttEstimator::Reset(size_t count, double quantile) {
+  m_estimators.assign(count, ::ndn::util::RttEstimator());
+  m_z = NormalQuantile(std::min(std::max(quantile, 0.5), 0.999999));
+}
+
+void ChildRttEstimator::AddSample(size_t child, double rtt, size_t inFlight) {
+  ::ndn::time::nanoseconds sample(std::llround(rtt * 1e9));
+  m_estimators[child].addMeasurement(sample, std::max<size_t>(inFlight, 1));
+}
+
+void ChildRttEstimator::AddTimeouts(const ndn::ChildBitmap& received, double elapsed, size_t inFlight) {
+  for (size_t i = 0; i < m_estimators.size(); ++i) {
+    if (!received.Test(i)) {
+      AddSample(i, elapsed, inFlight);
+    }
+  }
+}
+
+bool ChildRttEstimator::HasSamples(size_t child) const {
+  return m_estimators[child].hasSamples();
+}
+
+double ChildRttEstimator::ChildDeadline(size_t child, double fallback) const {
+  const ::ndn::util::RttEstimator& est = m_estimators[child];
+  if (!est.hasSamples()) {
+    return fallback;
+  }
+  double srtt = est.getSmoothedRtt().count() * 1e-9;
+  double rttVar = est.getRttVariation().count() * 1e-9;
+  return srtt + m_z * STDDEV_PER_MEANDEV * rttVar;
+}
+
+double ChildRttEstimator::Deadline(double minDeadline, double maxDeadline) const {
+  double deadline = minDeadline;
+  for (size_t i = 0; i < m_estimators.size(); ++i) {
+    deadline = std::max(deadline, ChildDeadline(i, maxDeadline));
+  }
+  return std::min(deadline, maxDeadline);
+}
+
+double NormalQuantile(double p) {
+  // Acklam's rational approximation (relative error below 1.2e-9)
+  static const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                             1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+  static const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                             6.680131188771972e+01, -1.328068155288572e+01};
+  static const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                             -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+  static const double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                             3.754408661907416e+00};
+  const double pLow = 0.02425;
+
+  if (p < pLow) {
+    double q = std::sqrt(-2 * std::log(p));
+    return (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+           ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1);
+  }
+  if (p > 1 - pLow) {
+    return -NormalQuantile(1 - p);
+  }
+  double q = p - 0.5;
+  double r = q * q;
+  return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+         (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1);
+}
+
+} // namespace ns3
@@ -0,0 +1,45 @@
+#ifndef CHILD_RTT_ESTIMATOR_HPP
+#define CHILD_RTT_ESTIMATOR_HPP
+
+#include <cstddef>
+#include <vector>
+#include "ndn-cxx/util/rtt-estimator.hpp"
+#include "../agg-common/child-bitmap.hpp"
+
+namespace ns3 {
+
+/** ChildRttEstimator: per-child RTT estimation and the adaptive straggler deadline derived from it. */
+class ChildRttEstimator {
+public:
+  ChildRttEstimator();
+
+  // Track 'count' children (dropping earlier samples); deadlines cover 'quantile' (0..1) of each child's RTT
+  void Reset(size_t count, double quantile);
+
+  // Record a round-trip time (seconds) for a child; 'inFlight' rounds sampled concurrently share the gain
+  void AddSample(size_t child, double rtt, size_t inFlight = 1);
+
+  // A round expired after 'elapsed' seconds: children missing from 'received' took at least that long.
+  // Feeding these lower bounds lets the deadline grow past a child that keeps missing it.
+  void AddTimeouts(const ndn::ChildBitmap& received, double elapsed, size_t inFlight = 1);
+
+  bool HasSamples(size_t child) const;
+
+  // Estimated quantile of a child's RTT (seconds), or 'fallback' before its first sample
+  double ChildDeadline(size_t child, double fallback) const;
+
+  // Round deadline: the slowest child's estimate, clamped to [minDeadline, maxDeadline]
+  // (children without samples count as maxDeadline)
+  double Deadline(double minDeadline, double maxDeadline) const;
+
+private:
+  std::vector<::ndn::util::RttEstimator> m_estimators; // one mean/deviation estimator per child
+  double m_z;                                         // standard normal quantile of the configured level
+};
+
+// Inverse of the standard normal CDF, for 0 < p < 1
+double NormalQuantile(double p);
+
+} // namespace ns3
+
+#endif // CHILD_RTT_ESTIMATOR_HPP
@@ -0,0 +1,40 @@
+#ifndef CODED_AGGREGATION_HPP
+#define CODED_AGGREGATION_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+namespace ns3 {
+
+// Coded aggregation (fractional repetition gradient coding): the n producer children of an
+// aggregator are split into groups of s + 1 consecutive children, the remainder joining the last
+// group. Every member of a group holds the partitions of all its peers and answers with their sum,
+// so one share per group carries the group's exact contribution and any s missing children leave
+// every group covered. The aggregator adds one share per group and completes the round as soon as
+// each group has answered, i.e. after at most n - s children. All coefficients are 0/1, so the
+// decoded sum is exact for integer payloads (floating-point shares only differ by rounding).
+
+// Number of groups n children form with redundancy s (0 if coding cannot apply: s == 0 or s >= n)
+inline uint32_t CodingGroupCount(uint32_t children, uint32_t redundancy) {
+  if (redundancy == 0 || redundancy >= children) {
+    return 0;
+  }
+  return children / (redundancy + 1);
+}
+
+// Group of child index 'child' (CodingGroupCount must be non-zero)
+inline uint32_t CodingGroupOf(uint32_t child, uint32_t children, uint32_t redundancy) {
+  return std::min(child / (redundancy + 1), CodingGroupCount(children, redundancy) - 1);
+}
+
+// Child indexes [first, last) of a group
+inline std::pair<uint32_t, uint32_t> CodingGroupMembers(uint32_t group, uint32_t children, uint32_t redundancy) {
+  uint32_t first = group * (redundancy + 1);
+  uint32_t last = group + 1 == CodingGroupCount(children, redundancy) ? children : first + redundancy + 1;
+  return {first, last};
+}
+
+} // namespace ns3
+
+#endif // CODED_AGGREGATION_HPP
@@ -4,10 +4,24 @@
 CongestionAIMD::CongestionAIMD()
   : m_cwnd(1)
   , m_ssthresh(10000)
-  , m_ackCount(0) {
+  , m_ackCount(0)
+  , m_markHoldAcks(0) {
 }
 
-void CongestionAIMD::OnData() {
+void CongestionAIMD::OnData(const DeliverySample& sample) {
+  if (sample.congestionMarked) {
+    // ECN-style signal: halve the window, at most once per window of acknowledgements
+    if (m_markHoldAcks == 0) {
+      m_ssthresh = std::max(1, m_cwnd / 2);
+      m_cwnd = m_ssthresh;
+      m_ackCount = 0;
+      m_markHoldAcks = m_cwnd;
+      return;
+    }
+  }
+  if (m_markHoldAcks > 0) {
+    m_markHoldAcks -= 1;
+  }
   // Increase congestion window
   if (m_cwnd < m_ssthresh) {
     // Slow start: exponential growth
@@ -1,46 +1,194 @@
 #include "congestion-control.hpp"
 #include <cmath>
+#include <limits>
 #include <algorithm>
 #include "ns3/simulator.h"
 
+// Without pacing, the window is what limits the sending rate: each mode's pacing gain is
+// applied to the bandwidth-delay product to size the window.
+
+namespace {
+
+const double INF = std::numeric_limits<double>::infinity();
+
+const double HIGH_GAIN = 2.885;              // 2/ln(2): doubles the delivery rate every round
+const double DRAIN_GAIN = 1 / HIGH_GAIN;
+const double PROBE_BW_GAINS[] = {1.25, 0.75, 1, 1, 1, 1, 1, 1};
+const int PROBE_BW_PHASES = sizeof(PROBE_BW_GAINS) / sizeof(PROBE_BW_GAINS[0]);
+const double FULL_BW_GROWTH = 1.25;          // startup continues while bandwidth grows by 25% per round
+const int FULL_BW_ROUNDS = 3;
+const double MIN_RTT_WINDOW = 10.0;          // seconds before the min-RTT estimate must be refreshed
+const double PROBE_RTT_DURATION = 0.2;
+const int MIN_PIPE_CWND = 4;
+
+} // namespace
+
 CongestionBBR::CongestionBBR()
-  : m_cwnd(1)
-  , m_minRtt(1e9)
-  , m_bandwidthEstimate(0.0)
-  , m_lastSampleTime(0.0)
-  , m_deliveredBytes(0.0) {
+  : m_mode(Mode::STARTUP)
+  , m_cwnd(1)
+  , m_gain(HIGH_GAIN)
+  , m_cycleIndex(0)
+  , m_cycleStart(0.0)
+  , m_bwSamples()
+  , m_bwRound(0)
+  , m_maxBw(0.0)
+  , m_minRtt(INF)
+  , m_minRttStamp(0.0)
+  , m_probeRttDone(-1.0)
+  , m_delivered(0.0)
+  , m_roundStartDelivered(0.0)
+  , m_roundStartTime(0.0)
+  , m_roundAcks(0)
+  , m_roundSize(1)
+  , m_avgUnit(0.0)
+  , m_fullBw(0.0)
+  , m_fullBwRounds(0)
+  , m_filledPipe(false)
+  , m_conserving(false) {
 }
 
-void CongestionBBR::OnData() {
+void CongestionBBR::OnData(const DeliverySample& sample) {
   double now = ns3::Simulator::Now().GetSeconds();
-  double interval = now - m_lastSampleTime;
-  if (interval > 0.0) {
-    // Calculate delivery rate in bytes/sec over this interval
-    double deliveryRate = m_deliveredBytes / interval;
-    if (deliveryRate > m_bandwidthEstimate) {
-      m_bandwidthEstimate = deliveryRate;
-      // If RTT is known, set cwnd to bandwidth * minRTT (estimated BDP)
-      if (m_minRtt < 1e9) {
-        int targetCwnd = (int)std::ceil(m_bandwidthEstimate * m_minRtt);
-        if (targetCwnd > m_cwnd) {
-          m_cwnd = targetCwnd;
-        }
-      } else {
-        // If no RTT estimate yet, slowly increase
-        m_cwnd += 1;
-      }
-    } 
-    // If delivery rate did not increase, maintain current cwnd (BBR would probe periodically)
-  }
-  // Reset delivery measurement
-  m_deliveredBytes = 0.0;
-  m_lastSampleTime = now;
+  if (m_roundAcks == 0 && m_delivered == 0) {
+    m_roundStartTime = now;
+  }
+
+  // Deliveries are measured in bytes when known, otherwise in requests
+  double units = sample.bytes > 0 ? static_cast<double>(sample.bytes) : 1.0;
+  m_delivered += units;
+  m_avgUnit = m_avgUnit == 0 ? units : 0.875 * m_avgUnit + 0.125 * units;
+
+  if (sample.rtt > 0 && (sample.rtt <= m_minRtt || now - m_minRttStamp > MIN_RTT_WINDOW)) {
+    bool expired = m_minRtt < INF && sample.rtt > m_minRtt;
+    m_minRtt = sample.rtt;
+    m_minRttStamp = now;
+    if (expired && m_mode != Mode::PROBE_RTT) {
+      // The estimate went stale: drain the queue briefly to observe the path's base RTT
+      m_mode = Mode::PROBE_RTT;
+      m_probeRttDone = -1.0;
+    }
+  }
+
+  if (sample.congestionMarked) {
+    // BBRv1 has no ECN response; a mark at least ends the search for more bandwidth
+    if (m_mode == Mode::STARTUP) {
+      m_filledPipe = true;
+      m_mode = Mode::DRAIN;
+      m_gain = DRAIN_GAIN;
+    } else if (m_mode == Mode::PROBE_BW && PROBE_BW_GAINS[m_cycleIndex] > 1) {
+      m_cycleIndex = (m_cycleIndex + 1) % PROBE_BW_PHASES;
+      m_cycleStart = now;
+      m_gain = PROBE_BW_GAINS[m_cycleIndex];
+    }
+  }
+
+  if (m_mode == Mode::PROBE_BW && m_minRtt < INF && now - m_cycleStart >= m_minRtt) {
+    // Each gain phase lasts one min-RTT
+    m_cycleIndex = (m_cycleIndex + 1) % PROBE_BW_PHASES;
+    m_cycleStart = now;
+    m_gain = PROBE_BW_GAINS[m_cycleIndex];
+  }
+
+  if (m_mode == Mode::PROBE_RTT && m_probeRttDone < 0) {
+    m_probeRttDone = now + PROBE_RTT_DURATION;
+  }
+
+  m_roundAcks += 1;
+  if (m_roundAcks >= m_roundSize) {
+    EndRound(now);
+  }
+
+  if (m_mode == Mode::PROBE_RTT && now >= m_probeRttDone) {
+    m_minRttStamp = now;
+    m_probeRttDone = -1.0;
+    if (m_filledPipe) {
+      EnterProbeBw(now);
+    } else {
+      m_mode = Mode::STARTUP;
+      m_gain = HIGH_GAIN;
+    }
+  }
+
+  UpdateCwnd();
+}
+
+void CongestionBBR::EndRound(double now) {
+  double interval = now - m_roundStartTime;
+  if (interval > 0) {
+    // One delivery-rate sample per round, kept in a max filter over the last BW_FILTER_ROUNDS rounds
+    double bwSample = (m_delivered - m_roundStartDelivered) / interval;
+    m_bwSamples[m_bwRound % BW_FILTER_ROUNDS] = bwSample;
+    m_bwRound++;
+    m_maxBw = *std::max_element(m_bwSamples, m_bwSamples + BW_FILTER_ROUNDS);
+    CheckFullPipe(m_maxBw);
+  }
+
+  if (m_mode == Mode::STARTUP && m_filledPipe) {
+    m_mode = Mode::DRAIN;
+    m_gain = DRAIN_GAIN;
+  } else if (m_mode == Mode::DRAIN) {
+    // One round below the delivery rate empties the queue startup built
+    EnterProbeBw(now);
+  }
+
+  m_conserving = false;
+  m_roundAcks = 0;
+  m_roundSize = std::max(1, m_cwnd);
+  m_roundStartDelivered = m_delivered;
+  m_roundStartTime = now;
+}
+
+void CongestionBBR::CheckFullPipe(double bw) {
+  if (m_filledPipe) {
+    return;
+  }
+  if (bw >= m_fullBw * FULL_BW_GROWTH) {
+    m_fullBw = bw;
+    m_fullBwRounds = 0;
+    return;
+  }
+  if (++m_fullBwRounds >= FULL_BW_ROUNDS) {
+    m_filledPipe = true;
+  }
+}
+
+void CongestionBBR::EnterProbeBw(double now) {
+  m_mode = Mode::PROBE_BW;
+  // Start in a cruising phase (not the 0.75 drain phase) so a new flow does not undershoot
+  m_cycleIndex = 2;
+  m_cycleStart = now;
+  m_gain = PROBE_BW_GAINS[m_cycleIndex];
+}
+
+double CongestionBBR::Bdp() const {
+  return m_maxBw * m_minRtt;
+}
+
+void CongestionBBR::UpdateCwnd() {
+  if (m_mode == Mode::PROBE_RTT) {
+    m_cwnd = MIN_PIPE_CWND;
+    return;
+  }
+  if (m_maxBw <= 0 || m_minRtt == INF || m_avgUnit <= 0) {
+    // No model yet: grow like slow start
+    m_cwnd += 1;
+    return;
+  }
+  int target = static_cast<int>(std::ceil(m_gain * Bdp() / m_avgUnit));
+  if (m_mode == Mode::STARTUP) {
+    // Never shrink while searching for bandwidth
+    target = std::max(target, m_cwnd + 1);
+  }
+  if (m_conserving) {
+    target = std::min(target, m_cwnd);
+  }
+  m_cwnd = std::max(target, MIN_PIPE_CWND);
 }
 
 void CongestionBBR::OnTimeout() {
-  // On loss, BBR generally does not drastically cut cwnd; here we reduce slightly
-  m_cwnd = std::max(1, m_cwnd / 2);
-  // In a complete BBR, we might also reset bandwidth estimate or enter a recovery mode
+  // BBR does not treat loss as congestion; hold the window at half for the rest of the round
+  m_cwnd = std::max(MIN_PIPE_CWND, m_cwnd / 2);
+  m_conserving = true;
 }
 
 int CongestionBBR::GetCwnd() const {
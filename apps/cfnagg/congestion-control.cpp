@@ -0,0 +1,11 @@
+#include "congestion-control.hpp"
+
+std::unique_ptr<CongestionControl> MakeCongestionControl(const std::string& name) {
+  if (name == "CUBIC" || name == "cubic") {
+    return std::make_unique<CongestionCubic>();
+  } else if (name == "BBR" || name == "bbr") {
+    return std::make_unique<CongestionBBR>();
+  }
+  // Default to AIMD if unspecified or unknown
+  return std::make_unique<CongestionAIMD>();
+}
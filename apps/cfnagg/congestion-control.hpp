@@ -2,13 +2,24 @@
 #define CONGESTION_CONTROL_HPP
 
 #include <cstdint>
+#include <memory>
+#include <string>
+
+/** DeliverySample: what one acknowledged request (or round) tells the congestion controller. */
+struct DeliverySample {
+  double rtt = -1.0;              // round-trip time in seconds (< 0 if not measured)
+  uint64_t bytes = 0;             // payload bytes delivered (0 if unknown)
+  bool congestionMarked = false;  // Data carried an NDNLP congestion mark (lp::CongestionMarkTag)
+};
 
 /** CongestionControl: Abstract base class for congestion control algorithms. */
 class CongestionControl {
 public:
   virtual ~CongestionControl() = default;
   // Called when a Data (acknowledgement of an interest) is received successfully
-  virtual void OnData() = 0;
+  virtual void OnData(const DeliverySample& sample) = 0;
+  // Same, when nothing is known about the delivery
+  void OnData() { OnData(DeliverySample()); }
   // Called when an interest times out (loss event)
   virtual void OnTimeout() = 0;
   // Get current congestion window (number of parallel interests allowed)
@@ -19,48 +30,115 @@ public:
 class CongestionAIMD : public CongestionControl {
 public:
   CongestionAIMD();
-  void OnData() override;
+  using CongestionControl::OnData;
+  void OnData(const DeliverySample& sample) override;
   void OnTimeout() override;
   int GetCwnd() const override;
 private:
   int m_cwnd;
   int m_ssthresh;
   int m_ackCount;
+  int m_markHoldAcks;   // acks to wait before reacting to another congestion mark (one cut per window)
 };
 
-/** Cubic congestion control implementation (simplified). */
+/** CUBIC congestion control (RFC 9438) with HyStart++ slow start (RFC 9406). */
 class CongestionCubic : public CongestionControl {
 public:
   CongestionCubic();
-  void OnData() override;
+  using CongestionControl::OnData;
+  void OnData(const DeliverySample& sample) override;
   void OnTimeout() override;
   int GetCwnd() const override;
 private:
-  double m_epochStartTime;
-  double m_lastDropTime;
-  int m_cwnd;
+  // Multiplicative decrease after a loss or congestion mark (at most once per round)
+  void Reduce();
+  // Per-ack window growth in slow start (standard or conservative)
+  void SlowStart(const DeliverySample& sample);
+  // Per-ack window growth in congestion avoidance
+  void CongestionAvoidance(double now);
+  // Round boundary: roll HyStart++ RTT rounds and conservative slow start
+  void EndRound();
+
+  double m_cwnd;
   double m_ssthresh;
-  int m_ackCount;
-  double m_Wmax;
+  double m_Wmax;                // window before the last reduction
+  double m_K;                   // time (s) for the cubic curve to climb back to m_Wmax
+  double m_epochStartTime;      // start of the current congestion avoidance epoch (< 0: none)
+  double m_West;                // Reno-friendly window estimate
+  double m_minRtt;              // smallest RTT seen (s)
   // Cubic parameters
   const double m_C;
   const double m_beta;
+
+  // Rounds are counted in acks: one round ends after a window's worth of acks
+  double m_roundAcks;
+  double m_roundSize;
+  bool m_reducedThisRound;
+
+  // HyStart++ state
+  double m_lastRoundMinRtt;
+  double m_currentRoundMinRtt;
+  int m_rttSampleCount;
+  bool m_inCss;                 // in conservative slow start
+  double m_cssBaselineMinRtt;
+  int m_cssRounds;
 };
 
-/** BBR congestion control implementation (simplified). */
+/** BBR (v1) congestion control: startup, drain, probe-bw and probe-rtt driven by bandwidth and min-RTT models. */
 class CongestionBBR : public CongestionControl {
 public:
   CongestionBBR();
-  void OnData() override;
+  using CongestionControl::OnData;
+  void OnData(const DeliverySample& sample) override;
   void OnTimeout() override;
   int GetCwnd() const override;
-  // (In a full implementation, methods to record RTT and delivered bytes would be added)
 private:
+  enum class Mode { STARTUP, DRAIN, PROBE_BW, PROBE_RTT };
+
+  // Round boundary: take a delivery-rate sample and advance the state machine
+  void EndRound(double now);
+  // Startup is over once the bandwidth estimate stops growing
+  void CheckFullPipe(double bwSample);
+  void EnterProbeBw(double now);
+  // Bandwidth-delay product in delivery units (bytes, or requests if sizes are unknown)
+  double Bdp() const;
+  // Recompute the window from the model for the current mode and gain
+  void UpdateCwnd();
+
+  Mode m_mode;
   int m_cwnd;
+  double m_gain;                // window gain of the current mode / probe-bw phase
+  int m_cycleIndex;             // probe-bw gain cycle phase
+  double m_cycleStart;          // when the current probe-bw phase began
+
+  // Bandwidth model: windowed max of per-round delivery rates (units per second)
+  static const int BW_FILTER_ROUNDS = 10;
+  double m_bwSamples[BW_FILTER_ROUNDS];
+  int m_bwRound;
+  double m_maxBw;
+
+  // Min-RTT model
   double m_minRtt;
-  double m_bandwidthEstimate;
-  double m_lastSampleTime;
-  double m_deliveredBytes;
+  double m_minRttStamp;
+  double m_probeRttDone;        // when probe-rtt may end (< 0 while not probing)
+
+  // Delivery accounting for rate samples
+  double m_delivered;           // total units delivered
+  double m_roundStartDelivered;
+  double m_roundStartTime;
+  double m_roundAcks;
+  double m_roundSize;
+  double m_avgUnit;             // EWMA of units per ack, converts a BDP into a request window
+
+  // Full-pipe detection
+  double m_fullBw;
+  int m_fullBwRounds;
+  bool m_filledPipe;
+
+  bool m_conserving;            // halved window for one round after a timeout
 };
 
+// Create a congestion control instance by name ("AIMD", "CUBIC" or "BBR"); unknown names get AIMD
+std::unique_ptr<CongestionControl> MakeCongestionControl(const std::string& name);
+
 #endif // CONGESTION_CONTROL_HPP
@@ -1,64 +1,154 @@
 #include "congestion-control.hpp"
 #include <cmath>
+#include <limits>
 #include <algorithm>
 #include "ns3/simulator.h"
 
+namespace {
+
+const double INF = std::numeric_limits<double>::infinity();
+
+// HyStart++ constants (RFC 9406, section 4.3)
+const int N_RTT_SAMPLE = 8;
+const double MIN_RTT_THRESH = 0.004;
+const double MAX_RTT_THRESH = 0.016;
+const double MIN_RTT_DIVISOR = 8;
+const double CSS_GROWTH_DIVISOR = 4;
+const int CSS_ROUNDS = 5;
+
+} // namespace
+
 CongestionCubic::CongestionCubic()
-  : m_epochStartTime(0.0)
-  , m_lastDropTime(0.0)
-  , m_cwnd(1)
+  : m_cwnd(1)
   , m_ssthresh(10000)
-  , m_ackCount(0)
   , m_Wmax(0.0)
+  , m_K(0.0)
+  , m_epochStartTime(-1.0)
+  , m_West(0.0)
+  , m_minRtt(INF)
   , m_C(0.4)
-  , m_beta(0.7) {
+  , m_beta(0.7)
+  , m_roundAcks(0)
+  , m_roundSize(1)
+  , m_reducedThisRound(false)
+  , m_lastRoundMinRtt(INF)
+  , m_currentRoundMinRtt(INF)
+  , m_rttSampleCount(0)
+  , m_inCss(false)
+  , m_cssBaselineMinRtt(INF)
+  , m_cssRounds(0) {
 }
 
-void CongestionCubic::OnData() {
+void CongestionCubic::OnData(const DeliverySample& sample) {
   double now = ns3::Simulator::Now().GetSeconds();
-  if (m_cwnd < m_ssthresh) {
-    // Slow start phase
+  if (sample.rtt > 0) {
+    m_minRtt = std::min(m_minRtt, sample.rtt);
+    m_currentRoundMinRtt = std::min(m_currentRoundMinRtt, sample.rtt);
+    m_rttSampleCount++;
+  }
+
+  if (sample.congestionMarked) {
+    Reduce();
+  } else if (m_cwnd < m_ssthresh) {
+    SlowStart(sample);
+  } else {
+    CongestionAvoidance(now);
+  }
+
+  m_roundAcks += 1;
+  if (m_roundAcks >= m_roundSize) {
+    EndRound();
+  }
+}
+
+void CongestionCubic::SlowStart(const DeliverySample& sample) {
+  if (!m_inCss) {
     m_cwnd += 1;
-    return;
+    // HyStart++: leave exponential growth once the round's RTT rises noticeably above the last round's
+    if (m_rttSampleCount >= N_RTT_SAMPLE && m_currentRoundMinRtt < INF && m_lastRoundMinRtt < INF) {
+      double rttThresh = std::max(MIN_RTT_THRESH, std::min(m_lastRoundMinRtt / MIN_RTT_DIVISOR, MAX_RTT_THRESH));
+      if (m_currentRoundMinRtt >= m_lastRoundMinRtt + rttThresh) {
+        m_cssBaselineMinRtt = m_currentRoundMinRtt;
+        m_inCss = true;
+        m_cssRounds = 0;
+      }
+    }
+  } else {
+    // Conservative slow start: slower growth while checking whether the RTT increase was spurious
+    m_cwnd += 1 / CSS_GROWTH_DIVISOR;
+    if (m_rttSampleCount >= N_RTT_SAMPLE && m_currentRoundMinRtt < m_cssBaselineMinRtt) {
+      m_inCss = false;
+      m_cssBaselineMinRtt = INF;
+    }
   }
-  if (m_epochStartTime == 0.0) {
+}
+
+void CongestionCubic::CongestionAvoidance(double now) {
+  if (m_epochStartTime < 0) {
+    // New epoch: the cubic curve starts at the current window and plateaus at m_Wmax
     m_epochStartTime = now;
-    if (m_Wmax < m_cwnd) {
+    if (m_cwnd < m_Wmax) {
+      m_K = std::cbrt((m_Wmax - m_cwnd) / m_C);
+    } else {
+      m_K = 0;
       m_Wmax = m_cwnd;
     }
+    m_West = m_cwnd;
   }
+  double rtt = m_minRtt < INF ? m_minRtt : 0;
   double t = now - m_epochStartTime;
-  // Calculate Cubic target window W(t)
-  double K = cbrt(m_Wmax * (1 - m_beta) / m_C);
-  double target;
-  if (t < K) {
-    target = m_Wmax - m_C * std::pow(K - t, 3);
-  } else {
-    target = m_Wmax + m_C * std::pow(t - K, 3);
+
+  // Reno-friendly estimate grows by alpha per window of acks (RFC 9438, section 4.3)
+  double alpha = 3 * (1 - m_beta) / (1 + m_beta);
+  m_West += alpha / m_cwnd;
+
+  double wCubic = m_C * std::pow(t - m_K, 3) + m_Wmax;
+  if (wCubic < m_West) {
+    m_cwnd = m_West;
+    return;
   }
-  if (target < m_cwnd) {
-    // TCP-friendly region: do linear increase
-    m_ackCount++;
-    if (m_ackCount >= m_cwnd) {
-      m_cwnd += 1;
-      m_ackCount = 0;
-    }
+  // Concave/convex region: close the gap to where the curve will be one RTT from now
+  double target = m_C * std::pow(t + rtt - m_K, 3) + m_Wmax;
+  target = std::max(m_cwnd, std::min(target, 1.5 * m_cwnd));
+  m_cwnd += (target - m_cwnd) / m_cwnd;
+}
+
+void CongestionCubic::EndRound() {
+  m_roundAcks = 0;
+  m_roundSize = std::max(1.0, m_cwnd);
+  m_reducedThisRound = false;
+  if (m_inCss && ++m_cssRounds >= CSS_ROUNDS) {
+    // RTT increase confirmed: enter congestion avoidance
+    m_ssthresh = m_cwnd;
+    m_inCss = false;
+  }
+  m_lastRoundMinRtt = m_currentRoundMinRtt;
+  m_currentRoundMinRtt = INF;
+  m_rttSampleCount = 0;
+}
+
+void CongestionCubic::Reduce() {
+  if (m_reducedThisRound) {
+    return;
+  }
+  m_reducedThisRound = true;
+  // Fast convergence: release bandwidth if the window did not regain its previous maximum
+  if (m_cwnd < m_Wmax) {
+    m_Wmax = m_cwnd * (1 + m_beta) / 2;
   } else {
-    // Cubic region: increase cwnd if target > current cwnd
-    m_cwnd += 1;
+    m_Wmax = m_cwnd;
   }
+  m_cwnd = std::max(1.0, m_cwnd * m_beta);
+  m_ssthresh = std::max(2.0, m_cwnd);
+  m_epochStartTime = -1.0; // reset epoch
+  m_inCss = false;
 }
 
 void CongestionCubic::OnTimeout() {
-  // On loss event, update Wmax and reduce cwnd
-  m_lastDropTime = ns3::Simulator::Now().GetSeconds();
-  m_Wmax = m_cwnd * 1.0;  // record last cwnd
-  m_cwnd = std::max(1, (int)std::floor(m_cwnd * m_beta));
-  m_ssthresh = std::max(1.0, m_Wmax * m_beta);
-  m_ackCount = 0;
-  m_epochStartTime = 0.0; // reset epoch
+  // An unanswered request is the loss signal here (there is no duplicate-ack recovery)
+  Reduce();
 }
 
 int CongestionCubic::GetCwnd() const {
-  return std::max(m_cwnd, 1);
+  return std::max(static_cast<int>(m_cwnd), 1);
 }
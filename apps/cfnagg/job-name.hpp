@@ -0,0 +1,41 @@
+#ifndef JOB_NAME_HPP
+#define JOB_NAME_HPP
+
+#include <cstdint>
+#include <string>
+#include "ndn-cxx/name.hpp"
+
+namespace ns3 {
+
+// Multi-job naming: the rounds of aggregation job J are requested from a node as
+// /<node>/<job>/seq=<round>, where <job> is a name component of TLV-TYPE CFN_TLV_JOB_ID holding J
+// as a NonNegativeInteger. Names without it belong to job 0, so a single-job tree keeps the plain
+// /<node>/seq=<round> names. Late-delta requests (late-delta.hpp) extend the same job prefix.
+
+// Name component TLV-TYPE of a job id
+const uint32_t CFN_TLV_JOB_ID = 252;
+
+// Prefix under which a node serves a job's rounds: "/<node>", plus the job component unless job 0
+inline ndn::Name MakeJobPrefix(const std::string& node, uint32_t job) {
+  ndn::Name prefix("/" + node);
+  if (job != 0) {
+    prefix.append(ndn::name::Component::fromNumber(job, CFN_TLV_JOB_ID));
+  }
+  return prefix;
+}
+
+// Job of a round (or delta) name: its second component if that is a job component, else job 0
+inline uint32_t ReadJobId(const ndn::Name& name) {
+  if (name.size() < 3) {
+    return 0;
+  }
+  const ndn::name::Component& component = name.get(1);
+  if (component.type() != CFN_TLV_JOB_ID || !component.isNumber()) {
+    return 0;
+  }
+  return static_cast<uint32_t>(component.toNumber());
+}
+
+} // namespace ns3
+
+#endif // JOB_NAME_HPP
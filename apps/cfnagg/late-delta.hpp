@@ -0,0 +1,44 @@
+#ifndef LATE_DELTA_HPP
+#define LATE_DELTA_HPP
+
+#include <cstdint>
+#include "ndn-cxx/data.hpp"
+#include "ndn-cxx/encoding/block-helpers.hpp"
+#include "../agg-common/agg-name.hpp"
+
+namespace ns3 {
+
+// Late-delta protocol: an aggregate sent while some of the subtree is still outstanding carries
+// the outstanding count in an AppMetaInfo element. The parent then pulls the contributions that
+// arrive later as "delta" Data named <child>/seq=<round>/delta/seg=<k>, k = 1, 2, ... (so no
+// request is ever answered from a cache), until a delta reports nothing outstanding.
+
+// AppMetaInfo TLV-TYPE holding the number of children a node may still hear from
+const uint32_t CFN_TLV_OUTSTANDING = 128;
+
+// Name component marking a delta request
+inline const ndn::name::Component& DeltaComponent() {
+  static const ndn::name::Component component("delta");
+  return component;
+}
+
+// Name of the k-th delta request to a child for a round
+inline ndn::Name MakeDeltaName(const ndn::Name& childPrefix, uint64_t seq, uint64_t k) {
+  return ndn::Name(childPrefix).appendSequenceNumber(seq).append(DeltaComponent()).appendSegment(k);
+}
+
+// Recognize a delta request/reply name and read its round number
+inline bool ParseDeltaName(const ndn::Name& name, uint64_t& seq) {
+  return name.size() >= 3 && name.get(-1).isSegment() && name.get(-2) == DeltaComponent() &&
+         ns3::ndn::ReadRoundNumber(name.get(-3), seq);
+}
+
+// Outstanding count carried by an aggregate (0 if absent: the aggregate is complete)
+inline uint32_t ReadOutstanding(const ndn::Data& data) {
+  const ndn::Block* block = data.getMetaInfo().findAppMetaInfo(CFN_TLV_OUTSTANDING);
+  return block == nullptr ? 0 : ::ndn::encoding::readNonNegativeIntegerAs<uint32_t>(*block);
+}
+
+} // namespace ns3
+
+#endif // LATE_DELTA_HPP
@@ -4,9 +4,9 @@
 
 namespace ns3 {
 
-EventId StragglerManager::ScheduleAggregator(CFNAggregatorApp* app, int seq, double delay) {
-  // Schedule CFNAggregatorApp::OnStragglerTimeout(seq) to be called after 'delay' seconds
-  return Simulator::Schedule(Seconds(delay), &CFNAggregatorApp::OnStragglerTimeout, app, seq);
+EventId StragglerManager::ScheduleAggregator(CFNAggregatorApp* app, uint32_t job, int seq, double delay) {
+  // Schedule CFNAggregatorApp::OnStragglerTimeout(job, seq) to be called after 'delay' seconds
+  return Simulator::Schedule(Seconds(delay), &CFNAggregatorApp::OnStragglerTimeout, app, job, seq);
 }
 
 EventId StragglerManager::ScheduleRoot(CFNRootApp* app, int seq, double delay) {
@@ -14,6 +14,16 @@ EventId StragglerManager::ScheduleRoot(CFNRootApp* app, int seq, double delay) {
   return Simulator::Schedule(Seconds(delay), &CFNRootApp::OnStragglerTimeout, app, seq);
 }
 
+EventId StragglerManager::ScheduleAggregatorDeltaWindow(CFNAggregatorApp* app, uint32_t job, int seq, double delay) {
+  // Schedule CFNAggregatorApp::OnDeltaWindowClosed(job, seq): stop waiting for late contributions
+  return Simulator::Schedule(Seconds(delay), &CFNAggregatorApp::OnDeltaWindowClosed, app, job, seq);
+}
+
+EventId StragglerManager::ScheduleRootDeltaWindow(CFNRootApp* app, int seq, double delay) {
+  // Schedule CFNRootApp::OnDeltaWindowClosed(seq) after 'delay' seconds
+  return Simulator::Schedule(Seconds(delay), &CFNRootApp::OnDeltaWindowClosed, app, seq);
+}
+
 void StragglerManager::Cancel(EventId& event) {
   if (event.IsRunning()) {
     Simulator::Cancel(event);
@@ -12,8 +12,10 @@ class CFNRootApp;
 /** StragglerManager: Utility to schedule and cancel aggregation timeout events. */
 class StragglerManager {
 public:
-  static EventId ScheduleAggregator(CFNAggregatorApp* app, int seq, double delay);
+  static EventId ScheduleAggregator(CFNAggregatorApp* app, uint32_t job, int seq, double delay);
   static EventId ScheduleRoot(CFNRootApp* app, int seq, double delay);
+  static EventId ScheduleAggregatorDeltaWindow(CFNAggregatorApp* app, uint32_t job, int seq, double delay);
+  static EventId ScheduleRootDeltaWindow(CFNRootApp* app, int seq, double delay);
   static void Cancel(EventId& event);
 };
 
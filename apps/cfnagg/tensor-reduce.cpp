@@ -0,0 +1,375 @@
+#include "tensor-reduce.hpp"
+#include <cmath>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define CFN_TENSOR_X86 1
+#include <immintrin.h>
+#endif
+
+namespace ns3 {
+
+namespace {
+
+// Payloads are little-endian element arrays; these helpers keep the scalar path portable.
+inline uint16_t LoadLe16(const uint8_t* p) {
+  uint16_t v;
+  std::memcpy(&v, p, sizeof(v));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  v = __builtin_bswap16(v);
+#endif
+  return v;
+}
+
+inline uint32_t LoadLe32(const uint8_t* p) {
+  uint32_t v;
+  std::memcpy(&v, p, sizeof(v));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  v = __builtin_bswap32(v);
+#endif
+  return v;
+}
+
+inline uint64_t LoadLe64(const uint8_t* p) {
+  uint64_t v;
+  std::memcpy(&v, p, sizeof(v));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  v = __builtin_bswap64(v);
+#endif
+  return v;
+}
+
+inline void StoreLe16(uint8_t* p, uint16_t v) {
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  v = __builtin_bswap16(v);
+#endif
+  std::memcpy(p, &v, sizeof(v));
+}
+
+inline void StoreLe32(uint8_t* p, uint32_t v) {
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  v = __builtin_bswap32(v);
+#endif
+  std::memcpy(p, &v, sizeof(v));
+}
+
+inline void StoreLe64(uint8_t* p, uint64_t v) {
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  v = __builtin_bswap64(v);
+#endif
+  std::memcpy(p, &v, sizeof(v));
+}
+
+inline float BitsToFloat(uint32_t bits) {
+  float f;
+  std::memcpy(&f, &bits, sizeof(f));
+  return f;
+}
+
+inline uint32_t FloatToBits(float f) {
+  uint32_t bits;
+  std::memcpy(&bits, &f, sizeof(bits));
+  return bits;
+}
+
+// Round-to-nearest-even float32 -> bf16 conversion (NaNs stay quiet NaNs)
+inline uint16_t FloatToBf16(float f) {
+  uint32_t bits = FloatToBits(f);
+  if ((bits & 0x7fffffffu) > 0x7f800000u) {
+    return static_cast<uint16_t>((bits >> 16) | 0x0040u);
+  }
+  bits += 0x7fffu + ((bits >> 16) & 1u);
+  return static_cast<uint16_t>(bits >> 16);
+}
+
+// ---- Scalar kernels (integer sums wrap, like the hardware lanes do) ----
+
+void AddInt32Scalar(void* acc, const uint8_t* src, size_t count) {
+  uint32_t* a = static_cast<uint32_t*>(acc);
+  for (size_t i = 0; i < count; ++i) {
+    a[i] += LoadLe32(src + 4 * i);
+  }
+}
+
+void AddInt64Scalar(void* acc, const uint8_t* src, size_t count) {
+  uint64_t* a = static_cast<uint64_t*>(acc);
+  for (size_t i = 0; i < count; ++i) {
+    a[i] += LoadLe64(src + 8 * i);
+  }
+}
+
+void AddFloat32Scalar(void* acc, const uint8_t* src, size_t count) {
+  float* a = static_cast<float*>(acc);
+  for (size_t i = 0; i < count; ++i) {
+    a[i] += BitsToFloat(LoadLe32(src + 4 * i));
+  }
+}
+
+void AddBf16Scalar(void* acc, const uint8_t* src, size_t count) {
+  float* a = static_cast<float*>(acc);
+  for (size_t i = 0; i < count; ++i) {
+    a[i] += BitsToFloat(static_cast<uint32_t>(LoadLe16(src + 2 * i)) << 16);
+  }
+}
+
+#ifdef CFN_TENSOR_X86
+
+// ---- AVX2 kernels: 256-bit lanes, scalar tail ----
+
+__attribute__((target("avx2"))) void AddInt32Avx2(void* acc, const uint8_t* src, size_t count) {
+  uint32_t* a = static_cast<uint32_t*>(acc);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 4 * i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(a + i), _mm256_add_epi32(x, y));
+  }
+  AddInt32Scalar(a + i, src + 4 * i, count - i);
+}
+
+__attribute__((target("avx2"))) void AddInt64Avx2(void* acc, const uint8_t* src, size_t count) {
+  uint64_t* a = static_cast<uint64_t*>(acc);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 8 * i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(a + i), _mm256_add_epi64(x, y));
+  }
+  AddInt64Scalar(a + i, src + 8 * i, count - i);
+}
+
+__attribute__((target("avx2"))) void AddFloat32Avx2(void* acc, const uint8_t* src, size_t count) {
+  float* a = static_cast<float*>(acc);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256 x = _mm256_loadu_ps(a + i);
+    __m256 y = _mm256_loadu_ps(reinterpret_cast<const float*>(src + 4 * i));
+    _mm256_storeu_ps(a + i, _mm256_add_ps(x, y));
+  }
+  AddFloat32Scalar(a + i, src + 4 * i, count - i);
+}
+
+__attribute__((target("avx2"))) void AddBf16Avx2(void* acc, const uint8_t* src, size_t count) {
+  float* a = static_cast<float*>(acc);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    // widen 8 x bf16 to the upper halves of 8 x float32
+    __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2 * i));
+    __m256i w = _mm256_slli_epi32(_mm256_cvtepu16_epi32(h), 16);
+    __m256 x = _mm256_loadu_ps(a + i);
+    _mm256_storeu_ps(a + i, _mm256_add_ps(x, _mm256_castsi256_ps(w)));
+  }
+  AddBf16Scalar(a + i, src + 2 * i, count - i);
+}
+
+// ---- AVX-512F kernels: 512-bit lanes, scalar tail ----
+
+__attribute__((target("avx512f"))) void AddInt32Avx512(void* acc, const uint8_t* src, size_t count) {
+  uint32_t* a = static_cast<uint32_t*>(acc);
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    __m512i x = _mm512_loadu_si512(a + i);
+    __m512i y = _mm512_loadu_si512(src + 4 * i);
+    _mm512_storeu_si512(a + i, _mm512_add_epi32(x, y));
+  }
+  AddInt32Scalar(a + i, src + 4 * i, count - i);
+}
+
+__attribute__((target("avx512f"))) void AddInt64Avx512(void* acc, const uint8_t* src, size_t count) {
+  uint64_t* a = static_cast<uint64_t*>(acc);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m512i x = _mm512_loadu_si512(a + i);
+    __m512i y = _mm512_loadu_si512(src + 8 * i);
+    _mm512_storeu_si512(a + i, _mm512_add_epi64(x, y));
+  }
+  AddInt64Scalar(a + i, src + 8 * i, count - i);
+}
+
+__attribute__((target("avx512f"))) void AddFloat32Avx512(void* acc, const uint8_t* src, size_t count) {
+  float* a = static_cast<float*>(acc);
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    __m512 x = _mm512_loadu_ps(a + i);
+    __m512 y = _mm512_loadu_ps(src + 4 * i);
+    _mm512_storeu_ps(a + i, _mm512_add_ps(x, y));
+  }
+  AddFloat32Scalar(a + i, src + 4 * i, count - i);
+}
+
+__attribute__((target("avx512f"))) void AddBf16Avx512(void* acc, const uint8_t* src, size_t count) {
+  float* a = static_cast<float*>(acc);
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    __m256i h = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 2 * i));
+    __m512i w = _mm512_slli_epi32(_mm512_cvtepu16_epi32(h), 16);
+    __m512 x = _mm512_loadu_ps(a + i);
+    _mm512_storeu_ps(a + i, _mm512_add_ps(x, _mm512_castsi512_ps(w)));
+  }
+  AddBf16Scalar(a + i, src + 2 * i, count - i);
+}
+
+#endif // CFN_TENSOR_X86
+
+using AccumulateFn = void (*)(void*, const uint8_t*, size_t);
+
+struct KernelSet {
+  const char* name;
+  AccumulateFn addInt32;
+  AccumulateFn addInt64;
+  AccumulateFn addFloat32;
+  AccumulateFn addBf16;
+};
+
+// Pick the widest kernel set the running CPU supports (resolved once per process)
+const KernelSet& GetKernels() {
+  static const KernelSet kernels = [] {
+#ifdef CFN_TENSOR_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+      return KernelSet{"avx512", &AddInt32Avx512, &AddInt64Avx512, &AddFloat32Avx512, &AddBf16Avx512};
+    }
+    if (__builtin_cpu_supports("avx2")) {
+      return KernelSet{"avx2", &AddInt32Avx2, &AddInt64Avx2, &AddFloat32Avx2, &AddBf16Avx2};
+    }
+#endif
+    return KernelSet{"scalar", &AddInt32Scalar, &AddInt64Scalar, &AddFloat32Scalar, &AddBf16Scalar};
+  }();
+  return kernels;
+}
+
+} // namespace
+
+bool ParseTensorDType(const std::string& name, TensorDType& dtype) {
+  if (name == "int32" || name == "INT32") {
+    dtype = TensorDType::INT32;
+  } else if (name == "int64" || name == "INT64") {
+    dtype = TensorDType::INT64;
+  } else if (name == "float32" || name == "FLOAT32" || name == "fp32") {
+    dtype = TensorDType::FLOAT32;
+  } else if (name == "bf16" || name == "BF16" || name == "bfloat16") {
+    dtype = TensorDType::BF16;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+const char* TensorDTypeToString(TensorDType dtype) {
+  switch (dtype) {
+    case TensorDType::INT32:
+      return "int32";
+    case TensorDType::INT64:
+      return "int64";
+    case TensorDType::FLOAT32:
+      return "float32";
+    case TensorDType::BF16:
+      return "bf16";
+  }
+  return "unknown";
+}
+
+size_t TensorWireElementSize(TensorDType dtype) {
+  switch (dtype) {
+    case TensorDType::INT32:
+    case TensorDType::FLOAT32:
+      return 4;
+    case TensorDType::INT64:
+      return 8;
+    case TensorDType::BF16:
+      return 2;
+  }
+  return 0;
+}
+
+size_t TensorAccumElementSize(TensorDType dtype) {
+  return dtype == TensorDType::BF16 ? sizeof(float) : TensorWireElementSize(dtype);
+}
+
+void TensorAccumulate(TensorDType dtype, void* acc, const uint8_t* src, size_t count) {
+  const KernelSet& k = GetKernels();
+  switch (dtype) {
+    case TensorDType::INT32:
+      k.addInt32(acc, src, count);
+      break;
+    case TensorDType::INT64:
+      k.addInt64(acc, src, count);
+      break;
+    case TensorDType::FLOAT32:
+      k.addFloat32(acc, src, count);
+      break;
+    case TensorDType::BF16:
+      k.addBf16(acc, src, count);
+      break;
+  }
+}
+
+void TensorEncode(TensorDType dtype, const void* acc, uint8_t* dst, size_t count) {
+  switch (dtype) {
+    case TensorDType::INT32: {
+      const uint32_t* a = static_cast<const uint32_t*>(acc);
+      for (size_t i = 0; i < count; ++i) {
+        StoreLe32(dst + 4 * i, a[i]);
+      }
+      break;
+    }
+    case TensorDType::FLOAT32: {
+      const float* a = static_cast<const float*>(acc);
+      for (size_t i = 0; i < count; ++i) {
+        StoreLe32(dst + 4 * i, FloatToBits(a[i]));
+      }
+      break;
+    }
+    case TensorDType::INT64: {
+      const uint64_t* a = static_cast<const uint64_t*>(acc);
+      for (size_t i = 0; i < count; ++i) {
+        StoreLe64(dst + 8 * i, a[i]);
+      }
+      break;
+    }
+    case TensorDType::BF16: {
+      const float* a = static_cast<const float*>(acc);
+      for (size_t i = 0; i < count; ++i) {
+        StoreLe16(dst + 2 * i, FloatToBf16(a[i]));
+      }
+      break;
+    }
+  }
+}
+
+uint64_t TensorChecksum(TensorDType dtype, const void* acc, size_t count) {
+  switch (dtype) {
+    case TensorDType::INT32: {
+      const uint32_t* a = static_cast<const uint32_t*>(acc);
+      uint64_t sum = 0;
+      for (size_t i = 0; i < count; ++i) {
+        sum += static_cast<uint64_t>(static_cast<int64_t>(static_cast<int32_t>(a[i])));
+      }
+      return sum;
+    }
+    case TensorDType::INT64: {
+      const uint64_t* a = static_cast<const uint64_t*>(acc);
+      uint64_t sum = 0;
+      for (size_t i = 0; i < count; ++i) {
+        sum += a[i];
+      }
+      return sum;
+    }
+    case TensorDType::FLOAT32:
+    case TensorDType::BF16: {
+      const float* a = static_cast<const float*>(acc);
+      double sum = 0.0;
+      for (size_t i = 0; i < count; ++i) {
+        sum += a[i];
+      }
+      return static_cast<uint64_t>(std::llround(sum));
+    }
+  }
+  return 0;
+}
+
+const char* TensorKernelName() {
+  return GetKernels().name;
+}
+
+} // namespace ns3
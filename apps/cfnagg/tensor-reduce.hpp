@@ -0,0 +1,40 @@
+#ifndef TENSOR_REDUCE_HPP
+#define TENSOR_REDUCE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace ns3 {
+
+/** TensorDType: element type of a gradient tensor carried in a Data payload. */
+enum class TensorDType : uint8_t {
+  INT32,
+  INT64,
+  FLOAT32,
+  BF16
+};
+
+// Parse a type name ("int32", "int64", "float32", "bf16"); returns false if unknown
+bool ParseTensorDType(const std::string& name, TensorDType& dtype);
+// Canonical name of a tensor element type
+const char* TensorDTypeToString(TensorDType dtype);
+
+// Size in bytes of one element on the wire (payloads are little-endian element arrays)
+size_t TensorWireElementSize(TensorDType dtype);
+// Size in bytes of one element in the accumulator (bf16 is accumulated in float32)
+size_t TensorAccumElementSize(TensorDType dtype);
+
+// Add 'count' wire-encoded elements from 'src' into the accumulator array 'acc'
+void TensorAccumulate(TensorDType dtype, void* acc, const uint8_t* src, size_t count);
+// Encode 'count' accumulator elements from 'acc' into wire format at 'dst'
+void TensorEncode(TensorDType dtype, const void* acc, uint8_t* dst, size_t count);
+// Sum of all accumulator elements, truncated to 64 bits (used as a compact trace checksum)
+uint64_t TensorChecksum(TensorDType dtype, const void* acc, size_t count);
+
+// Name of the kernel set selected at runtime ("avx512", "avx2" or "scalar")
+const char* TensorKernelName();
+
+} // namespace ns3
+
+#endif // TENSOR_REDUCE_HPP
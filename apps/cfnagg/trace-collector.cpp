@@ -1,15 +1,52 @@
 #include "trace-collector.hpp"
 #include "ns3/simulator.h"
+#include <cmath>
 #include <iostream>
-#include <iomanip>
 
 std::ofstream TraceCollector::m_logFile;
+bool TraceCollector::m_csv = false;
+std::vector<std::string> TraceCollector::m_names;
+std::unordered_map<std::string, uint32_t> TraceCollector::m_nameIds;
+uint32_t TraceCollector::m_namesWritten = 0;
+std::vector<std::vector<TraceRecord>> TraceCollector::m_buffers;
+std::string TraceCollector::m_text;
+
+namespace {
+
+TraceRecord MakeRecord(TraceEvent event, uint32_t node, uint64_t seq, uint64_t timeNs, uint32_t job = 0) {
+  TraceRecord record = {};
+  record.timeNs = timeNs;
+  record.seq = seq;
+  record.node = node;
+  record.child = TRACE_NO_NAME;
+  record.event = static_cast<uint8_t>(event);
+  record.job = job;
+  return record;
+}
+
+uint64_t NowNs() {
+  return static_cast<uint64_t>(ns3::Simulator::Now().GetNanoSeconds());
+}
+
+uint64_t SecondsToNs(double time) {
+  return static_cast<uint64_t>(std::llround(time * 1e9));
+}
+
+} // namespace
 
 void TraceCollector::Open(const std::string& filename) {
-  m_logFile.open(filename);
+  m_logFile.open(filename, std::ios::binary);
   if (m_logFile.is_open()) {
-    // Write CSV header
-    m_logFile << "Time(s),Event,Node,Seq,Child,Expected,Received,Result\n";
+    m_csv = filename.size() >= 4 && filename.compare(filename.size() - 4, 4, ".csv") == 0;
+    m_namesWritten = 0;
+    if (m_csv) {
+      // Write CSV header
+      m_text.clear();
+      AppendCsvHeader(m_text);
+      m_logFile << m_text;
+    } else {
+      WriteTraceHeader(m_logFile);
+    }
   } else {
     std::cerr << "TraceCollector: Failed to open log file " << filename << std::endl;
   }
@@ -17,29 +54,121 @@ void TraceCollector::Open(const std::string& filename) {
 
 void TraceCollector::Close() {
   if (m_logFile.is_open()) {
+    for (uint32_t slot = 0; slot < m_buffers.size(); ++slot) {
+      Flush(slot);
+    }
     m_logFile.close();
   }
+  // The next simulation starts from a fresh name table and empty buffers
+  m_csv = false;
+  m_names.clear();
+  m_nameIds.clear();
+  m_namesWritten = 0;
+  m_buffers.clear();
+  m_text.clear();
+}
+
+uint32_t TraceCollector::Intern(const std::string& name) {
+  auto it = m_nameIds.find(name);
+  if (it != m_nameIds.end()) {
+    return it->second;
+  }
+  uint32_t id = static_cast<uint32_t>(m_names.size());
+  m_names.push_back(name);
+  m_nameIds.emplace(name, id);
+  return id;
+}
+
+void TraceCollector::Append(const TraceRecord& record) {
+  // CSV is read in file order, so all nodes share one buffer and lines stay in logging (time) order;
+  // binary blocks are per node and cfnagg-trace-convert sorts them
+  uint32_t slot = m_csv ? 0 : record.node;
+  if (slot >= m_buffers.size()) {
+    m_buffers.resize(slot + 1);
+  }
+  std::vector<TraceRecord>& buffer = m_buffers[slot];
+  if (buffer.capacity() < BLOCK_RECORDS) {
+    buffer.reserve(BLOCK_RECORDS);
+  }
+  buffer.push_back(record);
+  if (buffer.size() >= BLOCK_RECORDS) {
+    Flush(slot);
+  }
+}
+
+void TraceCollector::Flush(uint32_t slot) {
+  std::vector<TraceRecord>& buffer = m_buffers[slot];
+  if (buffer.empty()) {
+    return;
+  }
+  if (m_csv) {
+    m_text.clear();
+    for (const TraceRecord& record : buffer) {
+      AppendCsvRecord(m_text, record, m_names);
+    }
+    m_logFile.write(m_text.data(), m_text.size());
+  } else {
+    // Define names interned since the last block before records can refer to them
+    if (m_namesWritten < m_names.size()) {
+      WriteTraceNames(m_logFile, m_namesWritten, m_names.data() + m_namesWritten, m_names.size() - m_namesWritten);
+      m_namesWritten = m_names.size();
+    }
+    WriteTraceRecords(m_logFile, buffer.data(), buffer.size());
+  }
+  buffer.clear();
+}
+
+void TraceCollector::LogInterest(uint32_t node, uint64_t seq, uint32_t job) {
+  if (!m_logFile.is_open()) return;
+  Append(MakeRecord(TraceEvent::INTEREST_SENT, node, seq, NowNs(), job));
+}
+
+void TraceCollector::LogData(uint32_t node, uint64_t seq, uint32_t child, uint32_t job) {
+  if (!m_logFile.is_open()) return;
+  TraceRecord record = MakeRecord(TraceEvent::DATA_RECEIVED, node, seq, NowNs(), job);
+  record.child = child;
+  Append(record);
+}
+
+void TraceCollector::LogAggregate(uint32_t node, uint64_t seq, uint64_t result, uint32_t expected, uint32_t received,
+                                  uint32_t job) {
+  if (!m_logFile.is_open()) return;
+  TraceEvent event = (received == expected) ? TraceEvent::AGGREGATE_COMPLETE : TraceEvent::AGGREGATE_PARTIAL;
+  TraceRecord record = MakeRecord(event, node, seq, NowNs(), job);
+  record.result = result;
+  record.expected = expected;
+  record.received = received;
+  Append(record);
+}
+
+void TraceCollector::LogCorrection(uint32_t node, uint64_t seq, uint64_t result, uint32_t expected, uint32_t received,
+                                   uint32_t job) {
+  if (!m_logFile.is_open()) return;
+  TraceRecord record = MakeRecord(TraceEvent::AGGREGATE_CORRECTED, node, seq, NowNs(), job);
+  record.result = result;
+  record.expected = expected;
+  record.received = received;
+  Append(record);
 }
 
 void TraceCollector::LogInterest(const std::string& nodeName, int seq, double time) {
   if (!m_logFile.is_open()) return;
-  m_logFile << std::fixed << std::setprecision(3)
-            << time << ",InterestSent," << nodeName << "," << seq 
-            << ",,,," << "\n";
+  Append(MakeRecord(TraceEvent::INTEREST_SENT, Intern(nodeName), seq, SecondsToNs(time)));
 }
 
 void TraceCollector::LogData(const std::string& nodeName, int seq, const std::string& childName, double time) {
   if (!m_logFile.is_open()) return;
-  m_logFile << std::fixed << std::setprecision(3)
-            << time << ",DataReceived," << nodeName << "," << seq 
-            << "," << childName << ",,,\n";
+  TraceRecord record = MakeRecord(TraceEvent::DATA_RECEIVED, Intern(nodeName), seq, SecondsToNs(time));
+  record.child = Intern(childName);
+  Append(record);
 }
 
 void TraceCollector::LogAggregate(const std::string& nodeName, int seq, uint64_t result, uint32_t expected, uint32_t received) {
   if (!m_logFile.is_open()) return;
-  std::string eventType = (received == expected) ? "AggregateComplete" : "AggregatePartial";
-  m_logFile << std::fixed << std::setprecision(3)
-            << ns3::Simulator::Now().GetSeconds() << "," << eventType << "," 
-            << nodeName << "," << seq << ",," << expected << "," 
-            << received << "," << result << "\n";
+  LogAggregate(Intern(nodeName), static_cast<uint64_t>(seq), result, expected, received);
+}
+
+void TraceCollector::LogCorrection(const std::string& nodeName, int seq, uint64_t result, uint32_t expected, uint32_t received) {
+  if (!m_logFile.is_open()) return;
+  LogCorrection(Intern(nodeName), static_cast<uint64_t>(seq), result, expected, received);
 }
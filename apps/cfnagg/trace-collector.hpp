@@ -3,23 +3,55 @@
 
 #include <fstream>
 #include <string>
+#include <unordered_map>
+#include <vector>
+#include "trace-format.hpp"
 
-/** TraceCollector: Utility for logging events (Interests, Data, aggregations) to a file. */
+/** TraceCollector: Utility for logging events (Interests, Data, aggregations) to a file.
+ *  Records are buffered per node and written in blocks: binary (see trace-format.hpp) unless the
+ *  file name ends in ".csv", in which case all nodes share one buffer so the CSV lines stay in time
+ *  order. */
 class TraceCollector {
 public:
-  // Open the log file (writes header line)
+  // Open the log file (binary header, or CSV header line for *.csv)
   static void Open(const std::string& filename);
-  // Close the log file
+  // Flush all buffered records, close the log file and forget the interned names
   static void Close();
-  // Log an interest sent event (node, sequence, time)
+  // Id of a node or child name in the trace; apps intern their name once and log by id
+  static uint32_t Intern(const std::string& name);
+
+  // Log an interest sent event (node, sequence, job) at the current simulation time
+  static void LogInterest(uint32_t node, uint64_t seq, uint32_t job = 0);
+  // Log a data received event (node, sequence, child, job)
+  static void LogData(uint32_t node, uint64_t seq, uint32_t child, uint32_t job = 0);
+  // Log an aggregation result (complete or partial) event (node, sequence, expected children, received children, result, job)
+  static void LogAggregate(uint32_t node, uint64_t seq, uint64_t result, uint32_t expected, uint32_t received,
+                           uint32_t job = 0);
+  // Log a late-delta correction of an already reported aggregate (node, sequence, expected, received, corrected result or delta, job)
+  static void LogCorrection(uint32_t node, uint64_t seq, uint64_t result, uint32_t expected, uint32_t received,
+                            uint32_t job = 0);
+
+  // By-name variants (intern the names on every call)
   static void LogInterest(const std::string& nodeName, int seq, double time);
-  // Log a data received event (node, sequence, child, time)
   static void LogData(const std::string& nodeName, int seq, const std::string& childName, double time);
-  // Log an aggregation result (complete or partial) event (node, sequence, expected children, received children, result)
   static void LogAggregate(const std::string& nodeName, int seq, uint64_t result, uint32_t expected, uint32_t received);
+  static void LogCorrection(const std::string& nodeName, int seq, uint64_t result, uint32_t expected, uint32_t received);
 
 private:
+  // Append a record to its node's buffer, flushing the buffer when full
+  static void Append(const TraceRecord& record);
+  // Write one buffer's records as a block (a node's, or in CSV mode everyone's)
+  static void Flush(uint32_t slot);
+
+  static const size_t BLOCK_RECORDS = 4096;      // records per node buffer (192 KiB)
+
   static std::ofstream m_logFile;
+  static bool m_csv;                             // write CSV text instead of binary blocks
+  static std::vector<std::string> m_names;       // interned names, indexed by id
+  static std::unordered_map<std::string, uint32_t> m_nameIds;
+  static uint32_t m_namesWritten;                // names already defined in the file
+  static std::vector<std::vector<TraceRecord>> m_buffers; // per-node record buffers (one shared for CSV)
+  static std::string m_text;                     // CSV formatting scratch
 };
 
-#endif // TRACE_COLLECTOR_HPP
\ No newline at end of file
+#endif // TRACE_COLLECTOR_HPP
@@ -0,0 +1,162 @@
+#include "trace-format.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+namespace {
+
+void AppendUint(std::string& out, uint64_t value) {
+  char buf[24];
+  auto res = std::to_chars(buf, buf + sizeof(buf), value);
+  out.append(buf, res.ptr);
+}
+
+const std::string& NameOf(const std::vector<std::string>& names, uint32_t id) {
+  static const std::string unknown = "?";
+  return id < names.size() ? names[id] : unknown;
+}
+
+} // namespace
+
+const char* TraceEventName(uint8_t event) {
+  switch (static_cast<TraceEvent>(event)) {
+    case TraceEvent::INTEREST_SENT: return "InterestSent";
+    case TraceEvent::DATA_RECEIVED: return "DataReceived";
+    case TraceEvent::AGGREGATE_COMPLETE: return "AggregateComplete";
+    case TraceEvent::AGGREGATE_PARTIAL: return "AggregatePartial";
+    case TraceEvent::AGGREGATE_CORRECTED: return "AggregateCorrected";
+  }
+  return "Unknown";
+}
+
+void WriteTraceHeader(std::ostream& os) {
+  TraceFileHeader header;
+  std::memcpy(header.magic, "CFNTRACE", sizeof(header.magic));
+  header.byteOrder = TRACE_BYTE_ORDER_MARK;
+  header.version = TRACE_VERSION;
+  header.recordSize = sizeof(TraceRecord);
+  header.reserved = 0;
+  os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+void WriteTraceNames(std::ostream& os, uint32_t firstId, const std::string* names, size_t count) {
+  std::string payload;
+  for (size_t i = 0; i < count; ++i) {
+    uint32_t id = firstId + static_cast<uint32_t>(i);
+    uint16_t length = static_cast<uint16_t>(std::min<size_t>(names[i].size(), UINT16_MAX));
+    payload.append(reinterpret_cast<const char*>(&id), sizeof(id));
+    payload.append(reinterpret_cast<const char*>(&length), sizeof(length));
+    payload.append(names[i], 0, length);
+  }
+  TraceBlockHeader block{static_cast<uint32_t>(TraceBlockType::NAMES), static_cast<uint32_t>(count), payload.size()};
+  os.write(reinterpret_cast<const char*>(&block), sizeof(block));
+  os.write(payload.data(), payload.size());
+}
+
+void WriteTraceRecords(std::ostream& os, const TraceRecord* records, size_t count) {
+  TraceBlockHeader block{static_cast<uint32_t>(TraceBlockType::RECORDS), static_cast<uint32_t>(count),
+                         count * sizeof(TraceRecord)};
+  os.write(reinterpret_cast<const char*>(&block), sizeof(block));
+  os.write(reinterpret_cast<const char*>(records), count * sizeof(TraceRecord));
+}
+
+void AppendCsvHeader(std::string& out) {
+  out += "Time(s),Event,Node,Seq,Child,Expected,Received,Result,Job\n";
+}
+
+void AppendCsvRecord(std::string& out, const TraceRecord& record, const std::vector<std::string>& names) {
+  // Time as seconds with full nanosecond precision, without going through floating point
+  AppendUint(out, record.timeNs / 1000000000);
+  char frac[10];
+  uint64_t ns = record.timeNs % 1000000000;
+  for (int i = 8; i >= 0; --i) {
+    frac[i] = static_cast<char>('0' + ns % 10);
+    ns /= 10;
+  }
+  frac[9] = ',';
+  out += '.';
+  out.append(frac, sizeof(frac));
+
+  out += TraceEventName(record.event);
+  out += ',';
+  out += NameOf(names, record.node);
+  out += ',';
+  AppendUint(out, record.seq);
+  out += ',';
+  switch (static_cast<TraceEvent>(record.event)) {
+    case TraceEvent::INTEREST_SENT:
+      out += ",,,,";
+      break;
+    case TraceEvent::DATA_RECEIVED:
+      out += NameOf(names, record.child);
+      out += ",,,,";
+      break;
+    default:
+      out += ',';
+      AppendUint(out, record.expected);
+      out += ',';
+      AppendUint(out, record.received);
+      out += ',';
+      AppendUint(out, record.result);
+      out += ',';
+      break;
+  }
+  AppendUint(out, record.job);
+  out += '\n';
+}
+
+TraceReader::TraceReader(std::istream& is)
+  : m_is(is)
+  , m_valid(false)
+  , m_next(0) {
+  TraceFileHeader header;
+  if (m_is.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+    m_valid = std::memcmp(header.magic, "CFNTRACE", sizeof(header.magic)) == 0 &&
+              header.byteOrder == TRACE_BYTE_ORDER_MARK && header.version == TRACE_VERSION &&
+              header.recordSize == sizeof(TraceRecord);
+  }
+}
+
+bool TraceReader::Next(TraceRecord& record) {
+  while (m_next >= m_block.size()) {
+    if (!ReadBlock()) {
+      return false;
+    }
+  }
+  record = m_block[m_next++];
+  return true;
+}
+
+bool TraceReader::ReadBlock() {
+  TraceBlockHeader block;
+  if (!m_valid || !m_is.read(reinterpret_cast<char*>(&block), sizeof(block))) {
+    return false;
+  }
+  m_block.clear();
+  m_next = 0;
+  if (block.type == static_cast<uint32_t>(TraceBlockType::RECORDS)) {
+    m_block.resize(block.count);
+    return static_cast<bool>(m_is.read(reinterpret_cast<char*>(m_block.data()), block.count * sizeof(TraceRecord)));
+  }
+  if (block.type == static_cast<uint32_t>(TraceBlockType::NAMES)) {
+    for (uint32_t i = 0; i < block.count; ++i) {
+      uint32_t id;
+      uint16_t length;
+      if (!m_is.read(reinterpret_cast<char*>(&id), sizeof(id)) ||
+          !m_is.read(reinterpret_cast<char*>(&length), sizeof(length))) {
+        return false;
+      }
+      std::string name(length, '\0');
+      if (!m_is.read(&name[0], length)) {
+        return false;
+      }
+      if (id >= m_names.size()) {
+        m_names.resize(id + 1);
+      }
+      m_names[id] = std::move(name);
+    }
+    return true;
+  }
+  // Unknown block type: skip it
+  return static_cast<bool>(m_is.ignore(block.bytes));
+}
@@ -0,0 +1,107 @@
+#ifndef TRACE_FORMAT_HPP
+#define TRACE_FORMAT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Binary trace layout written by TraceCollector and read back by the offline converter:
+//
+//   file   := FileHeader block*
+//   block  := BlockHeader payload
+//   NAMES  payload: 'count' entries of {uint32 id, uint16 length, length bytes}
+//   RECORDS payload: 'count' TraceRecord
+//
+// Names (nodes, children) are interned: records carry their ids, and every id is defined by a
+// NAMES block before the first RECORDS block that uses it. Integers are in the writer's native
+// byte order, recorded in FileHeader::byteOrder. Records of different nodes are flushed in
+// per-node blocks, so the file is only ordered by time within a node.
+
+/** TraceEvent: kind of a trace record. */
+enum class TraceEvent : uint8_t {
+  INTEREST_SENT = 1,
+  DATA_RECEIVED = 2,
+  AGGREGATE_COMPLETE = 3,
+  AGGREGATE_PARTIAL = 4,
+  AGGREGATE_CORRECTED = 5
+};
+
+/** TraceRecord: one fixed-size event. */
+struct TraceRecord {
+  uint64_t timeNs;     // simulation time in nanoseconds
+  uint64_t seq;        // round number
+  uint64_t result;     // aggregate value (aggregate events)
+  uint32_t node;       // interned node name
+  uint32_t child;      // interned child name (DataReceived), NO_NAME otherwise
+  uint32_t expected;   // expected children (aggregate events)
+  uint32_t received;   // received children (aggregate events)
+  uint8_t event;       // TraceEvent
+  uint8_t reserved[3];
+  uint32_t job;        // aggregation job the event belongs to (0 for single-job runs)
+};
+static_assert(sizeof(TraceRecord) == 48, "TraceRecord must stay fixed-size");
+
+const uint32_t TRACE_NO_NAME = 0xFFFFFFFF;
+const uint32_t TRACE_BYTE_ORDER_MARK = 0x01020304;
+const uint32_t TRACE_VERSION = 1;
+
+struct TraceFileHeader {
+  char magic[8];       // "CFNTRACE"
+  uint32_t byteOrder;  // TRACE_BYTE_ORDER_MARK as written
+  uint32_t version;    // TRACE_VERSION
+  uint32_t recordSize; // sizeof(TraceRecord)
+  uint32_t reserved;
+};
+
+enum class TraceBlockType : uint32_t {
+  NAMES = 1,
+  RECORDS = 2
+};
+
+struct TraceBlockHeader {
+  uint32_t type;       // TraceBlockType
+  uint32_t count;      // entries in the payload
+  uint64_t bytes;      // payload size
+};
+
+// Canonical event name, as used in the CSV "Event" column
+const char* TraceEventName(uint8_t event);
+
+// Write the file header
+void WriteTraceHeader(std::ostream& os);
+// Write a NAMES block defining ids firstId, firstId + 1, ... for 'names'
+void WriteTraceNames(std::ostream& os, uint32_t firstId, const std::string* names, size_t count);
+// Write a RECORDS block
+void WriteTraceRecords(std::ostream& os, const TraceRecord* records, size_t count);
+
+// CSV column header (the original text trace's columns, then Job)
+void AppendCsvHeader(std::string& out);
+// Append one record as a CSV line; 'names' maps interned ids to strings
+void AppendCsvRecord(std::string& out, const TraceRecord& record, const std::vector<std::string>& names);
+
+/** TraceReader: sequential reader of a binary trace. */
+class TraceReader {
+public:
+  explicit TraceReader(std::istream& is);
+
+  // False if the header is missing, from another version, or from a different byte order
+  bool IsValid() const { return m_valid; }
+  // Read the next record (name definitions are absorbed on the way); false at end of file
+  bool Next(TraceRecord& record);
+  // Names defined so far, indexed by id
+  const std::vector<std::string>& Names() const { return m_names; }
+
+private:
+  bool ReadBlock();
+
+  std::istream& m_is;
+  bool m_valid;
+  std::vector<std::string> m_names;
+  std::vector<TraceRecord> m_block;  // current RECORDS block
+  size_t m_next;                     // next record of m_block to return
+};
+
+#endif // TRACE_FORMAT_HPP
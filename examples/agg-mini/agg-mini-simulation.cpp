@@ -45,7 +45,13 @@
 
    CommandLine cmd;
    std::string baseDir = "src/ndnSIM/examples/agg-mini/";
+   uint32_t memoryBudget = 0;           // aggregator buffer bytes, 0 = unlimited
+   std::string overflowPolicy = "Drop";
+   std::string reduction = "sum";
    cmd.AddValue("baseDir", "Base directory for simulation files", baseDir);
+   cmd.AddValue("memoryBudget", "Aggregator buffer memory in bytes (0 = unlimited)", memoryBudget);
+   cmd.AddValue("overflowPolicy", "When the aggregator buffer is full: Drop, Nack, Evict or Bypass", overflowPolicy);
+   cmd.AddValue("reduction", "How payloads are combined: sum, max, min, mean, topk or or", reduction);
    cmd.Parse(argc, argv);
 
    if (!baseDir.empty() && baseDir.back() != '/')
@@ -198,6 +204,9 @@
           first = false;
       }
       aggHelper.SetAttribute("ChildPrefixes", StringValue(oss.str()));
+      aggHelper.SetAttribute("MemoryBudget", UintegerValue(memoryBudget));
+      aggHelper.SetAttribute("OverflowPolicy", StringValue(overflowPolicy));
+      aggHelper.SetAttribute("Reduction", StringValue(reduction));
       aggHelper.Install(aggNode).Start(Seconds(0.0));
       std::cout << "agg-mini-simulation: Installed AggregatorApp on " << aggName
                 << " for " << aggPrefix
@@ -230,6 +239,7 @@
       rootHelper.SetPrefix(aggPrefix);
       rootHelper.SetAttribute("MaxSeq", UintegerValue(3));
       rootHelper.SetAttribute("Interval", DoubleValue(1.0));
+      rootHelper.SetAttribute("Reduction", StringValue(reduction));
       // DELAYED START
       rootHelper.Install(rootNode).Start(Seconds(0.1));
       std::cout << "agg-mini-simulation: Installed RootApp on " << rootName
@@ -116,9 +116,11 @@ main(int argc, char* argv[])
   std::string configFile = "cfnagg-config.conf";
   // Add a new parameter for base directory with a default value
   std::string baseDir = "src/ndnSIM/examples/cfnagg-lite/";
+  std::string reduction = "sum";
 
   cmd.AddValue("configFile", "CFNAgg Configuration file", configFile);
   cmd.AddValue("baseDir", "Base directory for simulation files", baseDir);
+  cmd.AddValue("reduction", "How the aggregator combines producer values: sum, max, min, mean, topk or or", reduction);
   cmd.Parse(argc, argv);
 
   // If baseDir doesn't end with a slash, add one
@@ -235,6 +237,7 @@ main(int argc, char* argv[])
   // aggregatorHelper.SetPrefix("/agg/Agg1"); // Aggregator serves the parent prefix /agg
   aggregatorHelper.SetAttribute("Prefix", StringValue("/agg/Agg1"));
   aggregatorHelper.SetAttribute("PartialTimeout", TimeValue(MilliSeconds(config.GetPartialTimeout())));
+  aggregatorHelper.SetAttribute("Reduction", StringValue(reduction));
   ApplicationContainer aggregatorApps = aggregatorHelper.Install(agg1);
   Ptr<CFNAggregatorApp> aggregator = aggregatorApps.Get(0)->GetObject<CFNAggregatorApp>();
 
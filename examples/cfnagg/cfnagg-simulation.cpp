@@ -6,6 +6,7 @@
 #include "apps/cfnagg/cfn-aggregator-app.hpp"
 #include "apps/cfnagg/cfn-root-app.hpp"
 #include "apps/cfnagg/trace-collector.hpp"
+#include "apps/cfnagg/coded-aggregation.hpp"
 
 #include <sstream>
 
@@ -46,19 +47,47 @@ PrintFib(Ptr<Node> node, std::ostream &os)
   }
 }
 
+// One aggregation job: its tree (parent -> children) and its share of the aggregators it crosses
+struct AggJob {
+  uint32_t id = 0;
+  double weight = 1.0;
+  std::map<std::string, std::vector<std::string>> childrenMap;
+  std::string rootName;
+};
+
 int main(int argc, char* argv[]) {
   std::string topologyFile = "topologies/dcn.txt";
   std::string aggTreeFile = "topologies/aggtree-dcn.txt";
   std::string ccAlgorithm = "AIMD";
   double simTime = 20.0;
-  std::string logFile = "cfnagg-trace.csv";
+  std::string logFile = "cfnagg-trace.bin";
+  std::string tensorType = "";
+  uint32_t tensorElements = 1024;
+  uint32_t numJobs = 1;
+  uint32_t maxNodeRounds = 0;
+  std::string autoTreeRoot = "";
+  uint32_t maxFanIn = 0;
+  std::string exportTree = "";
+  uint32_t coding = 0;
+  std::string reduction = "sum";
 
   CommandLine cmd;
   cmd.AddValue("topology", "Path to the topology file (dcn.txt)", topologyFile);
   cmd.AddValue("aggTree", "Path to the aggregation tree file (aggtree-dcn.txt)", aggTreeFile);
   cmd.AddValue("cc", "Congestion control algorithm (AIMD, CUBIC, BBR)", ccAlgorithm);
   cmd.AddValue("simTime", "Simulation duration (seconds)", simTime);
-  cmd.AddValue("logFile", "Output log file name", logFile);
+  cmd.AddValue("logFile", "Output trace file (binary, see cfnagg-trace-convert; *.csv for text)", logFile);
+  cmd.AddValue("tensorType", "Tensor element type (int32, int64, float32, bf16; empty = scalar)", tensorType);
+  cmd.AddValue("tensorElements", "Tensor elements per producer Data", tensorElements);
+  cmd.AddValue("jobs", "Number of concurrent jobs running copies of a single-job aggregation tree", numJobs);
+  cmd.AddValue("maxNodeRounds", "Rounds an aggregator node serves at once across jobs (0 = no limit)", maxNodeRounds);
+  cmd.AddValue("autoTree", "Build the aggregation tree from the topology, rooted at this node, instead of "
+               "reading aggTree (producers: the other nodes with a single link)", autoTreeRoot);
+  cmd.AddValue("maxFanIn", "autoTree: maximum children per aggregator (0 = no limit)", maxFanIn);
+  cmd.AddValue("exportTree", "autoTree: save the built tree to this file (aggTree format)", exportTree);
+  cmd.AddValue("reduction", "How values are combined: sum, max, min, mean, topk or or (scalar mode)", reduction);
+  cmd.AddValue("coding", "Coded aggregation: producers lost per aggregator that still decode the exact sum "
+               "(0 = off; only aggregators whose children are all producers)", coding);
   cmd.Parse(argc, argv);
 
   // Read the network topology
@@ -94,78 +123,153 @@ int main(int argc, char* argv[]) {
   ns3::ndn::GlobalRoutingHelper globalRouting;
   globalRouting.InstallAll();
 
-  // Parse the aggregation tree configuration file
-  std::map<std::string, std::vector<std::string>> childrenMap;
-  std::ifstream aggFile(aggTreeFile);
-  if (!aggFile.is_open()) {
-    std::cerr << "ERROR: Cannot open aggregation tree file: " << aggTreeFile << std::endl;
-    return 1;
+  std::vector<AggJob> jobs(1);
+  if (!autoTreeRoot.empty()) {
+    NodeContainer producers;
+    for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); ++node) {
+      Ptr<ns3::ndn::GlobalRouter> router = (*node)->GetObject<ns3::ndn::GlobalRouter>();
+      if (Names::FindName(*node) != autoTreeRoot && router->GetIncidencies().size() == 1) {
+        producers.Add(*node);
+      }
+    }
+    ns3::ndn::AggregationTreeHelper treeHelper;
+    treeHelper.SetMaxFanIn(maxFanIn);
+    if (!treeHelper.Build(Names::Find<Node>(autoTreeRoot), producers)) {
+      std::cerr << "WARNING: the built aggregation tree exceeds maxFanIn" << std::endl;
+    }
+    jobs[0].childrenMap = treeHelper.GetTree();
+    jobs[0].rootName = treeHelper.GetRoot();
+    if (!exportTree.empty()) {
+      treeHelper.Write(exportTree);
+    }
   }
-  std::string line;
-  while (std::getline(aggFile, line)) {
-    if (line.size() == 0 || line[0] == '#') continue;
-    std::stringstream ss(line);
-    std::string parent;
-    ss >> parent;
-    std::vector<std::string> childList;
-    std::string child;
-    while (ss >> child) {
-      childList.push_back(child);
+  else {
+    // "Parent Child1 Child2 ..." lines, optionally split into concurrent jobs by "job <id> [weight]"
+    // lines (lines before the first belong to job 0)
+    jobs.clear();
+    for (const auto& tree : ns3::ndn::AggregationTreeHelper::ReadJobs(aggTreeFile)) {
+      AggJob job;
+      job.id = tree.GetJobId();
+      job.weight = tree.GetJobWeight();
+      job.childrenMap = tree.GetTree();
+      job.rootName = tree.GetRoot();
+      jobs.push_back(job);
+    }
+    if (jobs.empty()) {
+      std::cerr << "ERROR: No aggregation tree in " << aggTreeFile << std::endl;
+      return 1;
     }
-    childrenMap[parent] = childList;
   }
-  aggFile.close();
 
-  // Determine the root of the aggregation tree (node that is never a child)
-  std::set<std::string> allChildren;
-  for (auto& kv : childrenMap) {
-    for (auto& child : kv.second ) {
-      allChildren.insert(child);
+  // --jobs=N runs N copies of a single tree concurrently (jobs 1..N)
+  if (numJobs > 1 && jobs.size() == 1) {
+    AggJob tree = jobs[0];
+    jobs.clear();
+    for (uint32_t id = 1; id <= numJobs; ++id) {
+      tree.id = id;
+      jobs.push_back(tree);
     }
   }
-  std::string rootName;
-  for (auto& kv : childrenMap) {
-    const std::string& node = kv.first;
-    if (allChildren.find(node) == allChildren.end()) {
-      rootName = node;
-      break;
+
+  std::set<std::string> aggregatorNodes; // nodes that aggregate for at least one job
+  std::set<std::string> leafNodes;       // nodes that produce for at least one job
+  for (AggJob& job : jobs) {
+    // The helper found the root of the job's tree (the node that is never a child)
+    if (job.rootName.empty()) {
+      std::cerr << "ERROR: Root node not identified in aggregation tree of job " << job.id << "\n";
+      return 1;
+    }
+
+    // Identify leaf nodes (children without children) and aggregators (parents except the root)
+    for (auto& kv : job.childrenMap) {
+      if (kv.first != job.rootName) {
+        aggregatorNodes.insert(kv.first);
+      }
+      for (auto& child : kv.second) {
+        if (job.childrenMap.find(child) == job.childrenMap.end()) {
+          leafNodes.insert(child);
+        }
+      }
     }
   }
-  if (rootName.empty()) {
-    std::cerr << "ERROR: Root node not identified in aggregation tree\n";
-    return 1;
+  for (const std::string& node : leafNodes) {
+    if (aggregatorNodes.count(node) > 0) {
+      std::cerr << "ERROR: Node " << node << " is a leaf in one job and an aggregator in another\n";
+      return 1;
+    }
   }
 
-  // Identify all nodes in the aggregation tree (union of all parents and children)
-  std::set<std::string> allNodes;
-  for (auto& kv : childrenMap) {
-    allNodes.insert(kv.first);
-    for (auto& child : kv.second) {
-      allNodes.insert(child);
+  // Coded aggregation: aggregators of producers only decode from any n - coding of their n children;
+  // each producer also holds the partitions of its coding group peers
+  const uint64_t producerValue = 1;
+  std::set<std::string> codedAggregators;
+  std::map<std::string, std::string> partitionValues; // producer -> its peers' values
+  if (coding > 0) {
+    for (const std::string& parent : aggregatorNodes) {
+      bool producersOnly = true;
+      for (const AggJob& job : jobs) {
+        auto it = job.childrenMap.find(parent);
+        for (size_t i = 0; it != job.childrenMap.end() && i < it->second.size(); ++i) {
+          producersOnly = producersOnly && leafNodes.count(it->second[i]) > 0;
+        }
+      }
+      if (producersOnly) {
+        codedAggregators.insert(parent);
+      }
+    }
+    for (const AggJob& job : jobs) {
+      for (const std::string& parent : codedAggregators) {
+        auto it = job.childrenMap.find(parent);
+        if (it == job.childrenMap.end()) {
+          continue;
+        }
+        const std::vector<std::string>& children = it->second;
+        uint32_t groups = CodingGroupCount(children.size(), coding);
+        for (uint32_t i = 0; i < children.size() && groups > 0; ++i) {
+          auto members = CodingGroupMembers(CodingGroupOf(i, children.size(), coding), children.size(), coding);
+          std::ostringstream peers;
+          for (uint32_t j = members.first; j < members.second; ++j) {
+            if (j != i) {
+              peers << producerValue << " ";
+            }
+          }
+          // A producer answers every job with the same share, so its group must not change across jobs
+          auto inserted = partitionValues.emplace(children[i], peers.str());
+          if (!inserted.second && inserted.first->second != peers.str()) {
+            std::cerr << "ERROR: Producer " << children[i] << " is in coding groups of different sizes across jobs\n";
+            return 1;
+          }
+        }
+      }
     }
   }
 
-  // Identify leaf nodes (nodes without children)
-  std::vector<std::string> leaves;
-  for (const std::string& node : allNodes) {
-    if (childrenMap.find(node) == childrenMap.end()) {
-      leaves.push_back(node);
+  // Install a root application for each job on its root node
+  std::vector<Ptr<Node>> rootNodes;
+  for (const AggJob& job : jobs) {
+    Ptr<Node> rootNode = Names::Find<Node>(job.rootName);
+    ns3::ndn::AppHelper rootHelper("ns3::CFNRootApp");
+    // A root sharing its node with an aggregator must not claim the aggregator's prefix
+    rootHelper.SetPrefix(aggregatorNodes.count(job.rootName) > 0 ? "" : "/" + job.rootName);
+    rootHelper.SetAttribute("JobId", UintegerValue(job.id));
+    rootHelper.SetAttribute("CongestionControl", StringValue(ccAlgorithm));
+    rootHelper.SetAttribute("TensorType", StringValue(tensorType));
+    rootHelper.SetAttribute("Reduction", StringValue(reduction));
+    ApplicationContainer rootApps = rootHelper.Install(rootNode);
+    Ptr<CFNRootApp> rootApp = DynamicCast<CFNRootApp>(rootApps.Get(0));
+    const std::vector<std::string>& childList = job.childrenMap.at(job.rootName);
+    std::cout << "DEBUG: Setting children for Root [" << job.rootName << "] of job " << job.id << ": ";
+    for (const auto& child : childList) {
+      std::cout << child << " ";
     }
+    std::cout << std::endl;
+    rootApp->SetChildren(childList);
+    rootApp->SetCongestionControl(ccAlgorithm);
+    rootNodes.push_back(rootNode);
   }
 
-  // Install root application on the root node
-  Ptr<Node> rootNode = Names::Find<Node>(rootName);
-  ns3::ndn::AppHelper rootHelper("ns3::CFNRootApp");
-  rootHelper.SetPrefix("/" + rootName);
-  rootHelper.SetAttribute("CongestionControl", StringValue(ccAlgorithm));
-  rootHelper.Install(rootNode);
-  Ptr<CFNRootApp> rootApp = DynamicCast<CFNRootApp>(rootNode->GetApplication(0));
-
-  // Install aggregator applications on intermediate nodes (all parents except root)
-  std::map<std::string, Ptr<CFNAggregatorApp>> aggAppMap;
-  for (auto& kv : childrenMap) {
-    const std::string& parent = kv.first;
-    if (parent == rootName) continue;
+  // Install one aggregator application per intermediate node, serving every job through it
+  for (const std::string& parent : aggregatorNodes) {
     Ptr<Node> parentNode = Names::Find<Node>(parent);
     
     // Create the prefix for this node
@@ -177,62 +281,58 @@ int main(int argc, char* argv[]) {
     
     ns3::ndn::AppHelper aggHelper("ns3::CFNAggregatorApp");
     aggHelper.SetPrefix(nodePrefix);
-    aggHelper.Install(parentNode);
-    Ptr<CFNAggregatorApp> aggApp = DynamicCast<CFNAggregatorApp>(parentNode->GetApplication(0));
-    aggAppMap[parent] = aggApp;
+    aggHelper.SetAttribute("TensorType", StringValue(tensorType));
+    aggHelper.SetAttribute("MaxNodeRounds", UintegerValue(maxNodeRounds));
+    aggHelper.SetAttribute("Reduction", StringValue(reduction));
+    if (codedAggregators.count(parent) > 0) {
+      aggHelper.SetAttribute("CodingRedundancy", UintegerValue(coding));
+    }
+    ApplicationContainer aggApps = aggHelper.Install(parentNode);
+    Ptr<CFNAggregatorApp> aggApp = DynamicCast<CFNAggregatorApp>(aggApps.Get(0));
+
+    for (const AggJob& job : jobs) {
+      auto it = job.childrenMap.find(parent);
+      if (it == job.childrenMap.end() || parent == job.rootName) {
+        continue;
+      }
+      std::cout << "DEBUG: Setting children for Aggregator [" << parent << "] of job " << job.id << ": ";
+      for (const auto& child : it->second) {
+        std::cout << child << " ";
+      }
+      std::cout << std::endl;
+      aggApp->AddJob(job.id, it->second, job.weight);
+    }
   }
 
-  // Install producer applications on all leaf nodes
-  for (const std::string& leaf : leaves) {
+  // Install producer applications on all leaf nodes (a producer answers every job)
+  for (const std::string& leaf : leafNodes) {
     Ptr<Node> leafNode = Names::Find<Node>(leaf);
     ns3::ndn::AppHelper producerHelper("ns3::CFNProducerApp");
     producerHelper.SetPrefix("/" + leaf);
+    producerHelper.SetAttribute("TensorType", StringValue(tensorType));
+    producerHelper.SetAttribute("TensorElements", UintegerValue(tensorElements));
+    producerHelper.SetAttribute("Value", UintegerValue(producerValue));
+    auto peers = partitionValues.find(leaf);
+    if (peers != partitionValues.end()) {
+      producerHelper.SetAttribute("PartitionValues", StringValue(peers->second));
+    }
     producerHelper.Install(leafNode);
     // Optional: set producer payload attributes here if desired
   }
 
-  // Configure each aggregator and the root with their children list
-  for (auto& kv : childrenMap) {
-    const std::string& parent = kv.first;
-    const std::vector<std::string>& childList = kv.second;
-    if (parent == rootName) {
-      if (rootApp) {
-        std::cout << "DEBUG: Setting children for Root [" << parent << "]: ";
-        for (const auto& child : childList) {
-          std::cout << child << " ";
-        }                           
-        std::cout << std::endl;
-        rootApp->SetChildren(childList);
-        rootApp->SetCongestionControl(ccAlgorithm);
-      }
-    } else {
-      if (aggAppMap.find(parent) != aggAppMap.end()) {
-        std::cout << "DEBUG: Setting children for Aggregator [" << parent << "]: ";
-        for (const auto& child : childList) {
-          std::cout << child << " ";
-        }
-        std::cout << std::endl;
-        aggAppMap[parent]->SetChildren(childList);
-      }
-    }
-  }
-
   // ***** Revised Section: Only add global origin prefixes for producers (leaf nodes) *****
-  for (const std::string& nodeName : leaves) {
+  for (const std::string& nodeName : leafNodes) {
     Ptr<Node> node = Names::Find<Node>(nodeName);
     if (node != nullptr) {
       globalRouting.AddOrigins("/" + nodeName, node);
     }
   }
 
-  // Add aggregator prefixes (every parent except the root)
-  for (auto& kv : childrenMap) {
-    const std::string& parent = kv.first;
-    if (parent != rootName) {
-      Ptr<Node> parentNode = Names::Find<Node>(parent);
-      if (parentNode != nullptr) {
-        globalRouting.AddOrigins("/" + parent, parentNode);
-      }
+  // Add aggregator prefixes (every parent except the roots)
+  for (const std::string& parent : aggregatorNodes) {
+    Ptr<Node> parentNode = Names::Find<Node>(parent);
+    if (parentNode != nullptr) {
+      globalRouting.AddOrigins("/" + parent, parentNode);
     }
   }
 
@@ -247,6 +347,7 @@ int main(int argc, char* argv[]) {
   globalRouting.CalculateRoutes();
 
   // After adding routes, print FIB entries for debugging
+  Ptr<Node> rootNode = rootNodes.front();
   Simulator::Schedule(MilliSeconds(100), [rootNode]() {
     std::cout << "DEBUG: Printing FIB entries on Root after delay:" << std::endl;
     PrintFib(rootNode, std::cout);
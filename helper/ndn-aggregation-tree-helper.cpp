@@ -0,0 +1,572 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2025  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-aggregation-tree-helper.hpp"
+
+#include "ns3/ndnSIM/model/ndn-global-router.hpp"
+#include "ns3/ndnSIM/NFD/daemon/face/face.hpp"
+
+#include "ns3/log.h"
+#include "ns3/names.h"
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <queue>
+#include <sstream>
+
+NS_LOG_COMPONENT_DEFINE("ndn.AggregationTreeHelper");
+
+namespace ns3 {
+namespace ndn {
+
+namespace {
+
+std::string
+NodeName(uint32_t id)
+{
+  std::string name = Names::FindName(NodeList::GetNode(id));
+  if (name.empty()) {
+    NS_FATAL_ERROR("Node " << id << " is part of the aggregation tree but has no name");
+  }
+  return name;
+}
+
+} // namespace
+
+AggregationTreeHelper::AggregationTreeHelper()
+  : m_maxFanIn(0)
+  , m_maxLinkFlows(0)
+  , m_jobId(0)
+  , m_jobWeight(1.0)
+  , m_maxLinkLoad(0)
+{
+}
+
+void
+AggregationTreeHelper::SetMaxFanIn(uint32_t maxFanIn)
+{
+  m_maxFanIn = maxFanIn;
+}
+
+void
+AggregationTreeHelper::SetMaxLinkFlows(uint32_t maxLinkFlows)
+{
+  m_maxLinkFlows = maxLinkFlows;
+}
+
+void
+AggregationTreeHelper::SetAggregatorCandidates(const NodeContainer& nodes)
+{
+  m_candidates.clear();
+  for (auto node = nodes.Begin(); node != nodes.End(); ++node) {
+    m_candidates.insert((*node)->GetId());
+  }
+}
+
+void
+AggregationTreeHelper::ComputeShortestPathTree(Ptr<Node> root)
+{
+  NS_ASSERT_MSG(root->GetObject<GlobalRouter>() != nullptr,
+                "GlobalRouter must be installed (GlobalRoutingHelper::Install*)");
+
+  uint32_t nNodes = NodeList::GetNNodes();
+  m_sptParent.assign(nNodes, -1);
+  m_sptDepth.assign(nNodes, 0);
+  std::vector<uint64_t> distances(nNodes, std::numeric_limits<uint64_t>::max());
+
+  // Dijkstra with face metrics as link costs, as GlobalRoutingHelper::CalculateRoutes does
+  typedef std::pair<uint64_t, uint32_t> QueueEntry;
+  std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+  distances[root->GetId()] = 0;
+  queue.push({0, root->GetId()});
+  while (!queue.empty()) {
+    QueueEntry top = queue.top();
+    queue.pop();
+    uint32_t node = top.second;
+    if (top.first > distances[node]) {
+      continue;
+    }
+    Ptr<GlobalRouter> router = NodeList::GetNode(node)->GetObject<GlobalRouter>();
+    if (router == nullptr) {
+      continue;
+    }
+    for (const auto& incidency : router->GetIncidencies()) {
+      const shared_ptr<Face>& face = std::get<1>(incidency);
+      uint32_t neighbor = std::get<2>(incidency)->GetObject<Node>()->GetId();
+      uint64_t distance = top.first + (face != nullptr ? face->getMetric() : 1);
+      if (distance < distances[neighbor]) {
+        distances[neighbor] = distance;
+        m_sptParent[neighbor] = static_cast<int32_t>(node);
+        m_sptDepth[neighbor] = m_sptDepth[node] + 1;
+        queue.push({distance, neighbor});
+      }
+    }
+  }
+}
+
+std::vector<AggregationTreeHelper::LinkId>
+AggregationTreeHelper::PathLinks(uint32_t a, uint32_t b) const
+{
+  // Both ends hang off the shortest-path tree: climb from the deeper one until they meet
+  std::vector<LinkId> links;
+  while (a != b) {
+    uint32_t& lower = m_sptDepth[a] >= m_sptDepth[b] ? a : b;
+    uint32_t parent = static_cast<uint32_t>(m_sptParent[lower]);
+    links.push_back({std::min(lower, parent), std::max(lower, parent)});
+    lower = parent;
+  }
+  return links;
+}
+
+void
+AggregationTreeHelper::AddFlow(uint32_t child, uint32_t parent, int delta)
+{
+  for (const LinkId& link : PathLinks(child, parent)) {
+    m_linkFlows[link] += delta;
+  }
+}
+
+bool
+AggregationTreeHelper::FitsLinks(uint32_t child, uint32_t parent) const
+{
+  if (m_maxLinkFlows == 0) {
+    return true;
+  }
+  for (const LinkId& link : PathLinks(child, parent)) {
+    auto flows = m_linkFlows.find(link);
+    if (flows != m_linkFlows.end() && flows->second >= m_maxLinkFlows) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool
+AggregationTreeHelper::EnforceFanIn(uint32_t node)
+{
+  std::vector<uint32_t>& children = m_aggChildren[node];
+  while (m_maxFanIn != 0 && children.size() > m_maxFanIn) {
+    // Sibling aggregators with room take the excess children, least loaded first
+    std::vector<uint32_t> targets;
+    for (uint32_t child : children) {
+      auto grandChildren = m_aggChildren.find(child);
+      if (grandChildren != m_aggChildren.end() && grandChildren->second.size() < m_maxFanIn) {
+        targets.push_back(child);
+      }
+    }
+    std::sort(targets.begin(), targets.end(), [this] (uint32_t a, uint32_t b) {
+      return std::make_pair(m_aggChildren[a].size(), a) < std::make_pair(m_aggChildren[b].size(), b);
+    });
+
+    bool moved = false;
+    for (auto target = targets.begin(); target != targets.end() && !moved; ++target) {
+      for (size_t i = children.size(); i-- > 0;) {
+        uint32_t child = children[i];
+        if (child == *target) {
+          continue;
+        }
+        AddFlow(child, node, -1);
+        if (FitsLinks(child, *target)) {
+          NS_LOG_DEBUG("Fan-in of " << NodeName(node) << ": " << NodeName(child) << " moves under "
+                       << NodeName(*target));
+          AddFlow(child, *target, 1);
+          m_aggChildren[*target].push_back(child);
+          children.erase(children.begin() + i);
+          moved = true;
+          break;
+        }
+        AddFlow(child, node, 1);
+      }
+    }
+    if (!moved && !InsertIntermediate(node)) {
+      NS_LOG_WARN("Cannot bring the fan-in of " << NodeName(node) << " (" << children.size()
+                  << ") down to " << m_maxFanIn);
+      return false;
+    }
+  }
+  return true;
+}
+
+bool
+AggregationTreeHelper::InsertIntermediate(uint32_t node)
+{
+  std::vector<uint32_t>& children = m_aggChildren[node];
+  std::set<uint32_t> inTree;
+  for (const auto& parent : m_aggChildren) {
+    inTree.insert(parent.first);
+    inTree.insert(parent.second.begin(), parent.second.end());
+  }
+
+  // Nodes outside the tree (relays included) that may aggregate, nearest to node first
+  std::vector<std::pair<size_t, uint32_t>> spare;
+  for (uint32_t id = 0; id < m_sptParent.size(); ++id) {
+    bool isCandidate = m_candidates.empty() || m_candidates.count(id) > 0;
+    if (isCandidate && m_sptParent[id] >= 0 && inTree.count(id) == 0) {
+      spare.push_back({PathLinks(id, node).size(), id});
+    }
+  }
+  std::sort(spare.begin(), spare.end());
+
+  // Taking k children and reporting to node brings its fan-in down by k - 1
+  size_t wanted = std::min<size_t>(m_maxFanIn, children.size() - m_maxFanIn + 1);
+  for (const auto& candidate : spare) {
+    uint32_t intermediate = candidate.second;
+    if (!FitsLinks(intermediate, node)) {
+      continue;
+    }
+    AddFlow(intermediate, node, 1);
+    std::vector<uint32_t>& taken = m_aggChildren[intermediate];
+    for (size_t i = children.size(); i-- > 0 && taken.size() < wanted;) {
+      uint32_t child = children[i];
+      AddFlow(child, node, -1);
+      if (FitsLinks(child, intermediate)) {
+        AddFlow(child, intermediate, 1);
+        taken.push_back(child);
+        children.erase(children.begin() + i);
+      }
+      else {
+        AddFlow(child, node, 1);
+      }
+    }
+
+    if (taken.size() >= 2) {
+      NS_LOG_DEBUG("Fan-in of " << NodeName(node) << ": " << NodeName(intermediate)
+                   << " aggregates " << taken.size() << " of its children");
+      children.push_back(intermediate);
+      return true;
+    }
+
+    // A single child would not lower the fan-in: undo
+    for (uint32_t child : taken) {
+      AddFlow(child, intermediate, -1);
+      AddFlow(child, node, 1);
+      children.push_back(child);
+    }
+    AddFlow(intermediate, node, -1);
+    m_aggChildren.erase(intermediate);
+  }
+  return false;
+}
+
+bool
+AggregationTreeHelper::Build(Ptr<Node> root, const NodeContainer& producers)
+{
+  m_children.clear();
+  m_aggChildren.clear();
+  m_linkFlows.clear();
+  m_maxLinkLoad = 0;
+
+  ComputeShortestPathTree(root);
+  uint32_t rootId = root->GetId();
+  uint32_t nNodes = NodeList::GetNNodes();
+
+  // Union of the shortest paths from the root to every producer
+  std::vector<bool> isProducer(nNodes, false);
+  std::vector<bool> inTree(nNodes, false);
+  std::vector<std::vector<uint32_t>> sptChildren(nNodes);
+  inTree[rootId] = true;
+  for (auto producer = producers.Begin(); producer != producers.End(); ++producer) {
+    uint32_t id = (*producer)->GetId();
+    if (id == rootId) {
+      NS_FATAL_ERROR("The root " << NodeName(id) << " cannot also be a producer");
+    }
+    if (m_sptParent[id] < 0) {
+      NS_FATAL_ERROR("Producer " << NodeName(id) << " is not reachable from the root");
+    }
+    isProducer[id] = true;
+    for (uint32_t node = id; !inTree[node]; node = static_cast<uint32_t>(m_sptParent[node])) {
+      inTree[node] = true;
+      sptChildren[m_sptParent[node]].push_back(node);
+    }
+  }
+
+  std::vector<uint32_t> order{rootId}; // breadth-first
+  for (size_t i = 0; i < order.size(); ++i) {
+    std::sort(sptChildren[order[i]].begin(), sptChildren[order[i]].end());
+    order.insert(order.end(), sptChildren[order[i]].begin(), sptChildren[order[i]].end());
+  }
+
+  // Bottom-up: 'exported' is what a subtree hands to the node above it, i.e. the subtree's
+  // aggregator, or the producers and aggregators under a node that does not aggregate
+  std::vector<std::vector<uint32_t>> exported(nNodes);
+  for (auto it = order.rbegin(); it != order.rend(); ++it) {
+    uint32_t node = *it;
+    std::vector<uint32_t> below;
+    for (uint32_t child : sptChildren[node]) {
+      below.insert(below.end(), exported[child].begin(), exported[child].end());
+      exported[child].clear();
+    }
+
+    bool isCandidate = m_candidates.empty() || m_candidates.count(node) > 0;
+    if (node == rootId) {
+      m_aggChildren[node] = std::move(below);
+    }
+    else if (isProducer[node]) {
+      // Producers relay the subtrees behind them but do not aggregate
+      below.push_back(node);
+      exported[node] = std::move(below);
+    }
+    else if (below.size() >= 2 && isCandidate) {
+      m_aggChildren[node] = std::move(below);
+      exported[node] = {node};
+    }
+    else {
+      exported[node] = std::move(below);
+    }
+  }
+
+  for (const auto& parent : m_aggChildren) {
+    for (uint32_t child : parent.second) {
+      AddFlow(child, parent.first, 1);
+    }
+  }
+
+  bool ok = true;
+  for (auto it = order.rbegin(); it != order.rend(); ++it) {
+    if (m_aggChildren.count(*it) > 0 && !EnforceFanIn(*it)) {
+      ok = false;
+    }
+  }
+
+  for (const auto& link : m_linkFlows) {
+    m_maxLinkLoad = std::max(m_maxLinkLoad, link.second);
+    if (m_maxLinkFlows != 0 && link.second > m_maxLinkFlows) {
+      NS_LOG_WARN("Link " << NodeName(link.first.first) << " - " << NodeName(link.first.second)
+                  << " carries " << link.second << " tree flows (limit " << m_maxLinkFlows << ")");
+      ok = false;
+    }
+  }
+
+  m_root = NodeName(rootId);
+  for (const auto& parent : m_aggChildren) {
+    std::vector<std::string>& names = m_children[NodeName(parent.first)];
+    for (uint32_t child : parent.second) {
+      names.push_back(NodeName(child));
+    }
+  }
+  NS_LOG_INFO("Aggregation tree rooted at " << m_root << ": " << m_aggChildren.size() - 1
+              << " aggregators, " << GetProducers().size() << " producers, busiest link carries "
+              << m_maxLinkLoad << " flows");
+  return ok;
+}
+
+void
+AggregationTreeHelper::LoadTree(const std::vector<std::string>& lines)
+{
+  m_children.clear();
+  m_root.clear();
+  m_maxLinkLoad = 0;
+
+  std::set<std::string> allChildren;
+  std::vector<std::string> parents;
+  for (const std::string& line : lines) {
+    std::istringstream ss(line);
+    std::string parent;
+    ss >> parent;
+    std::vector<std::string>& children = m_children[parent];
+    std::string child;
+    while (ss >> child) {
+      children.push_back(child);
+      allChildren.insert(child);
+    }
+    parents.push_back(parent);
+  }
+
+  for (const std::string& parent : parents) {
+    if (allChildren.count(parent) == 0) {
+      if (!m_root.empty() && m_root != parent) {
+        NS_FATAL_ERROR("Aggregation tree of job " << m_jobId << " has more than one root: " << m_root
+                       << ", " << parent);
+      }
+      m_root = parent;
+    }
+  }
+  if (!parents.empty() && m_root.empty()) {
+    NS_FATAL_ERROR("Aggregation tree of job " << m_jobId << " has no root (every parent is also a child)");
+  }
+}
+
+std::vector<AggregationTreeHelper>
+AggregationTreeHelper::ReadJobs(std::istream& is)
+{
+  struct Section
+  {
+    uint32_t job;
+    double weight;
+    std::vector<std::string> lines;
+  };
+  std::vector<Section> sections;
+
+  std::string line;
+  while (std::getline(is, line)) {
+    std::istringstream ss(line);
+    std::string parent;
+    if (!(ss >> parent) || parent[0] == '#') {
+      continue;
+    }
+    if (parent == "job") {
+      Section section{0, 1.0, {}};
+      if (!(ss >> section.job)) {
+        NS_FATAL_ERROR("Malformed job line in aggregation tree file: '" << line << "'");
+      }
+      if (!(ss >> section.weight)) {
+        section.weight = 1.0;
+      }
+      else if (section.weight <= 0) {
+        NS_FATAL_ERROR("Job " << section.job << " needs a positive weight: '" << line << "'");
+      }
+      for (const Section& other : sections) {
+        if (other.job == section.job) {
+          NS_FATAL_ERROR("Aggregation tree file defines job " << section.job << " twice");
+        }
+      }
+      sections.push_back(std::move(section));
+      continue;
+    }
+    if (sections.empty()) {
+      sections.push_back(Section{0, 1.0, {}}); // tree lines before any job line: job 0
+    }
+    sections.back().lines.push_back(line);
+  }
+
+  std::vector<AggregationTreeHelper> trees(sections.size());
+  for (size_t i = 0; i < sections.size(); ++i) {
+    trees[i].m_jobId = sections[i].job;
+    trees[i].m_jobWeight = sections[i].weight;
+    trees[i].LoadTree(sections[i].lines);
+  }
+  return trees;
+}
+
+std::vector<AggregationTreeHelper>
+AggregationTreeHelper::ReadJobs(const std::string& fileName)
+{
+  std::ifstream is(fileName);
+  if (!is.is_open()) {
+    NS_FATAL_ERROR("Cannot open aggregation tree file " << fileName);
+  }
+  return ReadJobs(is);
+}
+
+void
+AggregationTreeHelper::Read(std::istream& is)
+{
+  std::vector<AggregationTreeHelper> trees = ReadJobs(is);
+  if (trees.size() > 1) {
+    NS_FATAL_ERROR("Aggregation tree file holds " << trees.size() << " jobs, use ReadJobs()");
+  }
+  AggregationTreeHelper tree;
+  if (!trees.empty()) {
+    tree = trees.front();
+  }
+  m_jobId = tree.m_jobId;
+  m_jobWeight = tree.m_jobWeight;
+  m_root = tree.m_root;
+  m_children = tree.m_children;
+  m_maxLinkLoad = 0;
+}
+
+void
+AggregationTreeHelper::Read(const std::string& fileName)
+{
+  std::ifstream is(fileName);
+  if (!is.is_open()) {
+    NS_FATAL_ERROR("Cannot open aggregation tree file " << fileName);
+  }
+  Read(is);
+}
+
+void
+AggregationTreeHelper::Write(std::ostream& os) const
+{
+  os << "# Format: ParentNode Child1 Child2 ...\n";
+  if (m_jobId != 0 || m_jobWeight != 1.0) {
+    os << "job " << m_jobId;
+    if (m_jobWeight != 1.0) {
+      os << " " << m_jobWeight;
+    }
+    os << "\n";
+  }
+  if (m_root.empty()) {
+    return;
+  }
+  std::vector<std::string> order{m_root};
+  for (size_t i = 0; i < order.size(); ++i) {
+    const std::vector<std::string>& children = GetChildren(order[i]);
+    if (children.empty()) {
+      continue;
+    }
+    os << order[i];
+    for (const std::string& child : children) {
+      os << " " << child;
+    }
+    os << "\n";
+    order.insert(order.end(), children.begin(), children.end());
+  }
+}
+
+void
+AggregationTreeHelper::Write(const std::string& fileName) const
+{
+  std::ofstream os(fileName);
+  if (!os.is_open()) {
+    NS_FATAL_ERROR("Cannot create aggregation tree file " << fileName);
+  }
+  Write(os);
+}
+
+const std::vector<std::string>&
+AggregationTreeHelper::GetChildren(const std::string& node) const
+{
+  static const std::vector<std::string> none;
+  auto it = m_children.find(node);
+  return it != m_children.end() ? it->second : none;
+}
+
+std::vector<std::string>
+AggregationTreeHelper::GetAggregators() const
+{
+  std::vector<std::string> aggregators;
+  for (const auto& parent : m_children) {
+    if (parent.first != m_root) {
+      aggregators.push_back(parent.first);
+    }
+  }
+  return aggregators;
+}
+
+std::vector<std::string>
+AggregationTreeHelper::GetProducers() const
+{
+  std::set<std::string> producers;
+  for (const auto& parent : m_children) {
+    for (const std::string& child : parent.second) {
+      if (m_children.count(child) == 0) {
+        producers.insert(child);
+      }
+    }
+  }
+  return std::vector<std::string>(producers.begin(), producers.end());
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,240 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2025  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_HELPER_NDN_AGGREGATION_TREE_HELPER_HPP
+#define NDNSIM_HELPER_NDN_AGGREGATION_TREE_HELPER_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/node-container.h"
+#include "ns3/ptr.h"
+
+#include <iosfwd>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Builds or loads an in-network aggregation tree (root, aggregators, producers); the
+ *        caller installs the aggregation apps on the nodes it lists
+ *
+ * Build() derives the tree from the topology: it computes the shortest-path tree from the
+ * root over the GlobalRouter graph (link metrics as costs, like GlobalRoutingHelper), keeps
+ * the paths that lead to producers, and makes every branching node of those paths an
+ * aggregator of the subtrees below it.  Nodes that only relay a single subtree are left out
+ * of the tree, so each aggregation edge follows the route its Interests take.
+ *
+ * Two constraints shape the result:
+ *  - the maximum fan-in of an aggregator: excess children are handed to sibling aggregators
+ *    that still have room, starting with the least loaded one; when none has (e.g. a switch
+ *    whose children are all producers), the nearest candidate node that is not in the tree
+ *    yet becomes an intermediate aggregator of some of them;
+ *  - the maximum number of tree flows (child-to-parent streams of a round) crossing a link:
+ *    a hand-over is only made if it keeps every link within the limit.
+ *
+ * Trees can also be loaded from and saved to the "Parent Child1 Child2 ..." text format of
+ * the aggregation examples, so that a generated tree can be reused or edited.  In that format
+ * a "job <id> [weight]" line starts the tree of another aggregation job (ReadJobs()).  Nodes
+ * are identified by their ns3::Names, and every node serves the prefix "/<name>".
+ *
+ * Example:
+ *
+ *     AnnotatedTopologyReader reader;
+ *     ...
+ *     GlobalRoutingHelper routing;
+ *     routing.InstallAll();
+ *
+ *     AggregationTreeHelper tree;
+ *     tree.SetMaxFanIn(16);
+ *     tree.Build(Names::Find<Node>("Root"), producers);
+ *     for (const auto& parent : tree.GetTree()) {
+ *       ... // root app on tree.GetRoot(), aggregator apps on the other parents
+ *     }
+ *     ... // producer apps and routing origins on tree.GetProducers()
+ */
+class AggregationTreeHelper
+{
+public:
+  AggregationTreeHelper();
+
+  /**
+   * @brief Limit the number of children of any aggregator or of the root (0 for no limit)
+   */
+  void
+  SetMaxFanIn(uint32_t maxFanIn);
+
+  /**
+   * @brief Limit the number of tree flows crossing any one link (0 for no limit)
+   */
+  void
+  SetMaxLinkFlows(uint32_t maxLinkFlows);
+
+  /**
+   * @brief Only let @p nodes aggregate (by default every node that is not a producer may)
+   */
+  void
+  SetAggregatorCandidates(const NodeContainer& nodes);
+
+  /**
+   * @brief Build the tree connecting @p producers to @p root
+   *
+   * GlobalRouter must be installed (GlobalRoutingHelper::Install*) on the nodes involved.
+   *
+   * @returns false if the fan-in or link-flow limit could not be met everywhere (the tree
+   *          is built anyway, with the violations logged)
+   */
+  bool
+  Build(Ptr<Node> root, const NodeContainer& producers);
+
+  /**
+   * @brief Load a tree of "Parent Child1 Child2 ..." lines ('#' starts a comment line)
+   *
+   * The root is the parent that is nobody's child.  The file may start the tree with a
+   * "job <id> [weight]" line; a file holding several jobs is an error (see ReadJobs()).
+   */
+  void
+  Read(std::istream& is);
+
+  void
+  Read(const std::string& fileName);
+
+  /**
+   * @brief Load every job tree of a file: a "job <id> [weight]" line starts the tree of job
+   *        <id> (weight 1 by default), lines before the first such line form the tree of job 0
+   */
+  static std::vector<AggregationTreeHelper>
+  ReadJobs(std::istream& is);
+
+  static std::vector<AggregationTreeHelper>
+  ReadJobs(const std::string& fileName);
+
+  /**
+   * @brief Save the tree in the format accepted by Read(), parents in breadth-first order
+   *
+   * The tree of a job other than 0 (or with a weight) starts with its "job" line, so the trees
+   * of several jobs written one after the other can be read back with ReadJobs().
+   */
+  void
+  Write(std::ostream& os) const;
+
+  void
+  Write(const std::string& fileName) const;
+
+  const std::string&
+  GetRoot() const
+  {
+    return m_root;
+  }
+
+  /**
+   * @brief Aggregation job of a tree loaded by Read() or ReadJobs() (0 by default)
+   */
+  uint32_t
+  GetJobId() const
+  {
+    return m_jobId;
+  }
+
+  double
+  GetJobWeight() const
+  {
+    return m_jobWeight;
+  }
+
+  /**
+   * @brief Children of a root or aggregator node (empty for producers and unknown nodes)
+   */
+  const std::vector<std::string>&
+  GetChildren(const std::string& node) const;
+
+  /**
+   * @brief Parent -> children lists of the root and the aggregators
+   */
+  const std::map<std::string, std::vector<std::string>>&
+  GetTree() const
+  {
+    return m_children;
+  }
+
+  std::vector<std::string>
+  GetAggregators() const;
+
+  std::vector<std::string>
+  GetProducers() const;
+
+  /**
+   * @brief Number of tree flows crossing the busiest link (only known after Build())
+   */
+  uint32_t
+  GetMaxLinkLoad() const
+  {
+    return m_maxLinkLoad;
+  }
+
+private:
+  typedef std::pair<uint32_t, uint32_t> LinkId; // node ids, smaller first
+
+  void
+  LoadTree(const std::vector<std::string>& lines);
+
+  void
+  ComputeShortestPathTree(Ptr<Node> root);
+
+  std::vector<LinkId>
+  PathLinks(uint32_t a, uint32_t b) const;
+
+  void
+  AddFlow(uint32_t child, uint32_t parent, int delta);
+
+  bool
+  FitsLinks(uint32_t child, uint32_t parent) const;
+
+  bool
+  EnforceFanIn(uint32_t node);
+
+  bool
+  InsertIntermediate(uint32_t node);
+
+private:
+  uint32_t m_maxFanIn;
+  uint32_t m_maxLinkFlows;
+  std::set<uint32_t> m_candidates; // empty: any non-producer
+
+  uint32_t m_jobId;
+  double m_jobWeight;
+  std::string m_root;
+  std::map<std::string, std::vector<std::string>> m_children;
+
+  // Build() state, by node id
+  std::vector<int32_t> m_sptParent; // -1: root or unreachable
+  std::vector<uint32_t> m_sptDepth;
+  std::map<uint32_t, std::vector<uint32_t>> m_aggChildren;
+  std::map<LinkId, uint32_t> m_linkFlows;
+  uint32_t m_maxLinkLoad;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_HELPER_NDN_AGGREGATION_TREE_HELPER_HPP
@@ -0,0 +1,395 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2025  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-global-routing-graph.hpp"
+
+#include "model/ndn-global-router.hpp"
+
+#include "ns3/assert.h"
+#include "ns3/channel-list.h"
+#include "ns3/node-list.h"
+
+#include <boost/graph/dijkstra_shortest_paths.hpp>
+#include <boost/property_map/function_property_map.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+
+namespace ns3 {
+namespace ndn {
+
+const uint32_t GlobalRoutingGraph::NO_FACE = std::numeric_limits<uint32_t>::max();
+const uint32_t GlobalRoutingGraph::NO_VERTEX = std::numeric_limits<uint32_t>::max();
+const uint32_t GlobalRoutingGraph::NO_EDGE = std::numeric_limits<uint32_t>::max();
+const uint32_t GlobalRoutingGraph::METRIC_INF = std::numeric_limits<uint16_t>::max();
+// value std::numeric_limits<uint16_t>::max () MUST NOT be used (reserved)
+const uint16_t GlobalRoutingGraph::METRIC_DISABLED = std::numeric_limits<uint16_t>::max() - 1;
+
+namespace {
+
+// Records the parent edge and the first hop of every improved path: the first hop is the face
+// of the edge leaving the source, or the first hop of the path to the edge's tail
+class TreeRecorder : public boost::default_dijkstra_visitor {
+public:
+  TreeRecorder(uint32_t source, std::vector<uint32_t>& parents, std::vector<uint32_t>& firstHops)
+    : m_source(source)
+    , m_parents(parents)
+    , m_firstHops(firstHops)
+  {
+  }
+
+  template<class Edge, class Graph>
+  void
+  edge_relaxed(const Edge& edge, const Graph& graph)
+  {
+    uint32_t tail = boost::source(edge, graph);
+    uint32_t head = boost::target(edge, graph);
+    m_parents[head] = boost::get(boost::edge_index, graph, edge);
+    m_firstHops[head] = tail == m_source ? graph[edge].face : m_firstHops[tail];
+  }
+
+private:
+  uint32_t m_source;
+  std::vector<uint32_t>& m_parents;
+  std::vector<uint32_t>& m_firstHops;
+};
+
+// (distance, vertex), smallest distance first
+typedef std::pair<uint32_t, uint32_t> QueueEntry;
+typedef std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>>
+  Queue;
+
+} // namespace
+
+GlobalRoutingGraph::GlobalRoutingGraph()
+{
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    Ptr<GlobalRouter> gr = (*node)->GetObject<GlobalRouter>();
+    if (gr != nullptr) {
+      m_vertices[PeekPointer(gr)] = m_routers.size();
+      m_routers.push_back(gr);
+    }
+  }
+  for (ChannelList::Iterator channel = ChannelList::Begin(); channel != ChannelList::End();
+       channel++) {
+    Ptr<GlobalRouter> gr = (*channel)->GetObject<GlobalRouter>();
+    if (gr != nullptr) {
+      m_vertices[PeekPointer(gr)] = m_routers.size();
+      m_routers.push_back(gr);
+    }
+  }
+
+  std::vector<std::pair<uint32_t, uint32_t>> edges;
+  for (uint32_t vertex = 0; vertex < m_routers.size(); ++vertex) {
+    if (!m_routers[vertex]->GetLocalPrefixes().empty()) {
+      m_origins.push_back(vertex);
+    }
+
+    for (const auto& incidency : m_routers[vertex]->GetIncidencies()) {
+      uint32_t target = GetVertex(std::get<2>(incidency));
+      NS_ASSERT_MSG(target != NO_VERTEX,
+                    "GlobalRouter is attached to neither a node nor a channel");
+
+      const shared_ptr<Face>& face = std::get<1>(incidency);
+      Edge edge{NO_FACE, 0};
+      if (face != nullptr) {
+        edge.metric = static_cast<uint16_t>(face->getMetric());
+        auto inserted = m_faceIndices.emplace(face.get(), m_faces.size());
+        if (inserted.second) {
+          m_faces.push_back(face);
+          m_faceMetrics.push_back(edge.metric);
+        }
+        edge.face = inserted.first->second;
+      }
+      edges.emplace_back(vertex, target);
+      m_edges.push_back(edge);
+    }
+  }
+
+  m_csr = Csr(boost::edges_are_sorted, edges.begin(), edges.end(), m_edges.begin(),
+              m_routers.size());
+
+  m_edgeSources.reserve(edges.size());
+  m_edgeTargets.reserve(edges.size());
+  m_inEdgeOffsets.assign(m_routers.size() + 1, 0);
+  for (const auto& edge : edges) {
+    m_edgeSources.push_back(edge.first);
+    m_edgeTargets.push_back(edge.second);
+    ++m_inEdgeOffsets[edge.second + 1];
+  }
+  m_isEdgeUp.assign(edges.size(), true);
+
+  for (uint32_t vertex = 0; vertex < m_routers.size(); ++vertex) {
+    m_inEdgeOffsets[vertex + 1] += m_inEdgeOffsets[vertex];
+  }
+  m_inEdges.resize(edges.size());
+  std::vector<uint32_t> next(m_inEdgeOffsets.begin(), m_inEdgeOffsets.end() - 1);
+  for (uint32_t edge = 0; edge < edges.size(); ++edge) {
+    m_inEdges[next[m_edgeTargets[edge]]++] = edge;
+  }
+}
+
+uint32_t
+GlobalRoutingGraph::GetNVertices() const
+{
+  return m_routers.size();
+}
+
+Ptr<GlobalRouter>
+GlobalRoutingGraph::GetRouter(uint32_t vertex) const
+{
+  return m_routers[vertex];
+}
+
+uint32_t
+GlobalRoutingGraph::GetVertex(Ptr<GlobalRouter> router) const
+{
+  auto vertex = m_vertices.find(PeekPointer(router));
+  return vertex != m_vertices.end() ? vertex->second : NO_VERTEX;
+}
+
+const shared_ptr<Face>&
+GlobalRoutingGraph::GetFace(uint32_t face) const
+{
+  return m_faces[face];
+}
+
+uint32_t
+GlobalRoutingGraph::GetFaceIndex(const Face& face) const
+{
+  auto index = m_faceIndices.find(&face);
+  return index != m_faceIndices.end() ? index->second : NO_FACE;
+}
+
+std::pair<uint32_t, uint32_t>
+GlobalRoutingGraph::GetOutEdges(uint32_t vertex) const
+{
+  auto range = boost::out_edges(vertex, m_csr);
+  if (range.first == range.second) {
+    return {0, 0};
+  }
+  return {boost::get(boost::edge_index, m_csr, *range.first),
+          boost::get(boost::edge_index, m_csr, *range.first) + boost::out_degree(vertex, m_csr)};
+}
+
+uint32_t
+GlobalRoutingGraph::GetEdgeFace(uint32_t edge) const
+{
+  return m_edges[edge].face;
+}
+
+bool
+GlobalRoutingGraph::IsEdgeUp(uint32_t edge) const
+{
+  return m_isEdgeUp[edge];
+}
+
+void
+GlobalRoutingGraph::SetEdgeUp(uint32_t edge, bool isUp)
+{
+  m_isEdgeUp[edge] = isUp;
+}
+
+const std::vector<uint32_t>&
+GlobalRoutingGraph::GetOrigins() const
+{
+  return m_origins;
+}
+
+uint32_t
+GlobalRoutingGraph::GetWeight(uint32_t edge, uint32_t source, uint32_t enabledFace) const
+{
+  if (!m_isEdgeUp[edge]) {
+    return METRIC_INF; // never shortens a path
+  }
+  if (enabledFace != NO_FACE && m_edgeSources[edge] == source
+      && m_edges[edge].face != enabledFace) {
+    return METRIC_DISABLED;
+  }
+  return m_edges[edge].metric;
+}
+
+GlobalRoutingGraph::Tree
+GlobalRoutingGraph::ComputeTree(uint32_t source, uint32_t enabledFace) const
+{
+  auto weights = boost::make_function_property_map<Csr::edge_descriptor, uint32_t>(
+    [this, source, enabledFace] (const Csr::edge_descriptor& edge) {
+      return GetWeight(boost::get(boost::edge_index, m_csr, edge), source, enabledFace);
+    });
+
+  Tree tree;
+  tree.distance.resize(m_routers.size());
+  tree.parent.assign(m_routers.size(), NO_EDGE);
+  tree.firstHop.assign(m_routers.size(), NO_FACE);
+  boost::dijkstra_shortest_paths(m_csr, source,
+                                 boost::weight_map(weights)
+                                   .distance_map(boost::make_iterator_property_map(
+                                     tree.distance.begin(),
+                                     boost::get(boost::vertex_index, m_csr)))
+                                   .distance_inf(METRIC_INF)
+                                   .distance_zero(0u)
+                                   .distance_combine(std::plus<uint32_t>())
+                                   .visitor(TreeRecorder(source, tree.parent, tree.firstHop)));
+  return tree;
+}
+
+std::vector<GlobalRoutingGraph::Route>
+GlobalRoutingGraph::ComputeRoutes(uint32_t source, uint32_t enabledFace) const
+{
+  if (enabledFace != NO_FACE && m_faceMetrics[enabledFace] == METRIC_DISABLED) {
+    return {};
+  }
+
+  std::vector<Route> routes = GetRoutes(source, ComputeTree(source, enabledFace));
+  if (enabledFace != NO_FACE) {
+    routes.erase(std::remove_if(routes.begin(), routes.end(),
+                                [enabledFace] (const Route& route) {
+                                  return route.face != enabledFace;
+                                }),
+                 routes.end());
+  }
+  return routes;
+}
+
+std::vector<GlobalRoutingGraph::Route>
+GlobalRoutingGraph::GetRoutes(uint32_t source, const Tree& tree) const
+{
+  std::vector<Route> routes;
+  for (uint32_t origin : m_origins) {
+    if (origin == source || tree.distance[origin] == METRIC_INF
+        || tree.firstHop[origin] == NO_FACE) {
+      continue;
+    }
+    routes.push_back({origin, tree.firstHop[origin], tree.distance[origin]});
+  }
+  return routes;
+}
+
+std::vector<GlobalRoutingGraph::Change>
+GlobalRoutingGraph::UpdateTree(uint32_t source, Tree& tree, const std::vector<uint32_t>& downEdges,
+                               const std::vector<uint32_t>& upEdges) const
+{
+  std::vector<Change> changes;
+  std::vector<bool> isChanged(m_routers.size(), false);
+  auto update = [&] (uint32_t vertex, uint32_t distance, uint32_t parent) {
+    if (!isChanged[vertex]) {
+      isChanged[vertex] = true;
+      changes.push_back({vertex, tree.distance[vertex], tree.firstHop[vertex]});
+    }
+    tree.distance[vertex] = distance;
+    tree.parent[vertex] = parent;
+    if (parent == NO_EDGE) {
+      tree.firstHop[vertex] = NO_FACE;
+    }
+    else {
+      uint32_t tail = m_edgeSources[parent];
+      tree.firstHop[vertex] = tail == source ? m_edges[parent].face : tree.firstHop[tail];
+    }
+  };
+
+  Queue queue;
+  auto relax = [&] (uint32_t edge, const std::vector<bool>* onlyTo) {
+    uint32_t head = m_edgeTargets[edge];
+    if (onlyTo != nullptr && !(*onlyTo)[head]) {
+      return;
+    }
+    uint32_t distance = tree.distance[m_edgeSources[edge]] + GetWeight(edge, source, NO_FACE);
+    if (distance < tree.distance[head]) {
+      update(head, distance, edge);
+      queue.push({distance, head});
+    }
+  };
+  auto search = [&] (const std::vector<bool>* onlyTo) {
+    while (!queue.empty()) {
+      QueueEntry top = queue.top();
+      queue.pop();
+      if (top.first > tree.distance[top.second]) {
+        continue; // stale entry
+      }
+      auto edges = GetOutEdges(top.second);
+      for (uint32_t edge = edges.first; edge < edges.second; ++edge) {
+        relax(edge, onlyTo);
+      }
+    }
+  };
+
+  // A failed edge matters only if it is in the tree: the paths to its head and all vertices
+  // below it are searched again, starting from the rest of the tree
+  std::vector<uint32_t> roots;
+  for (uint32_t edge : downEdges) {
+    if (tree.parent[m_edgeTargets[edge]] == edge) {
+      roots.push_back(m_edgeTargets[edge]);
+    }
+  }
+  if (!roots.empty()) {
+    std::vector<std::vector<uint32_t>> children(m_routers.size());
+    for (uint32_t vertex = 0; vertex < m_routers.size(); ++vertex) {
+      if (tree.parent[vertex] != NO_EDGE) {
+        children[m_edgeSources[tree.parent[vertex]]].push_back(vertex);
+      }
+    }
+
+    std::vector<bool> isDetached(m_routers.size(), false);
+    std::vector<uint32_t> detached = roots;
+    for (uint32_t root : roots) {
+      isDetached[root] = true;
+    }
+    for (size_t i = 0; i < detached.size(); ++i) {
+      for (uint32_t child : children[detached[i]]) {
+        if (!isDetached[child]) {
+          isDetached[child] = true;
+          detached.push_back(child);
+        }
+      }
+    }
+
+    for (uint32_t vertex : detached) {
+      update(vertex, METRIC_INF, NO_EDGE);
+    }
+    for (uint32_t vertex : detached) {
+      for (uint32_t i = m_inEdgeOffsets[vertex]; i < m_inEdgeOffsets[vertex + 1]; ++i) {
+        if (!isDetached[m_edgeSources[m_inEdges[i]]]) {
+          relax(m_inEdges[i], &isDetached);
+        }
+      }
+    }
+    search(&isDetached);
+  }
+
+  // A restored edge matters only if it shortens the path to its head
+  for (uint32_t edge : upEdges) {
+    if (tree.distance[m_edgeSources[edge]] != METRIC_INF) {
+      relax(edge, nullptr);
+    }
+  }
+  search(nullptr);
+
+  changes.erase(std::remove_if(changes.begin(), changes.end(),
+                               [&tree] (const Change& change) {
+                                 return change.distance == tree.distance[change.vertex]
+                                        && change.firstHop == tree.firstHop[change.vertex];
+                               }),
+                changes.end());
+  return changes;
+}
+
+} // namespace ndn
+} // namespace ns3
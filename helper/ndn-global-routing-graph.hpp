@@ -0,0 +1,226 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2025  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_GLOBAL_ROUTING_GRAPH_H
+#define NDN_GLOBAL_ROUTING_GRAPH_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/ptr.h"
+
+#include <boost/graph/compressed_sparse_row_graph.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+class GlobalRouter;
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Immutable snapshot of the GlobalRouter graph in compressed sparse row form
+ *
+ * Vertices are numbered as boost::NdnGlobalRouterGraph enumerates them (routers of nodes in
+ * NodeList order, then routers of multi-access channels), and out-edges keep the order of
+ * GlobalRouter::GetIncidencies(), so shortest path searches break ties exactly as the
+ * search over the live graph does.  Face metrics are copied when the snapshot is taken.
+ *
+ * Once constructed, the snapshot does not touch any ns-3 object from its const methods other
+ * than the accessors returning them, so ComputeTree(), ComputeRoutes() and UpdateTree() may run
+ * on several threads at once (but not concurrently with SetEdgeUp()).
+ */
+class GlobalRoutingGraph {
+public:
+  /**
+   * @brief Marks the edges from multi-access channels, which have no face
+   */
+  static const uint32_t NO_FACE;
+
+  static const uint32_t NO_VERTEX;
+
+  static const uint32_t NO_EDGE;
+
+  /**
+   * @brief Path metric considered unreachable (boost::WeightInf)
+   */
+  static const uint32_t METRIC_INF;
+
+  /**
+   * @brief Metric of the source faces disabled by ComputeRoutes()
+   */
+  static const uint16_t METRIC_DISABLED;
+
+  /**
+   * @brief Shortest path from a source to a destination vertex
+   */
+  struct Route {
+    uint32_t destination;
+    uint32_t face; ///< @brief first hop, a face of the source
+    uint32_t metric;
+  };
+
+  /**
+   * @brief Shortest path tree of a source
+   */
+  struct Tree {
+    std::vector<uint32_t> distance; ///< @brief METRIC_INF if unreachable
+    std::vector<uint32_t> parent;   ///< @brief edge leading to the vertex, or NO_EDGE
+    std::vector<uint32_t> firstHop; ///< @brief face of the source, or NO_FACE
+  };
+
+  /**
+   * @brief Value of a tree vertex before UpdateTree() changed it
+   */
+  struct Change {
+    uint32_t vertex;
+    uint32_t distance;
+    uint32_t firstHop;
+  };
+
+  /**
+   * @brief Take a snapshot of all installed GlobalRouter instances and their face metrics
+   */
+  GlobalRoutingGraph();
+
+  uint32_t
+  GetNVertices() const;
+
+  Ptr<GlobalRouter>
+  GetRouter(uint32_t vertex) const;
+
+  /**
+   * @return vertex of @p router, or NO_VERTEX if the router is not part of the snapshot
+   */
+  uint32_t
+  GetVertex(Ptr<GlobalRouter> router) const;
+
+  const shared_ptr<Face>&
+  GetFace(uint32_t face) const;
+
+  /**
+   * @return index of @p face, or NO_FACE if the face is not an edge of the graph
+   */
+  uint32_t
+  GetFaceIndex(const Face& face) const;
+
+  /**
+   * @brief Out-edges of @p vertex, in GlobalRouter::GetIncidencies() order
+   * @return [first, last) range of edge indices
+   */
+  std::pair<uint32_t, uint32_t>
+  GetOutEdges(uint32_t vertex) const;
+
+  /**
+   * @return face of @p edge, or NO_FACE for the edges from multi-access channels
+   */
+  uint32_t
+  GetEdgeFace(uint32_t edge) const;
+
+  bool
+  IsEdgeUp(uint32_t edge) const;
+
+  /**
+   * @brief Mark @p edge as failed (it is ignored by all searches) or restored
+   */
+  void
+  SetEdgeUp(uint32_t edge, bool isUp);
+
+  /**
+   * @brief Vertices that export at least one prefix
+   */
+  const std::vector<uint32_t>&
+  GetOrigins() const;
+
+  /**
+   * @brief Compute the shortest path tree of @p source
+   *
+   * If @p enabledFace is not NO_FACE, all other faces of the source are treated as having
+   * METRIC_DISABLED (see GlobalRoutingHelper::CalculateAllPossibleRoutes).
+   */
+  Tree
+  ComputeTree(uint32_t source, uint32_t enabledFace = NO_FACE) const;
+
+  /**
+   * @brief Compute shortest paths from @p source to all origins
+   *
+   * If @p enabledFace is not NO_FACE, only the routes through @p enabledFace are returned, as
+   * computed by ComputeTree(source, enabledFace).
+   *
+   * @return reachable origins, in vertex order
+   */
+  std::vector<Route>
+  ComputeRoutes(uint32_t source, uint32_t enabledFace = NO_FACE) const;
+
+  /**
+   * @brief Routes from @p source to all reachable origins in @p tree, in vertex order
+   */
+  std::vector<Route>
+  GetRoutes(uint32_t source, const Tree& tree) const;
+
+  /**
+   * @brief Bring @p tree of @p source up to date after @p downEdges failed and @p upEdges were
+   *        restored (see SetEdgeUp())
+   *
+   * Only the vertices whose path used a failed edge are searched again, and only from the
+   * vertices that keep their path; a restored edge starts a search from its head only if it
+   * shortens the path to it.  Equal-cost alternatives are not switched to, so the first hops
+   * may differ from those of a new ComputeTree() when there are ties.
+   *
+   * @return previous values of the vertices whose distance or first hop changed
+   */
+  std::vector<Change>
+  UpdateTree(uint32_t source, Tree& tree, const std::vector<uint32_t>& downEdges,
+             const std::vector<uint32_t>& upEdges) const;
+
+private:
+  struct Edge {
+    uint32_t face;
+    uint16_t metric;
+  };
+
+  typedef boost::compressed_sparse_row_graph<boost::directedS, boost::no_property, Edge,
+                                             boost::no_property, uint32_t, uint32_t> Csr;
+
+  uint32_t
+  GetWeight(uint32_t edge, uint32_t source, uint32_t enabledFace) const;
+
+private:
+  Csr m_csr;
+  // by edge index, as in m_csr
+  std::vector<Edge> m_edges;
+  std::vector<uint32_t> m_edgeSources;
+  std::vector<uint32_t> m_edgeTargets;
+  std::vector<bool> m_isEdgeUp;
+  // in-edges of vertex v: m_inEdges[m_inEdgeOffsets[v]] to m_inEdges[m_inEdgeOffsets[v + 1] - 1]
+  std::vector<uint32_t> m_inEdgeOffsets;
+  std::vector<uint32_t> m_inEdges;
+  std::vector<Ptr<GlobalRouter>> m_routers;
+  std::unordered_map<const GlobalRouter*, uint32_t> m_vertices;
+  std::vector<shared_ptr<Face>> m_faces;
+  std::vector<uint16_t> m_faceMetrics;
+  std::unordered_map<const Face*, uint32_t> m_faceIndices;
+  std::vector<uint32_t> m_origins;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_GLOBAL_ROUTING_GRAPH_H
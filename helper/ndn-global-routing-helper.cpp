@@ -25,6 +25,8 @@
 
 #include "ndn-global-routing-helper.hpp"
 
+#include "ndn-global-routing-graph.hpp"
+
 #include "model/ndn-l3-protocol.hpp"
 #include "helper/ndn-fib-helper.hpp"
 #include "model/ndn-net-device-transport.hpp"
@@ -46,23 +48,213 @@
 #include "ns3/node-list.h"
 #include "ns3/channel-list.h"
 #include "ns3/object-factory.h"
+#include "ns3/simulator.h"
 
 #include <boost/lexical_cast.hpp>
 #include <boost/foreach.hpp>
 #include <boost/concept/assert.hpp>
-#include <boost/graph/dijkstra_shortest_paths.hpp>
-
-#include <unordered_map>
 
-#include "boost-graph-ndn-global-routing-helper.hpp"
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <system_error>
+#include <thread>
+#include <vector>
 
 #include <math.h>
 
+#ifdef NS3_MPI
+#include "ns3/mpi-interface.h"
+#endif
+
 NS_LOG_COMPONENT_DEFINE("ndn.GlobalRoutingHelper");
 
 namespace ns3 {
 namespace ndn {
 
+// With MPI, each rank only simulates (and thus only needs FIB entries on) its own nodes; every
+// rank still holds the whole topology, so the shortest paths are computed on the full graph
+static bool
+isSimulatedLocally(Ptr<Node> node)
+{
+#ifdef NS3_MPI
+  if (MpiInterface::IsEnabled() && node->GetSystemId() != MpiInterface::GetSystemId()) {
+    return false;
+  }
+#endif
+  return true;
+}
+
+uint32_t GlobalRoutingHelper::s_nThreads = 0;
+bool GlobalRoutingHelper::s_isIncremental = false;
+
+namespace {
+
+// Shortest path trees of the last CalculateRoutes(), with incremental updates enabled
+struct IncrementalRoutes {
+  std::unique_ptr<GlobalRoutingGraph> graph;
+  std::vector<std::pair<Ptr<Node>, uint32_t>> sources; // (node, vertex)
+  std::vector<GlobalRoutingGraph::Tree> trees;         // by source
+  std::map<Name, std::vector<uint32_t>> prefixOrigins; // in vertex order
+};
+
+} // namespace
+
+static std::unique_ptr<IncrementalRoutes> s_incrementalRoutes;
+
+static void
+clearIncrementalRoutes()
+{
+  s_incrementalRoutes.reset();
+}
+
+static size_t
+getThreadCount()
+{
+  uint32_t nThreads = GlobalRoutingHelper::GetThreadCount();
+  if (nThreads == 0) {
+    nThreads = std::thread::hardware_concurrency();
+  }
+  return std::max<uint32_t>(nThreads, 1);
+}
+
+// Number of searches handed to the workers at once: bounds the memory held by computed routes
+// that are not installed yet
+static size_t
+getBatchSize()
+{
+  return 64 * getThreadCount();
+}
+
+// Runs task(0) ... task(n - 1) on the calling thread and up to getThreadCount() - 1 workers.
+// Tasks must not touch ns-3 objects (reference counts of Ptr<> are not atomic).
+static void
+runInParallel(size_t n, const std::function<void(size_t)>& task)
+{
+  size_t nThreads = std::min<size_t>(getThreadCount(), n);
+  if (nThreads <= 1) {
+    for (size_t i = 0; i < n; ++i) {
+      task(i);
+    }
+    return;
+  }
+
+  std::atomic<size_t> next(0);
+  std::exception_ptr error;
+  std::mutex errorMutex;
+  auto worker = [&] {
+    for (size_t i = next++; i < n; i = next++) {
+      try {
+        task(i);
+      }
+      catch (...) {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (error == nullptr) {
+          error = std::current_exception();
+        }
+        next = n;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  try {
+    for (size_t i = 1; i < nThreads; ++i) {
+      threads.emplace_back(worker);
+    }
+  }
+  catch (const std::system_error& e) {
+    NS_LOG_WARN("Cannot start more than " << threads.size() << " route computation workers: "
+                << e.what());
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+}
+
+static void
+installRoutes(const GlobalRoutingGraph& graph, Ptr<Node> node,
+              const std::vector<GlobalRoutingGraph::Route>& routes)
+{
+  for (const auto& route : routes) {
+    const shared_ptr<Face>& face = graph.GetFace(route.face);
+    for (const auto& prefix : graph.GetRouter(route.destination)->GetLocalPrefixes()) {
+      NS_LOG_DEBUG(" prefix " << *prefix << " reachable via face " << *face << " with distance "
+                   << route.metric);
+
+      FibHelper::AddRoute(node, *prefix, face, route.metric);
+    }
+  }
+}
+
+// Brings the FIB of a source in line with its updated tree.  For each prefix, the next hops are
+// those installRoutes() would install: one per face, with the cost of the last origin in
+// vertex order that is reached through it.
+static void
+updateRoutes(const IncrementalRoutes& state, size_t i,
+             const std::vector<GlobalRoutingGraph::Change>& changes)
+{
+  const GlobalRoutingGraph& graph = *state.graph;
+  Ptr<Node> node = state.sources[i].first;
+  uint32_t source = state.sources[i].second;
+  const GlobalRoutingGraph::Tree& tree = state.trees[i];
+
+  std::unordered_map<uint32_t, const GlobalRoutingGraph::Change*> previous;
+  std::set<Name> prefixes;
+  for (const auto& change : changes) {
+    previous[change.vertex] = &change;
+    for (const auto& prefix : graph.GetRouter(change.vertex)->GetLocalPrefixes()) {
+      prefixes.insert(*prefix);
+    }
+  }
+
+  for (const Name& prefix : prefixes) {
+    std::map<uint32_t, uint32_t> before, after; // face => cost
+    for (uint32_t origin : state.prefixOrigins.at(prefix)) {
+      if (origin == source) {
+        continue;
+      }
+      if (tree.firstHop[origin] != GlobalRoutingGraph::NO_FACE) {
+        after[tree.firstHop[origin]] = tree.distance[origin];
+      }
+      auto change = previous.find(origin);
+      if (change == previous.end()) {
+        if (tree.firstHop[origin] != GlobalRoutingGraph::NO_FACE) {
+          before[tree.firstHop[origin]] = tree.distance[origin];
+        }
+      }
+      else if (change->second->firstHop != GlobalRoutingGraph::NO_FACE) {
+        before[change->second->firstHop] = change->second->distance;
+      }
+    }
+
+    for (const auto& hop : before) {
+      if (after.count(hop.first) == 0) {
+        NS_LOG_DEBUG("Node " << node->GetId() << ": prefix " << prefix
+                     << " no longer reachable via face " << *graph.GetFace(hop.first));
+        FibHelper::RemoveRoute(node, prefix, graph.GetFace(hop.first));
+      }
+    }
+    for (const auto& hop : after) {
+      auto old = before.find(hop.first);
+      if (old == before.end() || old->second != hop.second) {
+        NS_LOG_DEBUG("Node " << node->GetId() << ": prefix " << prefix << " reachable via face "
+                     << *graph.GetFace(hop.first) << " with distance " << hop.second);
+        FibHelper::AddRoute(node, prefix, graph.GetFace(hop.first), hop.second);
+      }
+    }
+  }
+}
+
 void
 GlobalRoutingHelper::Install(Ptr<Node> node)
 {
@@ -214,174 +406,209 @@ GlobalRoutingHelper::AddOriginsForAll()
   }
 }
 
+void
+GlobalRoutingHelper::SetThreadCount(uint32_t nThreads)
+{
+  s_nThreads = nThreads;
+}
+
+uint32_t
+GlobalRoutingHelper::GetThreadCount()
+{
+  return s_nThreads;
+}
+
 void
 GlobalRoutingHelper::CalculateRoutes()
 {
   /**
-   * Implementation of route calculation is heavily based on Boost Graph Library
-   * See http://www.boost.org/doc/libs/1_49_0/libs/graph/doc/table_of_contents.html for more details
+   * Shortest paths are computed on a snapshot of the router graph (see GlobalRoutingGraph),
+   * one search per node, in parallel.  FIB entries are installed afterwards, from the calling
+   * thread, in node order, so the result does not depend on the number of threads.
    */
 
-  BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<boost::NdnGlobalRouterGraph>));
-  BOOST_CONCEPT_ASSERT((boost::IncidenceGraphConcept<boost::NdnGlobalRouterGraph>));
-
-  boost::NdnGlobalRouterGraph graph;
-  // typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
+  auto graph = std::make_unique<GlobalRoutingGraph>();
 
-  // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
-  // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by
-  // the graph, which
-  // is not obviously how implement in an efficient manner
+  std::vector<std::pair<Ptr<Node>, uint32_t>> sources;
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
     Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter>();
     if (source == 0) {
       NS_LOG_DEBUG("Node " << (*node)->GetId() << " does not export GlobalRouter interface");
       continue;
     }
+    if (!isSimulatedLocally(*node)) {
+      continue;
+    }
+    sources.emplace_back(*node, graph->GetVertex(source));
+  }
 
-    boost::DistancesMap distances;
+  if (s_isIncremental) {
+    // All trees are kept for NotifyLinkStatus
+    auto state = std::make_unique<IncrementalRoutes>();
+    state->trees.resize(sources.size());
+    runInParallel(sources.size(), [&] (size_t i) {
+      state->trees[i] = graph->ComputeTree(sources[i].second);
+    });
+
+    for (size_t i = 0; i < sources.size(); ++i) {
+      NS_LOG_DEBUG("Reachability from Node: " << sources[i].first->GetId());
+      installRoutes(*graph, sources[i].first, graph->GetRoutes(sources[i].second, state->trees[i]));
+    }
 
-    dijkstra_shortest_paths(graph, source,
-                            // predecessor_map (boost::ref(predecessors))
-                            // .
-                            distance_map(boost::ref(distances))
-                              .distance_inf(boost::WeightInf)
-                              .distance_zero(boost::WeightZero)
-                              .distance_compare(boost::WeightCompare())
-                              .distance_combine(boost::WeightCombine()));
+    for (uint32_t origin : graph->GetOrigins()) {
+      for (const auto& prefix : graph->GetRouter(origin)->GetLocalPrefixes()) {
+        state->prefixOrigins[*prefix].push_back(origin);
+      }
+    }
+    state->graph = std::move(graph);
+    state->sources = std::move(sources);
 
-    // NS_LOG_DEBUG (predecessors.size () << ", " << distances.size ());
+    if (s_incrementalRoutes == nullptr) {
+      Simulator::ScheduleDestroy(&clearIncrementalRoutes);
+    }
+    s_incrementalRoutes = std::move(state);
+    return;
+  }
+  s_incrementalRoutes.reset();
+
+  std::vector<std::vector<GlobalRoutingGraph::Route>> routes;
+  size_t batchSize = getBatchSize();
+  for (size_t first = 0; first < sources.size(); first += batchSize) {
+    routes.assign(std::min(batchSize, sources.size() - first), {});
+    runInParallel(routes.size(), [&] (size_t i) {
+      routes[i] = graph->ComputeRoutes(sources[first + i].second);
+    });
+
+    for (size_t i = 0; i < routes.size(); ++i) {
+      Ptr<Node> node = sources[first + i].first;
+      NS_LOG_DEBUG("Reachability from Node: " << node->GetId());
+      installRoutes(*graph, node, routes[i]);
+    }
+  }
+}
 
-    Ptr<L3Protocol> L3protocol = (*node)->GetObject<L3Protocol>();
-    shared_ptr<nfd::Forwarder> forwarder = L3protocol->getForwarder();
+void
+GlobalRoutingHelper::EnableIncrementalUpdates(bool enable)
+{
+  s_isIncremental = enable;
+}
 
-    NS_LOG_DEBUG("Reachability from Node: " << source->GetObject<Node>()->GetId());
-    for (const auto& dist : distances) {
-      if (dist.first == source)
+void
+GlobalRoutingHelper::NotifyLinkStatus(Ptr<Channel> channel, bool isUp)
+{
+  if (s_incrementalRoutes == nullptr) {
+    NS_LOG_DEBUG("No shortest path trees to update (see EnableIncrementalUpdates)");
+    return;
+  }
+  IncrementalRoutes& state = *s_incrementalRoutes;
+  GlobalRoutingGraph& graph = *state.graph;
+
+  // Edges through the faces on the channel's devices
+  std::vector<uint32_t> edges;
+  for (uint32_t deviceId = 0; deviceId < channel->GetNDevices(); deviceId++) {
+    Ptr<NetDevice> device = channel->GetDevice(deviceId);
+    Ptr<GlobalRouter> router = device->GetNode()->GetObject<GlobalRouter>();
+    uint32_t vertex = router != nullptr ? graph.GetVertex(router) : GlobalRoutingGraph::NO_VERTEX;
+    if (vertex == GlobalRoutingGraph::NO_VERTEX) {
+      continue;
+    }
+
+    auto outEdges = graph.GetOutEdges(vertex);
+    for (uint32_t edge = outEdges.first; edge < outEdges.second; ++edge) {
+      uint32_t face = graph.GetEdgeFace(edge);
+      if (face == GlobalRoutingGraph::NO_FACE || graph.IsEdgeUp(edge) == isUp) {
         continue;
-      else {
-        // cout << "  Node " << dist.first->GetObject<Node> ()->GetId ();
-        if (std::get<0>(dist.second) == 0) {
-          // cout << " is unreachable" << endl;
-        }
-        else {
-          for (const auto& prefix : dist.first->GetLocalPrefixes()) {
-            NS_LOG_DEBUG(" prefix " << prefix << " reachable via face " << *std::get<0>(dist.second)
-                         << " with distance " << std::get<1>(dist.second) << " with delay "
-                         << std::get<2>(dist.second));
-
-            FibHelper::AddRoute(*node, *prefix, std::get<0>(dist.second),
-                                std::get<1>(dist.second));
-          }
-        }
+      }
+      auto transport = dynamic_cast<NetDeviceTransport*>(graph.GetFace(face)->getTransport());
+      if (transport != nullptr && transport->GetNetDevice() == device) {
+        graph.SetEdgeUp(edge, isUp);
+        edges.push_back(edge);
       }
     }
   }
+  if (edges.empty()) {
+    return;
+  }
+  NS_LOG_DEBUG("Updating routes after " << edges.size() << " edges went "
+               << (isUp ? "up" : "down"));
+
+  const std::vector<uint32_t> none;
+  std::vector<std::vector<GlobalRoutingGraph::Change>> changes(state.trees.size());
+  runInParallel(state.trees.size(), [&] (size_t i) {
+    changes[i] = graph.UpdateTree(state.sources[i].second, state.trees[i], isUp ? none : edges,
+                                  isUp ? edges : none);
+  });
+
+  for (size_t i = 0; i < changes.size(); ++i) {
+    if (!changes[i].empty()) {
+      updateRoutes(state, i, changes[i]);
+    }
+  }
 }
 
 void
 GlobalRoutingHelper::CalculateAllPossibleRoutes()
 {
   /**
-   * Implementation of route calculation is heavily based on Boost Graph Library
-   * See http://www.boost.org/doc/libs/1_49_0/libs/graph/doc/table_of_contents.html for more details
+   * For every face of every node, shortest paths are computed with all other faces of the node
+   * disabled (metric std::numeric_limits<uint16_t>::max () - 1), and the routes through the
+   * face are installed.  Searches run in parallel on a snapshot of the router graph, so face
+   * metrics are never modified; FIB entries are installed in node and face order.
    */
 
-  BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<boost::NdnGlobalRouterGraph>));
-  BOOST_CONCEPT_ASSERT((boost::IncidenceGraphConcept<boost::NdnGlobalRouterGraph>));
+  // Incremental updates would replace these routes with shortest paths: stop tracking them
+  s_incrementalRoutes.reset();
 
-  boost::NdnGlobalRouterGraph graph;
-  // typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
+  GlobalRoutingGraph graph;
 
-  // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
-  // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by
-  // the graph, which
-  // is not obviously how implement in an efficient manner
+  struct Search {
+    Ptr<Node> node;
+    uint32_t source;
+    uint32_t face;
+  };
+  std::vector<Search> searches;
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
     Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter>();
     if (source == 0) {
       NS_LOG_DEBUG("Node " << (*node)->GetId() << " does not export GlobalRouter interface");
       continue;
     }
-
-    Ptr<L3Protocol> L3protocol = (*node)->GetObject<L3Protocol>();
-    shared_ptr<nfd::Forwarder> forwarder = L3protocol->getForwarder();
-
-    NS_LOG_DEBUG("Reachability from Node: " << source->GetObject<Node>()->GetId() << " ("
-                                            << Names::FindName(source->GetObject<Node>()) << ")");
+    if (!isSimulatedLocally(*node)) {
+      continue;
+    }
 
     Ptr<L3Protocol> l3 = source->GetObject<L3Protocol>();
     NS_ASSERT(l3 != 0);
 
-    // remember interface statuses
-    std::list<nfd::FaceId> faceIds;
-    std::unordered_map<nfd::FaceId, uint16_t> originalMetrics;
-    for (auto& nfdFace : l3->getFaceTable()) {
-      faceIds.push_back(nfdFace.getId());
-      originalMetrics[nfdFace.getId()] = nfdFace.getMetric();
-      nfdFace.setMetric(std::numeric_limits<uint16_t>::max() - 1);
-      // value std::numeric_limits<uint16_t>::max () MUST NOT be used (reserved)
-    }
-
-    for (auto& faceId : faceIds) {
-      auto* face = l3->getFaceTable().get(faceId);
-      NS_ASSERT(face != nullptr);
-      auto transport = dynamic_cast<NetDeviceTransport*>(face->getTransport());
+    for (auto& face : l3->getFaceTable()) {
+      auto transport = dynamic_cast<NetDeviceTransport*>(face.getTransport());
       if (transport == nullptr) {
         NS_LOG_DEBUG("Skipping non ndnSIM-specific transport face");
         continue;
       }
-
-      // enabling only faceId
-      face->setMetric(originalMetrics[faceId]);
-
-      boost::DistancesMap distances;
-
-      NS_LOG_DEBUG("-----------");
-
-      dijkstra_shortest_paths(graph, source,
-                              // predecessor_map (boost::ref(predecessors))
-                              // .
-                              distance_map(boost::ref(distances))
-                                .distance_inf(boost::WeightInf)
-                                .distance_zero(boost::WeightZero)
-                                .distance_compare(boost::WeightCompare())
-                                .distance_combine(boost::WeightCombine()));
-
-      // NS_LOG_DEBUG (predecessors.size () << ", " << distances.size ());
-
-      for (const auto& dist : distances) {
-        if (dist.first == source)
-          continue;
-        else {
-          // cout << "  Node " << dist.first->GetObject<Node> ()->GetId ();
-          if (std::get<0>(dist.second) == 0) {
-            // cout << " is unreachable" << endl;
-          }
-          else {
-            for (const auto& prefix : dist.first->GetLocalPrefixes()) {
-              NS_LOG_DEBUG(" prefix " << *prefix << " reachable via face "
-                           << *std::get<0>(dist.second)
-                           << " with distance " << std::get<1>(dist.second)
-                           << " with delay " << std::get<2>(dist.second));
-
-              if (std::get<0>(dist.second)->getMetric() == std::numeric_limits<uint16_t>::max() - 1)
-                continue;
-
-              FibHelper::AddRoute(*node, *prefix, std::get<0>(dist.second),
-                                  std::get<1>(dist.second));
-            }
-          }
-        }
+      uint32_t faceIndex = graph.GetFaceIndex(face);
+      if (faceIndex == GlobalRoutingGraph::NO_FACE) {
+        continue; // no GlobalRouter on the other side, nothing is reachable through the face
       }
-
-      // disabling the face again
-      face->setMetric(std::numeric_limits<uint16_t>::max() - 1);
+      searches.push_back({*node, graph.GetVertex(source), faceIndex});
     }
+  }
 
-    // recover original interface statuses
-    for (auto& i : originalMetrics) {
-      l3->getFaceTable().get(i.first)->setMetric(i.second);
+  std::vector<std::vector<GlobalRoutingGraph::Route>> routes;
+  size_t batchSize = getBatchSize();
+  for (size_t first = 0; first < searches.size(); first += batchSize) {
+    routes.assign(std::min(batchSize, searches.size() - first), {});
+    runInParallel(routes.size(), [&] (size_t i) {
+      const Search& search = searches[first + i];
+      routes[i] = graph.ComputeRoutes(search.source, search.face);
+    });
+
+    for (size_t i = 0; i < routes.size(); ++i) {
+      const Search& search = searches[first + i];
+      NS_LOG_DEBUG("Reachability from Node: " << search.node->GetId() << " ("
+                   << Names::FindName(search.node) << ") via face "
+                   << *graph.GetFace(search.face));
+      installRoutes(graph, search.node, routes[i]);
     }
   }
 }
@@ -94,6 +94,48 @@ public:
   void
   AddOriginsForAll();
 
+  /**
+   * @brief Set the number of threads computing shortest paths in CalculateRoutes() and
+   *        CalculateAllPossibleRoutes()
+   *
+   * The installed routes do not depend on the number of threads.
+   *
+   * @param nThreads number of threads, including the calling one; 0 (default) uses one thread
+   *                 per hardware thread
+   */
+  static void
+  SetThreadCount(uint32_t nThreads);
+
+  static uint32_t
+  GetThreadCount();
+
+  /**
+   * @brief Keep the shortest path trees computed by CalculateRoutes(), so that the routes can
+   *        be updated incrementally when links fail or recover
+   *
+   * Should be called before CalculateRoutes().  The trees take memory proportional to the
+   * square of the number of routers.
+   *
+   * @sa NotifyLinkStatus
+   */
+  static void
+  EnableIncrementalUpdates(bool enable = true);
+
+  /**
+   * @brief Update the routes installed by CalculateRoutes() after the link of @p channel failed
+   *        or recovered
+   *
+   * Only the shortest path trees that used the failed link, or that the recovered link
+   * shortens, are searched again, and only the routes whose next hop or cost changed are added,
+   * updated, or removed (using FibHelper).  LinkControlHelper::FailLink and
+   * LinkControlHelper::UpLink call this method.
+   *
+   * Does nothing unless EnableIncrementalUpdates() was in effect for the last call to
+   * CalculateRoutes(), or if CalculateAllPossibleRoutes() was called after it.
+   */
+  static void
+  NotifyLinkStatus(Ptr<Channel> channel, bool isUp);
+
   /**
    * @brief Calculate for every node shortest path trees and install routes to all prefix origins
    */
@@ -127,6 +169,10 @@ public:
 private:
   void
   Install(Ptr<Channel> channel);
+
+private:
+  static uint32_t s_nThreads;
+  static bool s_isIncremental;
 };
 
 } // namespace ndn
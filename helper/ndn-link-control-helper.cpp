@@ -18,6 +18,7 @@
  **/
 
 #include "ndn-link-control-helper.hpp"
+#include "ndn-global-routing-helper.hpp"
 
 #include "ns3/assert.h"
 #include "ns3/names.h"
@@ -85,6 +86,8 @@ LinkControlHelper::setErrorRate(Ptr<Node> node1, Ptr<Node> node2, double errorRa
 
       nd1->SetAttribute("ReceiveErrorModel", PointerValue(errorFactory.Create<ErrorModel>()));
       nd2->SetAttribute("ReceiveErrorModel", PointerValue(errorFactory.Create<ErrorModel>()));
+
+      GlobalRoutingHelper::NotifyLinkStatus(ppChannel, errorRate < 1.0);
       return;
     }
   }
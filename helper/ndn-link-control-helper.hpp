@@ -43,6 +43,9 @@ public:
    *
    * Note that only PointToPointChannels are supported by this helper method
    *
+   * If GlobalRoutingHelper keeps incremental routing state (see
+   * GlobalRoutingHelper::EnableIncrementalUpdates), the routes through the link are replaced
+   *
    * @param node1 one node
    * @param node2 another node
    */
@@ -73,6 +76,10 @@ public:
    *
    * Note that only PointToPointChannels are supported by this helper method
    *
+   * If GlobalRoutingHelper keeps incremental routing state (see
+   * GlobalRoutingHelper::EnableIncrementalUpdates), the routes that the link shortens are
+   * updated
+   *
    * @param node1 one node
    * @param node2 another node
    */
@@ -0,0 +1,213 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2025  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-app-dispatcher.hpp"
+#include "ndn-app-link-service.hpp"
+
+#include "ns3/enum.h"
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+
+#include "apps/ndn-app.hpp"
+
+NS_LOG_COMPONENT_DEFINE("ndn.AppDispatcher");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(AppDispatcher);
+
+TypeId
+AppDispatcher::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::AppDispatcher")
+      .SetGroupName("Ndn")
+      .SetParent<Object>()
+      .AddConstructor<AppDispatcher>()
+
+      .AddAttribute("Mode", "How packets from the forwarder reach the applications of the node",
+                    EnumValue(SCHEDULED), MakeEnumAccessor(&AppDispatcher::m_mode),
+                    MakeEnumChecker(SCHEDULED, "Scheduled", BATCHED, "Batched", DIRECT, "Direct"))
+    ;
+  return tid;
+}
+
+AppDispatcher::AppDispatcher()
+  : m_mode(SCHEDULED)
+  , m_isDrainScheduled(false)
+  , m_appDepth(0)
+  , m_directDepth(0)
+{
+}
+
+Ptr<AppDispatcher>
+AppDispatcher::GetDispatcher(Ptr<Node> node)
+{
+  Ptr<AppDispatcher> dispatcher = node->GetObject<AppDispatcher>();
+  if (dispatcher == nullptr) {
+    dispatcher = CreateObject<AppDispatcher>();
+    node->AggregateObject(dispatcher);
+  }
+  return dispatcher;
+}
+
+AppDispatcher::Mode
+AppDispatcher::GetMode() const
+{
+  return m_mode;
+}
+
+void
+AppDispatcher::DoDispose()
+{
+  m_queue.clear();
+  Object::DoDispose();
+}
+
+void
+AppDispatcher::DeliverInterest(Ptr<App> app, shared_ptr<const Interest> interest)
+{
+  if (m_mode == SCHEDULED) {
+    // to decouple callbacks
+    Simulator::ScheduleNow(&App::OnInterest, app, std::move(interest));
+    return;
+  }
+  Deliver({Entry::INTEREST, app, nullptr, std::move(interest), nullptr, nullptr});
+}
+
+void
+AppDispatcher::DeliverData(Ptr<App> app, shared_ptr<const Data> data)
+{
+  if (m_mode == SCHEDULED) {
+    // to decouple callbacks
+    Simulator::ScheduleNow(&App::OnData, app, std::move(data));
+    return;
+  }
+  Deliver({Entry::DATA, app, nullptr, nullptr, std::move(data), nullptr});
+}
+
+void
+AppDispatcher::DeliverNack(Ptr<App> app, shared_ptr<const lp::Nack> nack)
+{
+  if (m_mode == SCHEDULED) {
+    // to decouple callbacks
+    Simulator::ScheduleNow(&App::OnNack, app, std::move(nack));
+    return;
+  }
+  Deliver({Entry::NACK, app, nullptr, nullptr, nullptr, std::move(nack)});
+}
+
+void
+AppDispatcher::DeferReceiveInterest(shared_ptr<const Face> face, shared_ptr<const Interest> interest)
+{
+  Enqueue({Entry::INTEREST, nullptr, std::move(face), std::move(interest), nullptr, nullptr});
+}
+
+void
+AppDispatcher::DeferReceiveData(shared_ptr<const Face> face, shared_ptr<const Data> data)
+{
+  Enqueue({Entry::DATA, nullptr, std::move(face), nullptr, std::move(data), nullptr});
+}
+
+void
+AppDispatcher::DeferReceiveNack(shared_ptr<const Face> face, shared_ptr<const lp::Nack> nack)
+{
+  Enqueue({Entry::NACK, nullptr, std::move(face), nullptr, nullptr, std::move(nack)});
+}
+
+void
+AppDispatcher::Deliver(Entry&& entry)
+{
+  if (m_mode != DIRECT || m_appDepth > 0) {
+    Enqueue(std::move(entry));
+    return;
+  }
+
+  // The forwarder is below us on the stack: the application runs right away, but whatever it
+  // hands back to the forwarder or other applications waits for the queue
+  ++m_directDepth;
+  Dispatch(entry);
+  --m_directDepth;
+}
+
+void
+AppDispatcher::Enqueue(Entry&& entry)
+{
+  m_queue.push_back(std::move(entry));
+  if (!m_isDrainScheduled) {
+    m_isDrainScheduled = true;
+    Simulator::ScheduleNow(&AppDispatcher::Drain, this);
+  }
+}
+
+void
+AppDispatcher::Drain()
+{
+  NS_LOG_FUNCTION(this << m_queue.size());
+
+  // Packets queued by the callbacks below are handled in this same event
+  while (!m_queue.empty()) {
+    Entry entry = std::move(m_queue.front());
+    m_queue.pop_front();
+    Dispatch(entry);
+  }
+  m_isDrainScheduled = false;
+}
+
+void
+AppDispatcher::Dispatch(const Entry& entry)
+{
+  if (entry.app == nullptr) {
+    if (entry.face->getState() != nfd::face::FaceState::UP) {
+      NS_LOG_DEBUG("Face " << entry.face->getId() << " went down, dropping queued packet");
+      return;
+    }
+    auto linkService = static_cast<AppLinkService*>(entry.face->getLinkService());
+    switch (entry.type) {
+    case Entry::INTEREST:
+      linkService->onReceiveInterest(*entry.interest);
+      break;
+    case Entry::DATA:
+      linkService->onReceiveData(*entry.data);
+      break;
+    case Entry::NACK:
+      linkService->onReceiveNack(*entry.nack);
+      break;
+    }
+    return;
+  }
+
+  AppScope scope(*this);
+  switch (entry.type) {
+  case Entry::INTEREST:
+    entry.app->OnInterest(entry.interest);
+    break;
+  case Entry::DATA:
+    entry.app->OnData(entry.data);
+    break;
+  case Entry::NACK:
+    entry.app->OnNack(entry.nack);
+    break;
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
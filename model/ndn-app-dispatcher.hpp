@@ -0,0 +1,184 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2025  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_APP_DISPATCHER_HPP
+#define NDN_APP_DISPATCHER_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+
+#include <deque>
+
+namespace ns3 {
+
+class Node;
+
+namespace ndn {
+
+class App;
+
+/**
+ * \ingroup ndn-face
+ * \brief Per-node dispatcher of the packets exchanged between applications and the forwarder
+ *
+ * Aggregated to the node by the first AppLinkService created there. The Mode attribute selects
+ * how packets reach the applications:
+ *
+ *  - Scheduled (default): one Simulator::ScheduleNow event per packet, as ndnSIM always did;
+ *  - Batched: packets are appended to a queue that a single ScheduleNow event drains, so a
+ *    burst of packets delivered at the same time costs one event;
+ *  - Direct: the application callback runs synchronously from the forwarder. While application
+ *    code runs (a directly dispatched callback, or an application handing a packet to the
+ *    forwarder), further deliveries to applications are queued as in Batched mode, and packets an
+ *    application sends from a direct callback reach the forwarder through the queue as well.
+ *    Neither applications nor the forwarder are thus ever re-entered.
+ *
+ * Batched and Direct keep the order of the packets delivered at a given time, but run queued
+ * callbacks before other events scheduled for the same time.
+ *
+ *     Config::SetDefault("ns3::ndn::AppDispatcher::Mode", StringValue("Direct"));
+ */
+class AppDispatcher : public Object
+{
+public:
+  enum Mode {
+    SCHEDULED,
+    BATCHED,
+    DIRECT
+  };
+
+  static TypeId
+  GetTypeId();
+
+  AppDispatcher();
+
+  /**
+   * \brief Get the dispatcher of @p node, creating it on first use
+   */
+  static Ptr<AppDispatcher>
+  GetDispatcher(Ptr<Node> node);
+
+  Mode
+  GetMode() const;
+
+  /**
+   * \brief Deliver a packet the forwarder sent on the face of @p app
+   */
+  void
+  DeliverInterest(Ptr<App> app, shared_ptr<const Interest> interest);
+
+  void
+  DeliverData(Ptr<App> app, shared_ptr<const Data> data);
+
+  void
+  DeliverNack(Ptr<App> app, shared_ptr<const lp::Nack> nack);
+
+  /**
+   * \brief Whether a packet an application hands to the forwarder must be queued
+   *
+   * True inside a directly dispatched application callback, which runs from within the
+   * forwarder.
+   */
+  bool
+  MustDeferReceive() const
+  {
+    return m_directDepth > 0;
+  }
+
+  /**
+   * \brief Queue a packet for the forwarder, received from an application on @p face
+   */
+  void
+  DeferReceiveInterest(shared_ptr<const Face> face, shared_ptr<const Interest> interest);
+
+  void
+  DeferReceiveData(shared_ptr<const Face> face, shared_ptr<const Data> data);
+
+  void
+  DeferReceiveNack(shared_ptr<const Face> face, shared_ptr<const lp::Nack> nack);
+
+  /**
+   * \brief Marks application code running on the node (deliveries to applications get queued)
+   */
+  class AppScope : ::ndn::noncopyable
+  {
+  public:
+    explicit
+    AppScope(AppDispatcher& dispatcher)
+      : m_depth(dispatcher.m_appDepth)
+    {
+      ++m_depth;
+    }
+
+    ~AppScope()
+    {
+      --m_depth;
+    }
+
+  private:
+    uint32_t& m_depth;
+  };
+
+protected:
+  virtual void
+  DoDispose() override;
+
+private:
+  struct Entry
+  {
+    enum Type {
+      INTEREST,
+      DATA,
+      NACK
+    };
+
+    Type type;
+    Ptr<App> app;                ///< \brief destination application (null: to the forwarder)
+    shared_ptr<const Face> face; ///< \brief face of the sending application (to the forwarder)
+    shared_ptr<const Interest> interest;
+    shared_ptr<const Data> data;
+    shared_ptr<const lp::Nack> nack;
+  };
+
+  void
+  Deliver(Entry&& entry);
+
+  void
+  Enqueue(Entry&& entry);
+
+  void
+  Drain();
+
+  void
+  Dispatch(const Entry& entry);
+
+private:
+  Mode m_mode;
+  std::deque<Entry> m_queue;
+  bool m_isDrainScheduled;
+  uint32_t m_appDepth;    ///< \brief nesting of application code running on the node
+  uint32_t m_directDepth; ///< \brief nesting of directly dispatched application callbacks
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_APP_DISPATCHER_HPP
@@ -18,6 +18,7 @@
  **/
 
 #include "ndn-app-link-service.hpp"
+#include "ndn-app-dispatcher.hpp"
 
 #include "ns3/log.h"
 #include "ns3/packet.h"
@@ -32,9 +33,22 @@ NS_LOG_COMPONENT_DEFINE("ndn.AppLinkService");
 namespace ns3 {
 namespace ndn {
 
+// Applications may hand over packets that are not owned by a shared_ptr
+template<typename Packet>
+static shared_ptr<const Packet>
+shareOrCopy(const Packet& packet)
+{
+  shared_ptr<const Packet> shared = packet.weak_from_this().lock();
+  if (shared == nullptr) {
+    shared = make_shared<Packet>(packet);
+  }
+  return shared;
+}
+
 AppLinkService::AppLinkService(Ptr<App> app)
   : m_node(app->GetNode())
   , m_app(app)
+  , m_dispatcher(AppDispatcher::GetDispatcher(m_node))
 {
   NS_LOG_FUNCTION(this << app);
 
@@ -51,8 +65,7 @@ AppLinkService::doSendInterest(const Interest& interest)
 {
   NS_LOG_FUNCTION(this << &interest);
 
-  // to decouple callbacks
-  Simulator::ScheduleNow(&App::OnInterest, m_app, interest.shared_from_this());
+  m_dispatcher->DeliverInterest(m_app, interest.shared_from_this());
 }
 
 void
@@ -60,8 +73,7 @@ AppLinkService::doSendData(const Data& data)
 {
   NS_LOG_FUNCTION(this << &data);
 
-  // to decouple callbacks
-  Simulator::ScheduleNow(&App::OnData, m_app, data.shared_from_this());
+  m_dispatcher->DeliverData(m_app, data.shared_from_this());
 }
 
 void
@@ -69,8 +81,7 @@ AppLinkService::doSendNack(const lp::Nack& nack)
 {
   NS_LOG_FUNCTION(this << &nack);
 
-  // to decouple callbacks
-  Simulator::ScheduleNow(&App::OnNack, m_app, make_shared<lp::Nack>(nack));
+  m_dispatcher->DeliverNack(m_app, make_shared<lp::Nack>(nack));
 }
 
 //
@@ -78,18 +89,33 @@ AppLinkService::doSendNack(const lp::Nack& nack)
 void
 AppLinkService::onReceiveInterest(const Interest& interest)
 {
+  if (m_dispatcher->MustDeferReceive()) {
+    m_dispatcher->DeferReceiveInterest(getFace()->shared_from_this(), shareOrCopy(interest));
+    return;
+  }
+  AppDispatcher::AppScope scope(*m_dispatcher);
   this->receiveInterest(interest, 0);
 }
 
 void
 AppLinkService::onReceiveData(const Data& data)
 {
+  if (m_dispatcher->MustDeferReceive()) {
+    m_dispatcher->DeferReceiveData(getFace()->shared_from_this(), shareOrCopy(data));
+    return;
+  }
+  AppDispatcher::AppScope scope(*m_dispatcher);
   this->receiveData(data, 0);
 }
 
 void
 AppLinkService::onReceiveNack(const lp::Nack& nack)
 {
+  if (m_dispatcher->MustDeferReceive()) {
+    m_dispatcher->DeferReceiveNack(getFace()->shared_from_this(), make_shared<lp::Nack>(nack));
+    return;
+  }
+  AppDispatcher::AppScope scope(*m_dispatcher);
   this->receiveNack(nack, 0);
 }
 
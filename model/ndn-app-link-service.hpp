@@ -31,11 +31,15 @@ class Node;
 namespace ndn {
 
 class App;
+class AppDispatcher;
 
 /**
  * \ingroup ndn-face
  * \brief Implementation of LinkService for ndnSIM application
  *
+ * Packets are passed between the application and the forwarder through the AppDispatcher of
+ * the node, whose Mode attribute decides whether they go through the simulator's event queue.
+ *
  * \see NetDeviceLinkService
  */
 class AppLinkService : public nfd::face::LinkService
@@ -78,6 +82,7 @@ private:
 private:
   Ptr<Node> m_node;
   Ptr<App> m_app;
+  Ptr<AppDispatcher> m_dispatcher;
 };
 
 } // namespace ndn
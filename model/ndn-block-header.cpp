@@ -19,16 +19,13 @@
 
 #include "ndn-block-header.hpp"
 
-#include <iosfwd>
-#include <boost/iostreams/concepts.hpp>
-#include <boost/iostreams/stream.hpp>
+#include <tuple>
 
 #include <ndn-cxx/encoding/tlv.hpp>
 #include <ndn-cxx/interest.hpp>
 #include <ndn-cxx/data.hpp>
 #include <ndn-cxx/lp/packet.hpp>
 
-namespace io = boost::iostreams;
 namespace nfdFace = nfd::face;
 
 namespace ns3 {
@@ -73,37 +70,22 @@ BlockHeader::Serialize(ns3::Buffer::Iterator start) const
   start.Write(m_block.wire(), m_block.size());
 }
 
-class Ns3BufferIteratorSource : public io::source {
-public:
-  Ns3BufferIteratorSource(ns3::Buffer::Iterator& is)
-    : m_is(is)
-  {
-  }
-
-  std::streamsize
-  read(char* buf, std::streamsize nMaxRead)
-  {
-    std::streamsize i = 0;
-    for (; i < nMaxRead && !m_is.IsEnd(); ++i) {
-      buf[i] = m_is.ReadU8();
-    }
-    if (i == 0) {
-      return -1;
-    }
-    else {
-      return i;
-    }
-  }
-
-private:
-  ns3::Buffer::Iterator& m_is;
-};
-
 uint32_t
 BlockHeader::Deserialize(ns3::Buffer::Iterator start)
 {
-  io::stream<Ns3BufferIteratorSource> is(start);
-  m_block = ::ndn::Block::fromStream(is);
+  // The header is the rest of the packet: pull it into the buffer the Block will own with one
+  // bulk read, then parse the TLV in place (no per-byte stream, no second copy)
+  auto buffer = std::make_shared<::ndn::Buffer>(start.GetRemainingSize());
+  start.Read(buffer->data(), buffer->size());
+
+  bool isOk = false;
+  std::tie(isOk, m_block) = Block::fromBuffer(std::move(buffer));
+  if (!isOk) {
+    NDN_THROW(::ndn::tlv::Error("Packet does not start with a complete TLV element"));
+  }
+  if (m_block.size() > ::ndn::MAX_NDN_PACKET_SIZE) {
+    NDN_THROW(::ndn::tlv::Error("TLV element exceeds the maximum NDN packet size"));
+  }
   return m_block.size();
 }
 
@@ -22,6 +22,7 @@
 #include "ns3/packet.h"
 #include "ns3/node.h"
 #include "ns3/log.h"
+#include "ns3/boolean.h"
 #include "ns3/callback.h"
 #include "ns3/uinteger.h"
 #include "ns3/trace-source-accessor.h"
@@ -76,6 +77,26 @@ L3Protocol::GetTypeId(void)
       .SetParent<Object>()
       .AddConstructor<L3Protocol>()
 
+      .AddAttribute("OpenAddressingNameTree",
+                    "Resolve name tree (FIB, PIT, Measurements) hash collisions by open "
+                    "addressing instead of chaining",
+                    BooleanValue(false),
+                    MakeBooleanAccessor(&L3Protocol::m_isOpenAddressingNameTree),
+                    MakeBooleanChecker())
+      .AddAttribute("BinarySearchLpm",
+                    "Find the longest prefix match of a name (e.g., in FIB) by a binary search "
+                    "over its prefix lengths instead of trying each of them in turn",
+                    BooleanValue(false),
+                    MakeBooleanAccessor(&L3Protocol::m_isBinarySearchLpm),
+                    MakeBooleanChecker())
+      .AddAttribute("BlockHeader",
+                    "Send NDN packets on net devices as an ndn::BlockHeader instead of a plain "
+                    "payload, so that Packet::Print (e.g. ASCII traces) decodes them; read when "
+                    "the node's net device faces are created",
+                    BooleanValue(false),
+                    MakeBooleanAccessor(&L3Protocol::m_isBlockHeader),
+                    MakeBooleanChecker())
+
       .AddTraceSource("OutInterests", "OutInterests",
                       MakeTraceSourceAccessor(&L3Protocol::m_outInterests),
                       "ns3::ndn::L3Protocol::InterestTraceCallback")
@@ -198,6 +219,9 @@ private:
 
 L3Protocol::L3Protocol()
   : m_impl(new Impl())
+  , m_isOpenAddressingNameTree(false)
+  , m_isBinarySearchLpm(false)
+  , m_isBlockHeader(false)
 {
   NS_LOG_FUNCTION(this);
 }
@@ -211,7 +235,10 @@ void
 L3Protocol::initialize()
 {
   m_impl->m_faceTable = make_unique<::nfd::FaceTable>();
-  m_impl->m_forwarder = make_shared<::nfd::Forwarder>(*m_impl->m_faceTable);
+  ::nfd::name_tree::HashtableOptions nameTreeOptions(1024);
+  nameTreeOptions.useOpenAddressing = m_isOpenAddressingNameTree;
+  m_impl->m_forwarder = make_shared<::nfd::Forwarder>(*m_impl->m_faceTable, nameTreeOptions);
+  m_impl->m_forwarder->getNameTree().setBinarySearchLpm(m_isBinarySearchLpm);
   m_impl->m_faceSystem = make_unique<::nfd::face::FaceSystem>(*m_impl->m_faceTable, nullptr);
 
   initializeManagement();
@@ -354,6 +381,12 @@ L3Protocol::getRibService()
   return *m_impl->m_ribService;
 }
 
+bool
+L3Protocol::isBlockHeaderEnabled() const
+{
+  return m_isBlockHeader;
+}
+
 nfd::ConfigSection&
 L3Protocol::getConfig()
 {
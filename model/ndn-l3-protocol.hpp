@@ -123,6 +123,13 @@ public:
   ::nfd::rib::Service&
   getRibService();
 
+  /**
+   * \brief Whether the node's net device faces send NDN packets as a BlockHeader
+   *        (the BlockHeader attribute)
+   */
+  bool
+  isBlockHeaderEnabled() const;
+
   /**
    * \brief Add face to NDN stack
    *
@@ -215,6 +222,10 @@ private:
   // These objects are aggregated, but for optimization, get them here
   Ptr<Node> m_node; ///< \brief node on which ndn stack is installed
 
+  bool m_isOpenAddressingNameTree; ///< \brief whether the name tree uses open addressing
+  bool m_isBinarySearchLpm; ///< \brief whether name tree LPM binary-searches over name lengths
+  bool m_isBlockHeader; ///< \brief whether net device faces send packets as a BlockHeader
+
   TracedCallback<const Interest&, const Face&>
     m_inInterests; ///< @brief trace of incoming Interests
   TracedCallback<const Interest&, const Face&>
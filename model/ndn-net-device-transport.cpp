@@ -28,6 +28,7 @@
 #include <ndn-cxx/data.hpp>
 
 #include "ns3/queue.h"
+#include "ns3/simulator.h"
 
 NS_LOG_COMPONENT_DEFINE("ndn.NetDeviceTransport");
 
@@ -43,6 +44,7 @@ NetDeviceTransport::NetDeviceTransport(Ptr<Node> node,
                                        ::ndn::nfd::LinkType linkType)
   : m_netDevice(netDevice)
   , m_node(node)
+  , m_useBlockHeader(false)
 {
   this->setLocalUri(FaceUri(localUri));
   this->setRemoteUri(FaceUri(remoteUri));
@@ -51,27 +53,21 @@ NetDeviceTransport::NetDeviceTransport(Ptr<Node> node,
   this->setLinkType(linkType);
   this->setMtu(m_netDevice->GetMtu()); // Use the MTU of the netDevice
 
-  // Get send queue capacity for congestion marking
-  PointerValue txQueueAttribute;
-  if (m_netDevice->GetAttributeFailSafe("TxQueue", txQueueAttribute)) {
-    Ptr<ns3::QueueBase> txQueue = txQueueAttribute.Get<ns3::QueueBase>();
-    // must be put into bytes mode queue
-
-    auto size = txQueue->GetMaxSize();
-    if (size.GetUnit() == BYTES) {
-      this->setSendQueueCapacity(size.GetValue());
-    }
-    else {
-      // don't know the exact size in bytes, guessing based on "standard" packet size
-      this->setSendQueueCapacity(size.GetValue() * 1500);
-    }
-  }
+  // Resolve the queue used for congestion marking now, and again when the simulation starts, so
+  // that a TxQueue configured after the face was created is picked up
+  RefreshSendQueue();
+  m_refreshEvent = Simulator::ScheduleNow(&NetDeviceTransport::RefreshSendQueue, this);
 
   NS_LOG_FUNCTION(this << "Creating an ndnSIM transport instance for netDevice with URI"
                   << this->getLocalUri());
 
   NS_ASSERT_MSG(m_netDevice != 0, "NetDeviceFace needs to be assigned a valid NetDevice");
 
+  Ptr<L3Protocol> ndn = m_node->GetObject<L3Protocol>();
+  if (ndn != nullptr) {
+    m_useBlockHeader = ndn->isBlockHeaderEnabled();
+  }
+
   m_node->RegisterProtocolHandler(MakeCallback(&NetDeviceTransport::receiveFromNetDevice, this),
                                   L3Protocol::ETHERNET_FRAME_TYPE, m_netDevice,
                                   true /*promiscuous mode*/);
@@ -80,19 +76,65 @@ NetDeviceTransport::NetDeviceTransport(Ptr<Node> node,
 NetDeviceTransport::~NetDeviceTransport()
 {
   NS_LOG_FUNCTION_NOARGS();
+  Simulator::Cancel(m_refreshEvent);
 }
 
-ssize_t
-NetDeviceTransport::getSendQueueLength()
+static uint64_t
+queueSizeInBytes(const QueueSize& size)
 {
+  if (size.GetUnit() == BYTES) {
+    return size.GetValue();
+  }
+  // don't know the exact size in bytes, guessing based on "standard" packet size
+  return static_cast<uint64_t>(size.GetValue()) * 1500;
+}
+
+void
+NetDeviceTransport::RefreshSendQueue()
+{
+  m_txQueue = nullptr;
+
   PointerValue txQueueAttribute;
   if (m_netDevice->GetAttributeFailSafe("TxQueue", txQueueAttribute)) {
-    Ptr<ns3::QueueBase> txQueue = txQueueAttribute.Get<ns3::QueueBase>();
-    return txQueue->GetNBytes();
+    m_txQueue = txQueueAttribute.Get<ns3::QueueBase>();
   }
-  else {
+
+  // Get send queue capacity for congestion marking (must be put into bytes mode queue)
+  if (m_txQueue != nullptr) {
+    uint64_t capacity = queueSizeInBytes(m_txQueue->GetMaxSize());
+    this->setSendQueueCapacity(static_cast<ssize_t>(capacity));
+    NS_LOG_DEBUG("TxQueue capacity " << capacity << " bytes");
+  }
+}
+
+void
+NetDeviceTransport::SetSendQueueCallback(const SendQueueCallback& callback)
+{
+  m_sendQueueCallback = callback;
+}
+
+NetDeviceTransport::QueueOccupancy
+NetDeviceTransport::GetSendQueueOccupancy() const
+{
+  if (m_sendQueueCallback) {
+    return m_sendQueueCallback();
+  }
+
+  QueueOccupancy occupancy{0, 0};
+  if (m_txQueue != nullptr) {
+    occupancy.bytes += m_txQueue->GetNBytes();
+    occupancy.packets += m_txQueue->GetNPackets();
+  }
+  return occupancy;
+}
+
+ssize_t
+NetDeviceTransport::getSendQueueLength()
+{
+  if (!m_sendQueueCallback && m_txQueue == nullptr) {
     return nfd::face::QUEUE_UNSUPPORTED;
   }
+  return GetSendQueueOccupancy().bytes;
 }
 
 void
@@ -111,11 +153,17 @@ NetDeviceTransport::doSend(const Block& packet)
   NS_LOG_FUNCTION(this << "Sending packet from netDevice with URI"
                   << this->getLocalUri());
 
-  // convert NFD packet to NS3 packet
-  BlockHeader header(packet);
-
-  Ptr<ns3::Packet> ns3Packet = Create<ns3::Packet>();
-  ns3Packet->AddHeader(header);
+  // convert NFD packet to NS3 packet: the wire is written straight into the packet buffer (which
+  // ns-3 recycles through its own free list); the BlockHeader detour is only needed to let
+  // Packet::Print decode the NDN packet
+  Ptr<ns3::Packet> ns3Packet;
+  if (m_useBlockHeader) {
+    ns3Packet = Create<ns3::Packet>();
+    ns3Packet->AddHeader(BlockHeader(packet));
+  }
+  else {
+    ns3Packet = Create<ns3::Packet>(packet.wire(), packet.size());
+  }
 
   // send the NS3 packet
   m_netDevice->Send(ns3Packet, m_netDevice->GetBroadcast(),
@@ -132,13 +180,21 @@ NetDeviceTransport::receiveFromNetDevice(Ptr<NetDevice> device,
 {
   NS_LOG_FUNCTION(device << p << protocol << from << to << packetType);
 
-  // Convert NS3 packet to NFD packet
-  Ptr<ns3::Packet> packet = p->Copy();
-
-  BlockHeader header;
-  packet->RemoveHeader(header);
+  // Convert NS3 packet to NFD packet: the packet carries only the TLV element, so its bytes are
+  // copied once into the buffer the Block will own and parsed there (no packet copy, no
+  // RemoveHeader, no per-byte stream)
+  auto buffer = std::make_shared<::ndn::Buffer>(p->GetSize());
+  p->CopyData(buffer->data(), buffer->size());
+
+  bool isOk = false;
+  Block block;
+  std::tie(isOk, block) = Block::fromBuffer(std::move(buffer));
+  if (!isOk || block.size() > ::ndn::MAX_NDN_PACKET_SIZE) {
+    NS_LOG_WARN("Dropping malformed packet of " << p->GetSize() << " bytes");
+    return;
+  }
 
-  this->receive(std::move(header.getBlock()));
+  this->receive(std::move(block));
 }
 
 Ptr<NetDevice>
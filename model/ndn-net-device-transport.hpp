@@ -31,6 +31,10 @@
 
 #include "ns3/point-to-point-net-device.h"
 #include "ns3/channel.h"
+#include "ns3/event-id.h"
+#include "ns3/queue.h"
+
+#include <functional>
 
 namespace ns3 {
 namespace ndn {
@@ -54,9 +58,52 @@ public:
   Ptr<NetDevice>
   GetNetDevice() const;
 
+  /**
+   * \brief Occupancy of the queues in front of the link
+   */
+  struct QueueOccupancy
+  {
+    uint32_t bytes;
+    uint32_t packets;
+  };
+
+  typedef std::function<QueueOccupancy()> SendQueueCallback;
+
+  /**
+   * \brief Bytes waiting to be sent, used by GenericLinkService for congestion marking
+   *
+   * Reads the queues resolved by RefreshSendQueue() (no attribute lookup per packet), or the
+   * callback set with SetSendQueueCallback().
+   */
   virtual ssize_t
   getSendQueueLength() final;
 
+  /**
+   * \brief Bytes and packets held by the device TxQueue
+   *
+   * NDN packets are handed to the NetDevice directly, bypassing the traffic-control layer, so a
+   * queue disc installed on the device never holds them and is not counted.
+   */
+  QueueOccupancy
+  GetSendQueueOccupancy() const;
+
+  /**
+   * \brief Report the occupancy of another queue (e.g., the actual bottleneck) instead
+   *
+   * An empty callback restores the default.
+   */
+  void
+  SetSendQueueCallback(const SendQueueCallback& callback);
+
+  /**
+   * \brief Look up the device TxQueue again, and update the send queue capacity
+   *
+   * Done on creation and when the simulation starts; call it after replacing either queue
+   * later on.
+   */
+  void
+  RefreshSendQueue();
+
 private:
   virtual void
   doClose() override;
@@ -73,6 +120,18 @@ private:
 
   Ptr<NetDevice> m_netDevice; ///< \brief Smart pointer to NetDevice
   Ptr<Node> m_node;
+
+  Ptr<ns3::QueueBase> m_txQueue;
+  SendQueueCallback m_sendQueueCallback;
+  EventId m_refreshEvent;
+
+  /**
+   * Send packets as an ndn::BlockHeader (L3Protocol's BlockHeader attribute) instead of a plain
+   * payload. The payload form saves a header object and its serialization on every hop, but
+   * Packet::Print then only shows the payload size. Received packets are parsed the same way in
+   * either case.
+   */
+  bool m_useBlockHeader;
 };
 
 } // namespace ndn
@@ -0,0 +1,95 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2025  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/agg-common/agg-name.hpp"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(AppsAggCommonAggName)
+
+BOOST_AUTO_TEST_CASE(ChildLookup)
+{
+  ChildIndex index;
+  index.Assign({"/agg1", "/leaf2/extra", "/leaf3", "/agg1"});
+  BOOST_CHECK_EQUAL(index.Size(), 4);
+
+  BOOST_CHECK_EQUAL(index.Find(Name("/agg1/seq=7").get(0)), 0);
+  BOOST_CHECK_EQUAL(index.Find(Name("/leaf2/seq=7").get(0)), 1);
+  BOOST_CHECK_EQUAL(index.Find(Name("/leaf3").get(0)), 2);
+  BOOST_CHECK_EQUAL(index.Find(Name("/leaf4").get(0)), ChildIndex::NOT_FOUND);
+  BOOST_CHECK_EQUAL(index.Find(Name("/agg").get(0)), ChildIndex::NOT_FOUND);
+
+  // same bytes, different TLV-TYPE
+  BOOST_CHECK_EQUAL(index.Find(name::Component::fromEscapedString("32=agg1")), ChildIndex::NOT_FOUND);
+
+  // Data decoded from the wire is matched the same way
+  Data data(Name("/leaf3").appendSequenceNumber(1));
+  data.setSignatureInfo(SignatureInfo(static_cast<::ndn::tlv::SignatureTypeValue>(255)));
+  data.setSignatureValue(make_shared<::ndn::Buffer>());
+  Data decoded(data.wireEncode());
+  BOOST_CHECK_EQUAL(index.Find(decoded.getName().get(0)), 2);
+}
+
+BOOST_AUTO_TEST_CASE(Move)
+{
+  static_assert(!std::is_copy_constructible<ChildIndex>::value, "");
+  static_assert(!std::is_copy_assignable<ChildIndex>::value, "");
+
+  auto original = make_unique<ChildIndex>();
+  original->Assign({"/agg1", "/", "/leaf3"});
+  ChildIndex moved(std::move(*original));
+  BOOST_CHECK_EQUAL(original->Size(), 0);
+  BOOST_CHECK_EQUAL(original->Find(Name("/agg1").get(0)), ChildIndex::NOT_FOUND);
+
+  ChildIndex assigned;
+  assigned.Assign({"/other"});
+  assigned = std::move(moved);
+  original.reset();
+
+  // the index must not view the strings of a destroyed object
+  BOOST_CHECK_EQUAL(assigned.Size(), 3);
+  BOOST_CHECK_EQUAL(assigned.Find(Name("/agg1").get(0)), 0);
+  BOOST_CHECK_EQUAL(assigned.Find(Name("/leaf3").get(0)), 2);
+  BOOST_CHECK_EQUAL(assigned.Find(Name("/other").get(0)), ChildIndex::NOT_FOUND);
+}
+
+BOOST_AUTO_TEST_CASE(RoundNumber)
+{
+  uint64_t seq = 0;
+  BOOST_CHECK(ReadRoundNumber(Name().appendSequenceNumber(42).get(0), seq));
+  BOOST_CHECK_EQUAL(seq, 42);
+  BOOST_CHECK(ReadRoundNumber(Name("/17").get(0), seq));
+  BOOST_CHECK_EQUAL(seq, 17);
+  BOOST_CHECK(ReadRoundNumber(Name().appendSequenceNumber(0).get(0), seq));
+  BOOST_CHECK_EQUAL(seq, 0);
+
+  seq = 5;
+  BOOST_CHECK(!ReadRoundNumber(Name("/1a").get(0), seq));
+  BOOST_CHECK(!ReadRoundNumber(Name().appendSegment(3).get(0), seq));
+  BOOST_CHECK(!ReadRoundNumber(name::Component(), seq));
+  BOOST_CHECK_EQUAL(seq, 5);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,116 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2025  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/agg-common/preallocated-data.hpp"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(AppsAggCommonPreallocatedData)
+
+static shared_ptr<Data>
+makeReference(const Name& name, time::milliseconds freshness, const std::vector<uint8_t>& content)
+{
+  auto data = make_shared<Data>(name);
+  data->setFreshnessPeriod(freshness);
+  data->setContent(content.data(), content.size());
+  data->setSignatureInfo(SignatureInfo(static_cast<::ndn::tlv::SignatureTypeValue>(255)));
+  data->setSignatureValue(make_shared<::ndn::Buffer>());
+  return data;
+}
+
+BOOST_AUTO_TEST_CASE(MatchesRegularEncoding)
+{
+  Name name("/agg/node1/seq=5");
+  // freshness 0 omits FreshnessPeriod; 70000 bytes of content needs a 5-byte TLV-LENGTH
+  for (int freshness : {0, 1000, 70000}) {
+    for (size_t size : {0, 4, 8, 300, 70000}) {
+      std::vector<uint8_t> content(size);
+      for (size_t i = 0; i < size; ++i) {
+        content[i] = static_cast<uint8_t>(i * 7);
+      }
+
+      PreallocatedData prealloc;
+      prealloc.Prepare(name, time::milliseconds(freshness), size);
+      BOOST_REQUIRE(prealloc.IsPrepared());
+      BOOST_REQUIRE_EQUAL(prealloc.ContentSize(), size);
+      std::copy(content.begin(), content.end(), prealloc.Content());
+      auto data = prealloc.Finalize();
+      BOOST_CHECK(!prealloc.IsPrepared());
+
+      auto reference = makeReference(name, time::milliseconds(freshness), content);
+      const Block& actual = data->wireEncode();
+      const Block& expected = reference->wireEncode();
+      BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+      BOOST_CHECK_EQUAL(data->getName(), name);
+      BOOST_CHECK_EQUAL(data->getFreshnessPeriod(), time::milliseconds(freshness));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ContentStartsZeroed)
+{
+  PreallocatedData prealloc;
+  prealloc.Prepare("/agg/1", time::seconds(1), sizeof(uint64_t));
+  auto data = prealloc.Finalize();
+  const Block& content = data->getContent();
+  BOOST_REQUIRE_EQUAL(content.value_size(), sizeof(uint64_t));
+  for (size_t i = 0; i < content.value_size(); ++i) {
+    BOOST_CHECK_EQUAL(content.value()[i], 0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(AppMetaInfo)
+{
+  PreallocatedData prealloc;
+  prealloc.Prepare("/agg/1", time::seconds(1), sizeof(uint64_t), 128);
+  prealloc.SetAppMetaInfo(70000);
+  auto data = prealloc.Finalize();
+
+  BOOST_CHECK_EQUAL(data->getFreshnessPeriod(), time::seconds(1));
+  BOOST_CHECK_EQUAL(data->getContent().value_size(), sizeof(uint64_t));
+  const Block* block = data->getMetaInfo().findAppMetaInfo(128);
+  BOOST_REQUIRE(block != nullptr);
+  BOOST_CHECK_EQUAL(::ndn::encoding::readNonNegativeInteger(*block), 70000);
+  BOOST_CHECK(data->getMetaInfo().findAppMetaInfo(129) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(TwoAppMetaInfo)
+{
+  PreallocatedData prealloc;
+  prealloc.Prepare("/agg/1", time::seconds(1), sizeof(uint64_t), {0, 129, 128});
+  prealloc.SetAppMetaInfo(128, 3);
+  prealloc.SetAppMetaInfo(129, 300);
+  auto data = prealloc.Finalize();
+
+  // Zero types are skipped, the others kept in order
+  const auto& elements = data->getMetaInfo().getAppMetaInfo();
+  BOOST_REQUIRE_EQUAL(elements.size(), 2);
+  BOOST_CHECK_EQUAL(elements.front().type(), 129);
+  BOOST_CHECK_EQUAL(::ndn::encoding::readNonNegativeInteger(elements.front()), 300);
+  BOOST_CHECK_EQUAL(elements.back().type(), 128);
+  BOOST_CHECK_EQUAL(::ndn::encoding::readNonNegativeInteger(elements.back()), 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
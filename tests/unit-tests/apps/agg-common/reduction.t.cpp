@@ -0,0 +1,156 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2025  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/agg-common/reduction.hpp"
+#include "apps/agg-common/agg-name.hpp"
+#include "apps/agg-common/preallocated-data.hpp"
+
+#include "../../tests-common.hpp"
+
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(AppsAggCommonReduction)
+
+BOOST_AUTO_TEST_CASE(ParseNames)
+{
+  for (ReduceOp op : {ReduceOp::SUM, ReduceOp::MAX, ReduceOp::MIN, ReduceOp::MEAN, ReduceOp::TOP_K,
+                      ReduceOp::BIT_OR}) {
+    ReduceOp parsed = ReduceOp::SUM;
+    BOOST_CHECK(ParseReduceOp(ReduceOpName(op), parsed));
+    BOOST_CHECK(parsed == op);
+  }
+  ReduceOp parsed = ReduceOp::MAX;
+  BOOST_CHECK(!ParseReduceOp("median", parsed));
+  BOOST_CHECK(parsed == ReduceOp::MAX);
+}
+
+BOOST_AUTO_TEST_CASE(Scalar)
+{
+  const std::vector<int> values = {4, -2, 9, 5};
+  auto reduce = [&values] (ReduceOp op) {
+    Reducer<int> reducer(op);
+    int acc = reducer.Identity();
+    for (int v : values) {
+      acc = reducer.Combine(acc, v);
+    }
+    return reducer.Finalize(acc, values.size());
+  };
+  BOOST_CHECK_EQUAL(reduce(ReduceOp::SUM), 16);
+  BOOST_CHECK_EQUAL(reduce(ReduceOp::MAX), 9);
+  BOOST_CHECK_EQUAL(reduce(ReduceOp::MIN), -2);
+  BOOST_CHECK_EQUAL(reduce(ReduceOp::MEAN), 4);
+  BOOST_CHECK_EQUAL(reduce(ReduceOp::TOP_K), 9);
+
+  Reducer<uint64_t> bitOr(ReduceOp::BIT_OR);
+  BOOST_CHECK_EQUAL(bitOr.Combine(bitOr.Combine(bitOr.Identity(), 0x5), 0x30), 0x35);
+  BOOST_CHECK(Reducer<uint64_t>::Supports(ReduceOp::BIT_OR));
+  BOOST_CHECK(!Reducer<float>::Supports(ReduceOp::BIT_OR));
+}
+
+BOOST_AUTO_TEST_CASE(ElementWiseUnaligned)
+{
+  // Aggregates live in Data wires, at any offset
+  std::vector<uint8_t> acc(1 + 3 * sizeof(int32_t));
+  std::vector<uint8_t> in(1 + 3 * sizeof(int32_t));
+  Reducer<int32_t> reducer(ReduceOp::MIN);
+  reducer.Fill(acc.data() + 1, 3);
+
+  int32_t a[] = {7, -1, 3};
+  int32_t b[] = {2, 4};
+  std::memcpy(in.data() + 1, a, sizeof(a));
+  reducer.Combine(acc.data() + 1, 3, in.data() + 1, 3);
+  std::memcpy(in.data() + 1, b, sizeof(b));
+  // a shorter contribution only touches its own elements
+  reducer.Combine(acc.data() + 1, 3, in.data() + 1, 2);
+
+  int32_t out[3];
+  std::memcpy(out, acc.data() + 1, sizeof(out));
+  BOOST_CHECK_EQUAL(out[0], 2);
+  BOOST_CHECK_EQUAL(out[1], -1);
+  BOOST_CHECK_EQUAL(out[2], 3);
+
+  Reducer<int32_t> mean(ReduceOp::MEAN);
+  int32_t sums[] = {10, -6};
+  mean.Finalize(reinterpret_cast<uint8_t*>(sums), 2, 2);
+  BOOST_CHECK_EQUAL(sums[0], 5);
+  BOOST_CHECK_EQUAL(sums[1], -3);
+}
+
+BOOST_AUTO_TEST_CASE(MeanOfUnbalancedTree)
+{
+  // The root has an aggregator over leaves {2, 4, 6} and one leaf of its own, 20: the mean is
+  // 32 / 4 = 8, where a mean of the children's means would be (4 + 20) / 2 = 12
+  Reducer<int> reducer(ReduceOp::MEAN);
+  BOOST_REQUIRE(reducer.CountsContributions());
+
+  int sum = reducer.Identity();
+  uint32_t contributions = 0;
+  for (int leaf : {2, 4, 6}) {
+    sum = reducer.Combine(sum, leaf);
+    contributions += 1;
+  }
+
+  // The aggregator sends the sum upstream, unfinalized, with its count
+  PreallocatedData wire;
+  wire.Prepare("/agg/1", time::seconds(1), sizeof(int), AGG_TLV_CONTRIBUTIONS);
+  std::memcpy(wire.Content(), &sum, sizeof(sum));
+  wire.SetAppMetaInfo(contributions);
+  auto aggregate = wire.Finalize();
+  auto leaf = make_shared<Data>("/leaf/1");
+  leaf->setContent(std::vector<uint8_t>(sizeof(int)));
+  BOOST_CHECK_EQUAL(ReadContributions(*aggregate), 3);
+  BOOST_CHECK_EQUAL(ReadContributions(*leaf), 1);
+
+  int rootSum = reducer.Identity();
+  uint32_t rootContributions = 0;
+  int received;
+  std::memcpy(&received, aggregate->getContent().value(), sizeof(received));
+  rootSum = reducer.Combine(rootSum, received);
+  rootContributions += ReadContributions(*aggregate);
+  rootSum = reducer.Combine(rootSum, 20);
+  rootContributions += ReadContributions(*leaf);
+  BOOST_CHECK_EQUAL(reducer.Finalize(rootSum, rootContributions), 8);
+
+  // Other operators carry no count and report the same value at every level
+  BOOST_CHECK(!Reducer<int>(ReduceOp::SUM).CountsContributions());
+  BOOST_CHECK_EQUAL(Reducer<int>(ReduceOp::MAX).Finalize(20, 4), 20);
+}
+
+BOOST_AUTO_TEST_CASE(TopK)
+{
+  Reducer<int32_t> reducer(ReduceOp::TOP_K);
+  int32_t acc[3];
+  reducer.Fill(reinterpret_cast<uint8_t*>(acc), 3);
+
+  int32_t first[] = {5, 1, 8, 2};
+  int32_t second[] = {7, 9};
+  reducer.Combine(reinterpret_cast<uint8_t*>(acc), 3, reinterpret_cast<const uint8_t*>(first), 4);
+  reducer.Combine(reinterpret_cast<uint8_t*>(acc), 3, reinterpret_cast<const uint8_t*>(second), 2);
+  BOOST_CHECK_EQUAL(acc[0], 9);
+  BOOST_CHECK_EQUAL(acc[1], 8);
+  BOOST_CHECK_EQUAL(acc[2], 7);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
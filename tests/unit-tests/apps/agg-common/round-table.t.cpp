@@ -0,0 +1,129 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2025  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/agg-common/round-table.hpp"
+#include "apps/agg-common/child-bitmap.hpp"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(AppsAggCommonRoundTable)
+
+struct TestRound
+{
+  int value = 0;
+  ChildBitmap children;
+};
+
+BOOST_AUTO_TEST_CASE(CapacityIsPowerOfTwo)
+{
+  RoundTable<TestRound> table(100);
+  BOOST_CHECK_EQUAL(table.Capacity(), 128);
+  table.Reset(0);
+  BOOST_CHECK_EQUAL(table.Capacity(), 1);
+  table.Reset(64);
+  BOOST_CHECK_EQUAL(table.Capacity(), 64);
+}
+
+BOOST_AUTO_TEST_CASE(InsertFindErase)
+{
+  RoundTable<TestRound> table(4);
+  BOOST_CHECK(table.Empty());
+  BOOST_CHECK(table.Find(1) == nullptr);
+
+  TestRound* round = table.Insert(1);
+  BOOST_REQUIRE(round != nullptr);
+  round->value = 10;
+  BOOST_CHECK_EQUAL(table.Size(), 1);
+  BOOST_CHECK(table.Insert(1) == nullptr); // already active
+  BOOST_REQUIRE(table.Find(1) != nullptr);
+  BOOST_CHECK_EQUAL(table.Find(1)->value, 10);
+
+  // seq 5 maps to the same slot as seq 1: the generation tag keeps them apart
+  BOOST_CHECK(table.Find(5) == nullptr);
+  BOOST_CHECK(!table.CanInsert(5));
+  BOOST_CHECK(table.Insert(5) == nullptr);
+  BOOST_CHECK(!table.Erase(5));
+
+  BOOST_CHECK(table.Erase(1));
+  BOOST_CHECK(!table.Erase(1));
+  BOOST_CHECK(table.Find(1) == nullptr);
+  BOOST_CHECK(table.Empty());
+
+  round = table.Insert(5);
+  BOOST_REQUIRE(round != nullptr);
+  BOOST_CHECK_EQUAL(round->value, 0); // re-initialized from the prototype
+  BOOST_CHECK(table.Find(1) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(PrototypeAndForEach)
+{
+  TestRound prototype;
+  prototype.children.Resize(130);
+  RoundTable<TestRound> table(8, prototype);
+
+  for (uint64_t seq = 10; seq < 14; ++seq) {
+    TestRound* round = table.Insert(seq);
+    BOOST_REQUIRE(round != nullptr);
+    BOOST_CHECK_EQUAL(round->children.Size(), 130);
+    round->value = static_cast<int>(seq);
+  }
+  table.Erase(11);
+
+  uint64_t sum = 0;
+  size_t count = 0;
+  table.ForEach([&] (uint64_t seq, TestRound& round) {
+    BOOST_CHECK_EQUAL(static_cast<uint64_t>(round.value), seq);
+    sum += seq;
+    ++count;
+  });
+  BOOST_CHECK_EQUAL(count, 3);
+  BOOST_CHECK_EQUAL(sum, 10 + 12 + 13);
+
+  table.Clear();
+  BOOST_CHECK(table.Empty());
+  BOOST_CHECK(table.Find(10) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(Bitmap)
+{
+  ChildBitmap bitmap(130);
+  BOOST_CHECK_EQUAL(bitmap.Count(), 0);
+  BOOST_CHECK(bitmap.Set(0));
+  BOOST_CHECK(bitmap.Set(64));
+  BOOST_CHECK(bitmap.Set(129));
+  BOOST_CHECK(!bitmap.Set(64)); // duplicate
+  BOOST_CHECK(bitmap.Test(129));
+  BOOST_CHECK(!bitmap.Test(128));
+  BOOST_CHECK_EQUAL(bitmap.Count(), 3);
+  bitmap.Reset(64);
+  BOOST_CHECK(!bitmap.Test(64));
+  BOOST_CHECK_EQUAL(bitmap.Count(), 2);
+  BOOST_CHECK(bitmap.Set(64));
+  bitmap.Clear();
+  BOOST_CHECK_EQUAL(bitmap.Count(), 0);
+  BOOST_CHECK_EQUAL(bitmap.Size(), 130);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,131 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2025  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/agg-mini/buffer/AggBufferManager.hpp"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class AggBufferManagerFixture : public CleanupFixture
+{
+public:
+  void
+  onTimeout(uint32_t seq)
+  {
+    timedOut.push_back(seq);
+  }
+
+  bool
+  insert(AggBufferManager& mgr, uint32_t seq, size_t payloadSize)
+  {
+    return mgr.Insert(seq, Name("/agg").appendSequenceNumber(seq), 2, payloadSize,
+                      MakeCallback(&AggBufferManagerFixture::onTimeout, this));
+  }
+
+public:
+  std::vector<uint32_t> timedOut;
+};
+
+BOOST_FIXTURE_TEST_SUITE(AppsAggMiniAggBufferManager, AggBufferManagerFixture)
+
+BOOST_AUTO_TEST_CASE(MemoryBudget)
+{
+  // Room for three 16-byte aggregates, though the table holds eight rounds
+  AggBufferManager mgr(8, Seconds(1), 48);
+  BOOST_CHECK_EQUAL(mgr.GetMemoryBudget(), 48);
+  BOOST_CHECK(insert(mgr, 1, 16));
+  BOOST_CHECK(insert(mgr, 2, 16));
+  BOOST_CHECK_EQUAL(mgr.GetBytesInUse(), 32);
+
+  // A payload is held in whole ints: 5 bytes take 8
+  BOOST_CHECK(mgr.CanInsert(16));
+  BOOST_CHECK(insert(mgr, 3, 5));
+  BOOST_CHECK_EQUAL(mgr.GetBytesInUse(), 40);
+  BOOST_CHECK(!mgr.CanInsert(16));
+  BOOST_CHECK(!insert(mgr, 4, 16));
+  BOOST_CHECK(mgr.CanInsert(8));
+
+  // Refused inserts (over budget, duplicate seq) hold nothing
+  BOOST_CHECK(!insert(mgr, 2, 4));
+  BOOST_CHECK_EQUAL(mgr.GetBytesInUse(), 40);
+  BOOST_CHECK(!mgr.Contains(4));
+
+  // A completed round gives its bytes back
+  mgr.Remove(1);
+  BOOST_CHECK_EQUAL(mgr.GetBytesInUse(), 24);
+  BOOST_CHECK(insert(mgr, 4, 16));
+  BOOST_CHECK_EQUAL(mgr.GetBytesInUse(), 40);
+
+  // Removing an unknown seq changes nothing
+  mgr.Remove(1);
+  BOOST_CHECK_EQUAL(mgr.GetBytesInUse(), 40);
+
+  mgr.Remove(2);
+  mgr.Remove(3);
+  mgr.Remove(4);
+  BOOST_CHECK_EQUAL(mgr.GetBytesInUse(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(EvictOldest)
+{
+  AggBufferManager mgr(8, Seconds(10), 32);
+  Simulator::Schedule(Seconds(0.1), [&] { insert(mgr, 7, 16); });
+  Simulator::Schedule(Seconds(0.2), [&] { insert(mgr, 3, 16); });
+  Simulator::Run();
+  BOOST_CHECK(!mgr.CanInsert(16));
+
+  // Evicting the oldest round, as the Evict overflow policy does, frees exactly its bytes
+  uint32_t oldest = 0;
+  BOOST_REQUIRE(mgr.FindOldest(oldest));
+  BOOST_CHECK_EQUAL(oldest, 7);
+  mgr.Remove(oldest);
+  BOOST_CHECK_EQUAL(mgr.GetBytesInUse(), 16);
+  BOOST_CHECK(mgr.CanInsert(16));
+  BOOST_REQUIRE(mgr.FindOldest(oldest));
+  BOOST_CHECK_EQUAL(oldest, 3);
+  mgr.Remove(oldest);
+  BOOST_CHECK(!mgr.FindOldest(oldest));
+  BOOST_CHECK_EQUAL(mgr.GetBytesInUse(), 0);
+
+  // Their timeouts were cancelled with them
+  BOOST_CHECK(timedOut.empty());
+}
+
+BOOST_AUTO_TEST_CASE(Timeout)
+{
+  AggBufferManager mgr(4, Seconds(1), 0);
+  BOOST_CHECK(insert(mgr, 1, 4));
+  BOOST_CHECK(insert(mgr, 2, 4));
+  mgr.Remove(2);
+  Simulator::Run();
+
+  // Only the round still buffered times out; the app then removes it and its bytes
+  BOOST_REQUIRE_EQUAL(timedOut.size(), 1);
+  BOOST_CHECK_EQUAL(timedOut[0], 1);
+  BOOST_CHECK_EQUAL(mgr.GetBytesInUse(), 4);
+  mgr.Remove(1);
+  BOOST_CHECK_EQUAL(mgr.GetBytesInUse(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
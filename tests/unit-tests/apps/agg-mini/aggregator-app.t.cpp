@@ -0,0 +1,193 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2025  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/agg-mini/aggregator/AggregatorApp.hpp"
+#include "apps/ndn-app.hpp"
+#include "helper/ndn-scenario-helper.hpp"
+
+#include "ns3/point-to-point-module.h"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class AggMiniOverflowFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  AggMiniOverflowFixture()
+  {
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("1ms"));
+    Config::SetDefault("ns3::DropTailQueue<Packet>::MaxSize", StringValue("500p"));
+  }
+
+  // Root asks for 5 rounds at once; Agg holds one round at a time, and its leaves are 50ms away,
+  // so rounds 1-4 arrive while round 0 is still buffered
+  void
+  run(const std::string& policy)
+  {
+    createTopology({
+        {"Root", "Agg"},
+        {"Agg", "Leaf1"},
+        {"Agg", "Leaf2"},
+      });
+    getNetDevice("Agg", "Leaf1")->GetChannel()->SetAttribute("Delay", StringValue("50ms"));
+    getNetDevice("Agg", "Leaf2")->GetChannel()->SetAttribute("Delay", StringValue("50ms"));
+
+    addRoutes({
+        {"Root", "Agg", "/app/agg", 1},
+        {"Agg", "Leaf1", "/app/Leaf1", 1},
+        {"Agg", "Leaf2", "/app/Leaf2", 1},
+      });
+
+    addApps({
+        {"Leaf1", "ns3::ndn::LeafApp", {{"Prefix", "/app/Leaf1"}, {"PayloadSize", "4"}}, "0s", "10s"},
+        {"Leaf2", "ns3::ndn::LeafApp", {{"Prefix", "/app/Leaf2"}, {"PayloadSize", "4"}}, "0s", "10s"},
+        {"Agg", "ns3::ndn::AggregatorApp",
+            {{"Prefix", "/app/agg"}, {"ChildPrefixes", "/app/Leaf1 /app/Leaf2"},
+             {"BufferCapacity", "1"}, {"StragglerTimeout", "1s"}, {"OverflowPolicy", policy}},
+            "0s", "10s"},
+        {"Root", "ns3::ndn::RootApp", {{"Prefix", "/app/agg"}, {"MaxSeq", "5"}}, "0.1s", "10s"},
+      });
+
+    // Before any Interest could be retransmitted or a straggler timeout fire
+    Simulator::Stop(Seconds(0.8));
+    Simulator::Run();
+  }
+
+  uint64_t
+  leafInterests(const std::string& leaf)
+  {
+    return getFace(leaf, "Agg")->getCounters().nInInterests;
+  }
+
+  void
+  onRootData(shared_ptr<const Data> data, Ptr<App>, shared_ptr<Face>)
+  {
+    rootContentTypes.push_back(data->getContentType());
+  }
+
+public:
+  std::vector<uint32_t> rootContentTypes;
+};
+
+BOOST_FIXTURE_TEST_SUITE(AppsAggMiniAggregatorApp, AggMiniOverflowFixture)
+
+BOOST_AUTO_TEST_CASE(Drop)
+{
+  run("Drop");
+
+  // Only round 0 is aggregated; the others are neither answered nor forwarded
+  BOOST_CHECK_EQUAL(leafInterests("Leaf1"), 1);
+  BOOST_CHECK_EQUAL(leafInterests("Leaf2"), 1);
+  BOOST_CHECK_EQUAL(getFace("Root", "Agg")->getCounters().nInData, 1);
+  BOOST_CHECK_EQUAL(getFace("Root", "Agg")->getCounters().nInNacks, 0);
+}
+
+BOOST_AUTO_TEST_CASE(Nack)
+{
+  run("Nack");
+
+  BOOST_CHECK_EQUAL(leafInterests("Leaf1"), 1);
+  BOOST_CHECK_EQUAL(getFace("Root", "Agg")->getCounters().nInData, 1);
+  BOOST_CHECK_EQUAL(getFace("Root", "Agg")->getCounters().nInNacks, 4);
+}
+
+BOOST_AUTO_TEST_CASE(Evict)
+{
+  run("Evict");
+
+  // Each new round pushes the previous one up early (partial, here empty); all 5 are answered
+  BOOST_CHECK_EQUAL(leafInterests("Leaf1"), 5);
+  BOOST_CHECK_EQUAL(leafInterests("Leaf2"), 5);
+  BOOST_CHECK_EQUAL(getFace("Root", "Agg")->getCounters().nInData, 5);
+  BOOST_CHECK_EQUAL(getFace("Root", "Agg")->getCounters().nInNacks, 0);
+}
+
+BOOST_AUTO_TEST_CASE(Bypass)
+{
+  run("Bypass");
+
+  // Round 0 is aggregated; rounds 1-4 come back as Links and Root fetches their leaf Data
+  // itself, through Agg's node but not its app
+  BOOST_CHECK_EQUAL(leafInterests("Leaf1"), 5);
+  BOOST_CHECK_EQUAL(leafInterests("Leaf2"), 5);
+  BOOST_CHECK_EQUAL(getFace("Root", "Agg")->getCounters().nInData, 1 + 4 + 4 * 2);
+  BOOST_CHECK_EQUAL(getFace("Root", "Agg")->getCounters().nInNacks, 0);
+}
+
+BOOST_AUTO_TEST_CASE(BypassBelowAggregator)
+{
+  // Mid holds one round at a time and bypasses the rest to Top, which must still aggregate them
+  createTopology({
+      {"Root", "Top"},
+      {"Top", "Mid"},
+      {"Top", "Leaf3"},
+      {"Mid", "Leaf1"},
+      {"Mid", "Leaf2"},
+    });
+  getNetDevice("Mid", "Leaf1")->GetChannel()->SetAttribute("Delay", StringValue("50ms"));
+  getNetDevice("Mid", "Leaf2")->GetChannel()->SetAttribute("Delay", StringValue("50ms"));
+
+  addRoutes({
+      {"Root", "Top", "/app/top", 1},
+      {"Top", "Mid", "/app/mid", 1},
+      {"Top", "Leaf3", "/app/Leaf3", 1},
+      {"Mid", "Leaf1", "/app/Leaf1", 1},
+      {"Mid", "Leaf2", "/app/Leaf2", 1},
+    });
+
+  addApps({
+      {"Leaf1", "ns3::ndn::LeafApp", {{"Prefix", "/app/Leaf1"}, {"PayloadSize", "4"}}, "0s", "10s"},
+      {"Leaf2", "ns3::ndn::LeafApp", {{"Prefix", "/app/Leaf2"}, {"PayloadSize", "4"}}, "0s", "10s"},
+      {"Leaf3", "ns3::ndn::LeafApp", {{"Prefix", "/app/Leaf3"}, {"PayloadSize", "4"}}, "0s", "10s"},
+      {"Mid", "ns3::ndn::AggregatorApp",
+          {{"Prefix", "/app/mid"}, {"ChildPrefixes", "/app/Leaf1 /app/Leaf2"},
+           {"BufferCapacity", "1"}, {"StragglerTimeout", "1s"}, {"OverflowPolicy", "Bypass"}},
+          "0s", "10s"},
+      {"Top", "ns3::ndn::AggregatorApp",
+          {{"Prefix", "/app/top"}, {"ChildPrefixes", "/app/mid /app/Leaf3"},
+           {"BufferCapacity", "10"}, {"StragglerTimeout", "1s"}},
+          "0s", "10s"},
+      {"Root", "ns3::ndn::RootApp", {{"Prefix", "/app/top"}, {"MaxSeq", "5"}}, "0.1s", "10s"},
+    });
+
+  getNode("Root")->GetApplication(0)->TraceConnectWithoutContext("ReceivedDatas",
+    MakeCallback(&AggMiniOverflowFixture::onRootData, this));
+
+  Simulator::Stop(Seconds(0.8));
+  Simulator::Run();
+
+  // Top fetched the leaves of the 4 bypassed rounds itself, through Mid's node but not its app...
+  BOOST_CHECK_EQUAL(getFace("Leaf1", "Mid")->getCounters().nInInterests, 5);
+  BOOST_CHECK_EQUAL(getFace("Leaf2", "Mid")->getCounters().nInInterests, 5);
+  BOOST_CHECK_EQUAL(getFace("Top", "Mid")->getCounters().nInData, 1 + 4 + 4 * 2);
+
+  // ...and answered every round with a complete aggregate, not a Link folded into the sum
+  BOOST_REQUIRE_EQUAL(rootContentTypes.size(), 5);
+  for (uint32_t type : rootContentTypes) {
+    BOOST_CHECK_NE(type, ::ndn::tlv::ContentType_Link);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
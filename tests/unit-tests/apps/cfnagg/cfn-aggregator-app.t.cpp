@@ -0,0 +1,238 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2025  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/cfnagg/cfn-aggregator-app.hpp"
+#include "apps/ndn-app.hpp"
+#include "helper/ndn-scenario-helper.hpp"
+#include "model/ndn-l3-protocol.hpp"
+
+#include "ns3/point-to-point-module.h"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class CfnAggregatorAppFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  CfnAggregatorAppFixture()
+  {
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("1ms"));
+    Config::SetDefault("ns3::DropTailQueue<Packet>::MaxSize", StringValue("500p"));
+
+    // C asks aggregator A, which combines producers P1 and P2
+    createTopology({
+        {"C", "A"},
+        {"A", "P1"},
+        {"A", "P2"},
+      });
+
+    addRoutes({
+        {"C", "A", "/A", 1},
+        {"A", "P1", "/P1", 1},
+        {"A", "P2", "/P2", 1},
+      });
+  }
+
+  Ptr<CFNAggregatorApp>
+  installAggregator()
+  {
+    Ptr<CFNAggregatorApp> aggregator = CreateObject<CFNAggregatorApp>();
+    aggregator->SetAttribute("Prefix", StringValue("/A"));
+    aggregator->SetStartTime(Seconds(0));
+    aggregator->SetStopTime(Seconds(10));
+    getNode("A")->AddApplication(aggregator);
+    return aggregator;
+  }
+
+  // Run 4 rounds, 10ms apart, through an aggregator that keeps one round in flight per child
+  void
+  run(const std::string& timeoutMode)
+  {
+    getNetDevice("A", "P2")->GetChannel()->SetAttribute("Delay", StringValue("40ms"));
+    addApps({
+        {"P1", "ns3::CFNProducerApp", {{"Prefix", "/P1"}, {"Value", "3"}}, "0s", "10s"},
+        {"P2", "ns3::CFNProducerApp", {{"Prefix", "/P2"}, {"Value", "4"}}, "0s", "10s"},
+        {"C", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/A"}, {"Frequency", "100"}, {"MaxSeq", "4"}},
+            "0.1s", "10s"},
+      });
+
+    Ptr<CFNAggregatorApp> aggregator = installAggregator();
+    aggregator->SetAttribute("ChildTimeout", DoubleValue(0.1));
+    aggregator->SetAttribute("TimeoutMode", StringValue(timeoutMode));
+    aggregator->SetAttribute("MaxPipelinedRounds", UintegerValue(1));
+    aggregator->SetChildren({"P1", "P2"});
+
+    getNode("C")->GetApplication(0)->TraceConnectWithoutContext("ReceivedDatas",
+      MakeCallback(&CfnAggregatorAppFixture::onData, this));
+
+    Simulator::Stop(Seconds(2.0));
+    Simulator::Run();
+  }
+
+  void
+  onData(shared_ptr<const Data> data, Ptr<App>, shared_ptr<Face>)
+  {
+    const Block& content = data->getContent();
+    uint64_t value = 0;
+    for (size_t i = 0; i < std::min<size_t>(content.value_size(), 8); ++i) {
+      value = (value << 8) | content.value()[i];
+    }
+    values.push_back(value);
+    lastData = Simulator::Now();
+  }
+
+  void
+  checkRounds()
+  {
+    // P2 (40ms away) answers one round per 80ms round trip: the later rounds wait in its window...
+    BOOST_CHECK_EQUAL(getFace("P2", "A")->getCounters().nInInterests, 4);
+    BOOST_CHECK_GE(lastData, Seconds(0.1 + 4 * 0.08));
+
+    // ...and still get P2's value, though they were admitted longer than ChildTimeout before
+    BOOST_REQUIRE_EQUAL(values.size(), 4);
+    for (uint64_t value : values) {
+      BOOST_CHECK_EQUAL(value, 7);
+    }
+  }
+
+public:
+  std::vector<uint64_t> values;
+  Time lastData;
+};
+
+BOOST_FIXTURE_TEST_SUITE(AppsCfnaggAggregatorApp, CfnAggregatorAppFixture)
+
+BOOST_AUTO_TEST_CASE(FixedTimeoutCountsFromRequest)
+{
+  run("fixed");
+  checkRounds();
+}
+
+BOOST_AUTO_TEST_CASE(AdaptiveTimeoutCountsFromRequest)
+{
+  run("adaptive");
+  checkRounds();
+}
+
+BOOST_AUTO_TEST_CASE(LateDeltaKeepsChildInterestPending)
+{
+  // P2 answers 160ms after its request: past the 100ms straggler deadline, within the late-delta
+  // window
+  getNetDevice("A", "P2")->GetChannel()->SetAttribute("Delay", StringValue("80ms"));
+  addApps({
+      {"P1", "ns3::CFNProducerApp", {{"Prefix", "/P1"}, {"Value", "3"}}, "0s", "10s"},
+      {"P2", "ns3::CFNProducerApp", {{"Prefix", "/P2"}, {"Value", "4"}}, "0s", "10s"},
+      {"C", "ns3::ndn::ConsumerCbr", {{"Prefix", "/A"}, {"MaxSeq", "1"}}, "0.1s", "10s"},
+    });
+
+  Ptr<CFNAggregatorApp> aggregator = installAggregator();
+  aggregator->SetAttribute("ChildTimeout", DoubleValue(0.1));
+  aggregator->SetAttribute("LateDelta", BooleanValue(true));
+  aggregator->SetAttribute("LateDeltaWindow", DoubleValue(1.0));
+  aggregator->SetChildren({"P1", "P2"});
+
+  getNode("C")->GetApplication(0)->TraceConnectWithoutContext("ReceivedDatas",
+    MakeCallback(&CfnAggregatorAppFixture::onData, this));
+
+  Simulator::Stop(Seconds(1.0));
+  Simulator::Run();
+
+  // The parent got the partial result at the deadline...
+  BOOST_REQUIRE_EQUAL(values.size(), 1);
+  BOOST_CHECK_EQUAL(values[0], 3);
+  BOOST_CHECK_LT(lastData, Seconds(0.25));
+
+  // ...and P2's late reply still matched the aggregator's Interest instead of being unsolicited
+  BOOST_CHECK_EQUAL(getFace("A", "P2")->getCounters().nInData, 1);
+  const auto& counters = getNode("A")->GetObject<L3Protocol>()->getForwarder()->getCounters();
+  BOOST_CHECK_EQUAL(counters.nUnsolicitedData, 0);
+}
+
+BOOST_AUTO_TEST_CASE(StragglerWaitEndsWithParentInterest)
+{
+  // P2 never answers in time, and each round asks it only after the previous one gave up on it:
+  // counted from those requests, round k would wait until 0.1 + (k + 1) * 0.4s
+  getNetDevice("A", "P2")->GetChannel()->SetAttribute("Delay", StringValue("1s"));
+  addApps({
+      {"P1", "ns3::CFNProducerApp", {{"Prefix", "/P1"}, {"Value", "3"}}, "0s", "10s"},
+      {"P2", "ns3::CFNProducerApp", {{"Prefix", "/P2"}, {"Value", "4"}}, "0s", "10s"},
+      {"C", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/A"}, {"Frequency", "100"}, {"MaxSeq", "4"}, {"LifeTime", "600ms"}},
+          "0.1s", "10s"},
+    });
+
+  Ptr<CFNAggregatorApp> aggregator = installAggregator();
+  aggregator->SetAttribute("ChildTimeout", DoubleValue(0.4));
+  aggregator->SetAttribute("MaxPipelinedRounds", UintegerValue(1));
+  aggregator->SetChildren({"P1", "P2"});
+
+  aggregator->TraceConnectWithoutContext("TransmittedDatas",
+    MakeCallback(&CfnAggregatorAppFixture::onData, this));
+
+  Simulator::Stop(Seconds(0.8));
+  Simulator::Run();
+
+  // Every round went up with P1's value while C's Interest was still pending at A (it arrives
+  // there by 0.14s and lives 600ms)
+  BOOST_REQUIRE_EQUAL(values.size(), 4);
+  for (uint64_t value : values) {
+    BOOST_CHECK_EQUAL(value, 3);
+  }
+  BOOST_CHECK_LT(lastData, Seconds(0.14 + 0.6));
+}
+
+BOOST_AUTO_TEST_CASE(DrrSharesRoundsByWeightAndFanIn)
+{
+  // Job 1 (weight 2) aggregates P1 alone, job 2 (weight 1) both producers; the node aggregates one
+  // round at a time, and both parents ask for far more rounds than it can serve
+  addApps({
+      {"P1", "ns3::CFNProducerApp", {{"Prefix", "/P1"}}, "0s", "10s"},
+      {"P2", "ns3::CFNProducerApp", {{"Prefix", "/P2"}}, "0s", "10s"},
+      {"C", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/A/252=%01"}, {"Frequency", "500"}, {"RetxTimer", "100s"}},
+          "0.1s", "1.1s"},
+      {"C", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/A/252=%02"}, {"Frequency", "500"}, {"RetxTimer", "100s"}},
+          "0.1s", "1.1s"},
+    });
+
+  Ptr<CFNAggregatorApp> aggregator = installAggregator();
+  aggregator->SetAttribute("MaxNodeRounds", UintegerValue(1));
+  aggregator->AddJob(1, {"P1"}, 2.0);
+  aggregator->AddJob(2, {"P1", "P2"}, 1.0);
+
+  Simulator::Stop(Seconds(1.1));
+  Simulator::Run();
+
+  // Credit is weight * cost units, a round costs its fan-in: job 1 admits 2 * 2 = 4 rounds per
+  // round of job 2
+  double job2Rounds = getFace("P2", "A")->getCounters().nInInterests;
+  double job1Rounds = getFace("P1", "A")->getCounters().nInInterests - job2Rounds;
+  BOOST_REQUIRE_GT(job2Rounds, 20);
+  BOOST_CHECK_CLOSE(job1Rounds / job2Rounds, 4.0, 10.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
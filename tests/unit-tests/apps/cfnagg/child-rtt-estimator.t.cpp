@@ -0,0 +1,88 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2025  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/cfnagg/child-rtt-estimator.hpp"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(AppsCfnaggChildRttEstimator)
+
+BOOST_AUTO_TEST_CASE(NormalQuantiles)
+{
+  BOOST_CHECK_SMALL(NormalQuantile(0.5), 1e-9);
+  BOOST_CHECK_CLOSE(NormalQuantile(0.9), 1.281552, 1e-3);
+  BOOST_CHECK_CLOSE(NormalQuantile(0.99), 2.326348, 1e-3);
+  BOOST_CHECK_CLOSE(NormalQuantile(0.01), -2.326348, 1e-3);
+}
+
+BOOST_AUTO_TEST_CASE(DeadlineFollowsSlowestChild)
+{
+  ChildRttEstimator rtt;
+  rtt.Reset(2, 0.99);
+  BOOST_CHECK(!rtt.HasSamples(0));
+  // No samples yet: the fixed timeout applies
+  BOOST_CHECK_EQUAL(rtt.Deadline(0.0001, 1.0), 1.0);
+
+  for (int i = 0; i < 50; ++i) {
+    rtt.AddSample(0, 0.0002);
+    rtt.AddSample(1, i % 2 ? 0.004 : 0.006);
+  }
+  BOOST_CHECK(rtt.HasSamples(1));
+  BOOST_CHECK_LT(rtt.ChildDeadline(0, 1.0), 0.0003);
+  double slow = rtt.ChildDeadline(1, 1.0);
+  BOOST_CHECK_GT(slow, 0.006);
+  BOOST_CHECK_LT(slow, 0.01);
+  BOOST_CHECK_EQUAL(rtt.Deadline(0.0001, 1.0), slow);
+
+  // Clamped to the configured range
+  BOOST_CHECK_EQUAL(rtt.Deadline(0.05, 1.0), 0.05);
+  BOOST_CHECK_EQUAL(rtt.Deadline(0.0001, 0.005), 0.005);
+
+  // A lower quantile gives a tighter deadline
+  ChildRttEstimator median;
+  median.Reset(1, 0.5);
+  for (int i = 0; i < 50; ++i) {
+    median.AddSample(0, i % 2 ? 0.004 : 0.006);
+  }
+  BOOST_CHECK_LT(median.ChildDeadline(0, 1.0), slow);
+}
+
+BOOST_AUTO_TEST_CASE(TimeoutsRaiseDeadline)
+{
+  ChildRttEstimator rtt;
+  rtt.Reset(2, 0.9);
+  rtt.AddSample(0, 0.001);
+  rtt.AddSample(1, 0.001);
+  double before = rtt.Deadline(0, 1.0);
+
+  ChildBitmap received(2);
+  received.Set(0);
+  rtt.AddTimeouts(received, before);
+  rtt.AddTimeouts(received, before);
+  BOOST_CHECK_GT(rtt.ChildDeadline(1, 1.0), before);
+  BOOST_CHECK_EQUAL(rtt.ChildDeadline(0, 1.0), before);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,87 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2025  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/cfnagg/coded-aggregation.hpp"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(AppsCfnaggCodedAggregation)
+
+BOOST_AUTO_TEST_CASE(Disabled)
+{
+  BOOST_CHECK_EQUAL(CodingGroupCount(8, 0), 0);
+  // Every child would have to hold everything: nothing to decode from
+  BOOST_CHECK_EQUAL(CodingGroupCount(3, 3), 0);
+  BOOST_CHECK_EQUAL(CodingGroupCount(3, 5), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Groups)
+{
+  // 7 children, redundancy 2: groups {0,1,2} and {3,4,5,6}
+  BOOST_REQUIRE_EQUAL(CodingGroupCount(7, 2), 2);
+  std::vector<uint32_t> expected = {0, 0, 0, 1, 1, 1, 1};
+  for (uint32_t i = 0; i < 7; ++i) {
+    BOOST_CHECK_EQUAL(CodingGroupOf(i, 7, 2), expected[i]);
+  }
+  BOOST_CHECK(CodingGroupMembers(0, 7, 2) == std::make_pair(0u, 3u));
+  BOOST_CHECK(CodingGroupMembers(1, 7, 2) == std::make_pair(3u, 7u));
+
+  // s = n - 1: a single group, any one child decodes
+  BOOST_CHECK_EQUAL(CodingGroupCount(4, 3), 1);
+  BOOST_CHECK(CodingGroupMembers(0, 4, 3) == std::make_pair(0u, 4u));
+}
+
+BOOST_AUTO_TEST_CASE(AnySStragglersDecode)
+{
+  // Dropping any s children leaves every group with a member, so the sum of one share per group
+  // (each share the sum of its group's partitions) is the sum of all partitions
+  const uint32_t n = 6;
+  const uint32_t s = 2;
+  std::vector<uint64_t> partition = {3, 5, 7, 11, 13, 17};
+  uint32_t groups = CodingGroupCount(n, s);
+  std::vector<uint64_t> share(n, 0);
+  for (uint32_t i = 0; i < n; ++i) {
+    auto members = CodingGroupMembers(CodingGroupOf(i, n, s), n, s);
+    for (uint32_t j = members.first; j < members.second; ++j) {
+      share[i] += partition[j];
+    }
+  }
+  for (uint32_t a = 0; a < n; ++a) {
+    for (uint32_t b = a + 1; b < n; ++b) {
+      std::vector<bool> covered(groups, false);
+      uint64_t sum = 0;
+      for (uint32_t i = 0; i < n; ++i) {
+        uint32_t g = CodingGroupOf(i, n, s);
+        if (i != a && i != b && !covered[g]) {
+          covered[g] = true;
+          sum += share[i];
+        }
+      }
+      BOOST_CHECK_EQUAL(sum, 3 + 5 + 7 + 11 + 13 + 17);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,171 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2025  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/cfnagg/congestion-control.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+// Window-limited sender over one bottleneck: 1000 requests/s, 10 ms base RTT (BDP = 11 requests),
+// 100-request queue. Data is congestion-marked while more than 'markAbove' requests are queued.
+class BottleneckPath
+{
+public:
+  BottleneckPath(CongestionControl& cc, size_t markAbove = SIZE_MAX)
+    : m_cc(cc)
+    , m_markAbove(markAbove)
+  {
+    Simulator::Schedule(Seconds(0), &BottleneckPath::Tick, this);
+  }
+
+  void
+  Tick()
+  {
+    double now = Simulator::Now().GetSeconds();
+    while (!m_acks.empty() && m_acks.front().first <= now + 1e-9) {
+      DeliverySample sample;
+      sample.rtt = now - m_acks.front().second;
+      sample.bytes = 1000;
+      sample.congestionMarked = m_queue.size() > m_markAbove;
+      m_acks.pop_front();
+      m_inFlight--;
+      m_cc.OnData(sample);
+    }
+    while (m_inFlight < m_cc.GetCwnd()) {
+      if (m_queue.size() >= 100) {
+        m_cc.OnTimeout();
+        break;
+      }
+      m_queue.push_back(now);
+      m_inFlight++;
+    }
+    if (!m_queue.empty() && now >= m_busyUntil - 1e-9) {
+      m_busyUntil = now + 0.001;
+      m_acks.emplace_back(now + 0.011, m_queue.front());
+      m_queue.pop_front();
+    }
+    maxQueue = now > 5 ? std::max(maxQueue, m_queue.size()) : 0;
+    Simulator::Schedule(MicroSeconds(100), &BottleneckPath::Tick, this);
+  }
+
+public:
+  size_t maxQueue = 0;
+
+private:
+  CongestionControl& m_cc;
+  size_t m_markAbove;
+  std::deque<double> m_queue;                     // send times of queued requests
+  std::deque<std::pair<double, double>> m_acks;   // (arrival, send time) of served requests
+  int m_inFlight = 0;
+  double m_busyUntil = 0;
+};
+
+BOOST_FIXTURE_TEST_SUITE(AppsCfnaggCongestionControl, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(AimdHalvesOncePerWindowOnMark)
+{
+  CongestionAIMD aimd;
+  for (int i = 0; i < 7; ++i) {
+    aimd.OnData();
+  }
+  BOOST_CHECK_EQUAL(aimd.GetCwnd(), 8);
+
+  DeliverySample marked;
+  marked.congestionMarked = true;
+  aimd.OnData(marked);
+  BOOST_CHECK_EQUAL(aimd.GetCwnd(), 4);
+  aimd.OnData(marked);
+  BOOST_CHECK_EQUAL(aimd.GetCwnd(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(CubicReducesOncePerRound)
+{
+  CongestionCubic cubic;
+  for (int i = 0; i < 9; ++i) {
+    cubic.OnData();
+  }
+  BOOST_CHECK_EQUAL(cubic.GetCwnd(), 10);
+  cubic.OnTimeout();
+  BOOST_CHECK_EQUAL(cubic.GetCwnd(), 7);
+  cubic.OnTimeout();
+  BOOST_CHECK_EQUAL(cubic.GetCwnd(), 7);
+}
+
+BOOST_AUTO_TEST_CASE(CubicHystartLeavesSlowStart)
+{
+  CongestionCubic cubic;
+  DeliverySample sample;
+  sample.rtt = 0.010;
+  // Rounds of 1, 2, 4 and 8 acks at a steady RTT: plain slow start
+  for (int i = 0; i < 15; ++i) {
+    cubic.OnData(sample);
+  }
+  BOOST_CHECK_EQUAL(cubic.GetCwnd(), 16);
+
+  // The RTT rises by more than the 4 ms threshold: after 8 samples growth slows to 1/4 per ack
+  sample.rtt = 0.020;
+  for (int i = 0; i < 16; ++i) {
+    cubic.OnData(sample);
+  }
+  BOOST_CHECK_EQUAL(cubic.GetCwnd(), 16 + 8 + 2);
+}
+
+BOOST_AUTO_TEST_CASE(BbrConvergesToBdp)
+{
+  CongestionBBR bbr;
+  BottleneckPath path(bbr);
+  Simulator::Stop(Seconds(10));
+  Simulator::Run();
+
+  BOOST_CHECK_GE(bbr.GetCwnd(), 8);
+  BOOST_CHECK_LE(bbr.GetCwnd(), 16);
+  BOOST_CHECK_LE(path.maxQueue, 10);
+}
+
+BOOST_AUTO_TEST_CASE(CubicFillsQueueWithoutMarks)
+{
+  CongestionCubic cubic;
+  BottleneckPath path(cubic);
+  Simulator::Stop(Seconds(10));
+  Simulator::Run();
+
+  BOOST_CHECK_GE(path.maxQueue, 50);
+}
+
+BOOST_AUTO_TEST_CASE(CubicRespondsToMarks)
+{
+  CongestionCubic cubic;
+  BottleneckPath path(cubic, 5);
+  Simulator::Stop(Seconds(10));
+  Simulator::Run();
+
+  BOOST_CHECK_LE(path.maxQueue, 30);
+  BOOST_CHECK_GE(cubic.GetCwnd(), 8);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
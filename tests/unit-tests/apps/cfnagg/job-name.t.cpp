@@ -0,0 +1,66 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2025  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/cfnagg/job-name.hpp"
+#include "apps/cfnagg/late-delta.hpp"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(AppsCfnaggJobName)
+
+BOOST_AUTO_TEST_CASE(SingleJobNamesUnchanged)
+{
+  Name prefix = MakeJobPrefix("Agg1", 0);
+  BOOST_CHECK_EQUAL(prefix, Name("/Agg1"));
+  BOOST_CHECK_EQUAL(ReadJobId(Name(prefix).appendSequenceNumber(5)), 0);
+  BOOST_CHECK_EQUAL(ReadJobId(Name("/Agg1/5")), 0);
+}
+
+BOOST_AUTO_TEST_CASE(JobComponent)
+{
+  Name prefix = MakeJobPrefix("Agg1", 7);
+  BOOST_REQUIRE_EQUAL(prefix.size(), 2);
+  BOOST_CHECK_EQUAL(prefix.get(1).type(), CFN_TLV_JOB_ID);
+
+  Name round = Name(prefix).appendSequenceNumber(42);
+  BOOST_CHECK_EQUAL(ReadJobId(round), 7);
+  uint64_t seq = 0;
+  BOOST_CHECK(ReadRoundNumber(round.get(-1), seq));
+  BOOST_CHECK_EQUAL(seq, 42);
+
+  // Delta names keep the job and the round
+  Name delta = MakeDeltaName(prefix, 42, 3);
+  BOOST_CHECK_EQUAL(ReadJobId(delta), 7);
+  seq = 0;
+  BOOST_CHECK(ParseDeltaName(delta, seq));
+  BOOST_CHECK_EQUAL(seq, 42);
+
+  // A prefix alone (no round) names no job
+  BOOST_CHECK_EQUAL(ReadJobId(prefix), 0);
+  // A generic second component is not a job id
+  BOOST_CHECK_EQUAL(ReadJobId(Name("/Agg1/7/42")), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
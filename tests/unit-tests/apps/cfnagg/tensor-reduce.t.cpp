@@ -0,0 +1,126 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2025  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/cfnagg/tensor-reduce.hpp"
+#include "apps/cfnagg/aggregation-buffer.hpp"
+
+#include <cstring>
+#include <vector>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(AppsCfnaggTensorReduce)
+
+// sizes straddle the 8- and 16-lane SIMD bodies so the scalar tails are exercised too
+static const size_t SIZES[] = {0, 1, 7, 8, 15, 16, 17, 33, 1000};
+
+BOOST_AUTO_TEST_CASE(Int32)
+{
+  for (size_t n : SIZES) {
+    std::vector<int32_t> acc(n, 5), child(n);
+    for (size_t i = 0; i < n; ++i) {
+      child[i] = static_cast<int32_t>(i) - 3;
+    }
+    TensorAccumulate(TensorDType::INT32, acc.data(), reinterpret_cast<const uint8_t*>(child.data()), n);
+    for (size_t i = 0; i < n; ++i) {
+      BOOST_CHECK_EQUAL(acc[i], 2 + static_cast<int32_t>(i));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Int64)
+{
+  for (size_t n : SIZES) {
+    std::vector<int64_t> acc(n, int64_t(1) << 40), child(n, 7);
+    TensorAccumulate(TensorDType::INT64, acc.data(), reinterpret_cast<const uint8_t*>(child.data()), n);
+    for (size_t i = 0; i < n; ++i) {
+      BOOST_CHECK_EQUAL(acc[i], (int64_t(1) << 40) + 7);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Float32)
+{
+  for (size_t n : SIZES) {
+    std::vector<float> acc(n, 0.5f), child(n);
+    for (size_t i = 0; i < n; ++i) {
+      child[i] = static_cast<float>(i);
+    }
+    TensorAccumulate(TensorDType::FLOAT32, acc.data(), reinterpret_cast<const uint8_t*>(child.data()), n);
+    for (size_t i = 0; i < n; ++i) {
+      BOOST_CHECK_EQUAL(acc[i], 0.5f + static_cast<float>(i));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Bf16)
+{
+  for (size_t n : SIZES) {
+    std::vector<float> acc(n, 1.0f);
+    std::vector<uint16_t> child(n, 0x4000); // 2.0
+    TensorAccumulate(TensorDType::BF16, acc.data(), reinterpret_cast<const uint8_t*>(child.data()), n);
+
+    std::vector<uint16_t> out(n);
+    TensorEncode(TensorDType::BF16, acc.data(), reinterpret_cast<uint8_t*>(out.data()), n);
+    for (size_t i = 0; i < n; ++i) {
+      BOOST_CHECK_EQUAL(acc[i], 3.0f);
+      BOOST_CHECK_EQUAL(out[i], 0x4040); // 3.0
+    }
+    BOOST_CHECK_EQUAL(TensorChecksum(TensorDType::BF16, acc.data(), n), 3 * n);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ParseType)
+{
+  TensorDType dtype = TensorDType::INT64;
+  BOOST_CHECK(ParseTensorDType("float32", dtype));
+  BOOST_CHECK(dtype == TensorDType::FLOAT32);
+  BOOST_CHECK(ParseTensorDType("bf16", dtype));
+  BOOST_CHECK(dtype == TensorDType::BF16);
+  BOOST_CHECK(!ParseTensorDType("complex64", dtype));
+  BOOST_CHECK_EQUAL(TensorWireElementSize(TensorDType::BF16), 2);
+  BOOST_CHECK_EQUAL(TensorAccumElementSize(TensorDType::BF16), 4);
+}
+
+BOOST_AUTO_TEST_CASE(BufferGrowsToLongestChild)
+{
+  AggregationBuffer buf(2);
+  buf.EnableTensor(TensorDType::INT32);
+
+  std::vector<int32_t> shortChild = {1, 2};
+  std::vector<int32_t> longChild = {10, 20, 30};
+  buf.AccumulateTensor(reinterpret_cast<const uint8_t*>(shortChild.data()), 8);
+  buf.AccumulateTensor(reinterpret_cast<const uint8_t*>(longChild.data()), 12);
+
+  BOOST_REQUIRE_EQUAL(buf.EncodedTensorSize(), 12);
+  std::vector<int32_t> out(3);
+  buf.EncodeTensor(reinterpret_cast<uint8_t*>(out.data()));
+  BOOST_CHECK_EQUAL(out[0], 11);
+  BOOST_CHECK_EQUAL(out[1], 22);
+  BOOST_CHECK_EQUAL(out[2], 30);
+  BOOST_CHECK_EQUAL(buf.Result(), 63);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,71 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2025  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/cfnagg/trace-collector.hpp"
+
+#include <cstdio>
+#include <fstream>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(AppsCfnaggTraceCollector)
+
+static std::vector<std::string>
+ReadLines(const std::string& filename)
+{
+  std::ifstream file(filename);
+  std::vector<std::string> lines;
+  std::string line;
+  while (std::getline(file, line)) {
+    lines.push_back(line);
+  }
+  return lines;
+}
+
+BOOST_AUTO_TEST_CASE(CsvInTimeOrder)
+{
+  const std::string filename = "trace-collector-test.csv";
+  TraceCollector::Open(filename);
+  TraceCollector::LogInterest("Root", 1, 0.1);
+  TraceCollector::LogData("Agg1", 1, "Prod1", 0.2);
+  TraceCollector::LogInterest("Root", 2, 0.3);
+  TraceCollector::LogAggregate("Agg1", 1, 5, 2, 2);
+  TraceCollector::Close();
+
+  // Lines of different nodes interleave as they were logged, not grouped per node
+  std::vector<std::string> lines = ReadLines(filename);
+  BOOST_REQUIRE_EQUAL(lines.size(), 5);
+  BOOST_CHECK_EQUAL(lines[1].substr(0, 26), "0.100000000,InterestSent,R");
+  BOOST_CHECK_EQUAL(lines[2].substr(0, 26), "0.200000000,DataReceived,A");
+  BOOST_CHECK_EQUAL(lines[3].substr(0, 26), "0.300000000,InterestSent,R");
+  BOOST_CHECK(lines[4].find(",AggregateComplete,Agg1,1,") != std::string::npos);
+
+  // Close forgets the names: the next trace numbers its nodes from scratch
+  BOOST_CHECK_EQUAL(TraceCollector::Intern("Prod1"), 0);
+  TraceCollector::Close();
+  std::remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
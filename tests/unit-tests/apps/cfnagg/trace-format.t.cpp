@@ -0,0 +1,98 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2025  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/cfnagg/trace-format.hpp"
+
+#include <sstream>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(AppsCfnaggTraceFormat)
+
+static TraceRecord
+MakeRecord(TraceEvent event, uint64_t timeNs, uint32_t node, uint64_t seq)
+{
+  TraceRecord record = {};
+  record.timeNs = timeNs;
+  record.seq = seq;
+  record.node = node;
+  record.child = TRACE_NO_NAME;
+  record.event = static_cast<uint8_t>(event);
+  return record;
+}
+
+BOOST_AUTO_TEST_CASE(RoundTrip)
+{
+  std::string names[] = {"Root", "Agg1", "Prod3"};
+  TraceRecord first[] = {MakeRecord(TraceEvent::INTEREST_SENT, 1000000000, 0, 1),
+                         MakeRecord(TraceEvent::AGGREGATE_PARTIAL, 1500000000, 0, 1)};
+  first[1].expected = 4;
+  first[1].received = 3;
+  first[1].result = 42;
+  TraceRecord second[] = {MakeRecord(TraceEvent::DATA_RECEIVED, 1250000001, 1, 1)};
+  second[0].child = 2;
+  second[0].job = 7;
+
+  std::stringstream file;
+  WriteTraceHeader(file);
+  WriteTraceNames(file, 0, names, 2);
+  WriteTraceRecords(file, first, 2);
+  WriteTraceNames(file, 2, names + 2, 1);
+  WriteTraceRecords(file, second, 1);
+
+  TraceReader reader(file);
+  BOOST_REQUIRE(reader.IsValid());
+  TraceRecord record;
+  BOOST_REQUIRE(reader.Next(record));
+  BOOST_CHECK_EQUAL(record.timeNs, 1000000000);
+  BOOST_REQUIRE(reader.Next(record));
+  BOOST_CHECK_EQUAL(record.result, 42);
+  BOOST_REQUIRE(reader.Next(record));
+  BOOST_CHECK_EQUAL(record.child, 2);
+  BOOST_CHECK_EQUAL(record.job, 7);
+  BOOST_CHECK(!reader.Next(record));
+  BOOST_REQUIRE_EQUAL(reader.Names().size(), 3);
+  BOOST_CHECK_EQUAL(reader.Names()[2], "Prod3");
+
+  std::string csv;
+  AppendCsvRecord(csv, first[1], reader.Names());
+  AppendCsvRecord(csv, second[0], reader.Names());
+  AppendCsvRecord(csv, first[0], reader.Names());
+  BOOST_CHECK_EQUAL(csv,
+                    "1.500000000,AggregatePartial,Root,1,,4,3,42,0\n"
+                    "1.250000001,DataReceived,Agg1,1,Prod3,,,,7\n"
+                    "1.000000000,InterestSent,Root,1,,,,,0\n");
+}
+
+BOOST_AUTO_TEST_CASE(RejectsForeignFile)
+{
+  std::stringstream file("Time(s),Event,Node,Seq,Child,Expected,Received,Result\n");
+  TraceReader reader(file);
+  BOOST_CHECK(!reader.IsValid());
+  TraceRecord record;
+  BOOST_CHECK(!reader.Next(record));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,248 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2025  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "helper/ndn-aggregation-tree-helper.hpp"
+#include "helper/ndn-global-routing-helper.hpp"
+
+#include "../tests-common.hpp"
+
+#include <sstream>
+
+namespace ns3 {
+namespace ndn {
+
+class AggregationTreeFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  NodeContainer
+  makeProducers(std::initializer_list<std::string> names)
+  {
+    NodeContainer producers;
+    for (const auto& name : names) {
+      producers.Add(getNode(name));
+    }
+    return producers;
+  }
+
+  using Children = std::vector<std::string>;
+};
+
+BOOST_FIXTURE_TEST_SUITE(HelperNdnAggregationTreeHelper, AggregationTreeFixture)
+
+BOOST_AUTO_TEST_CASE(BranchingNodesAggregate)
+{
+  // S2 only relays X's subtree, so X reports straight to the root
+  createTopology({
+      {"Root", "S1"}, {"S1", "A"}, {"S1", "B"},
+      {"Root", "S2"}, {"S2", "X"}, {"X", "C"}, {"X", "D"}
+    });
+  GlobalRoutingHelper().InstallAll();
+
+  AggregationTreeHelper tree;
+  BOOST_CHECK(tree.Build(getNode("Root"), makeProducers({"A", "B", "C", "D"})));
+
+  BOOST_CHECK_EQUAL(tree.GetRoot(), "Root");
+  BOOST_CHECK(tree.GetChildren("Root") == (Children{"S1", "X"}));
+  BOOST_CHECK(tree.GetChildren("S1") == (Children{"A", "B"}));
+  BOOST_CHECK(tree.GetChildren("X") == (Children{"C", "D"}));
+  BOOST_CHECK(tree.GetChildren("S2").empty());
+  BOOST_CHECK(tree.GetAggregators() == (Children{"S1", "X"}));
+  BOOST_CHECK(tree.GetProducers() == (Children{"A", "B", "C", "D"}));
+  BOOST_CHECK_EQUAL(tree.GetMaxLinkLoad(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(MaxFanIn)
+{
+  createTopology({
+      {"Root", "S1"}, {"S1", "A1"}, {"S1", "A2"},
+      {"Root", "S2"}, {"S2", "B1"}, {"S2", "B2"},
+      {"Root", "S3"}, {"S3", "C1"}, {"S3", "C2"},
+      {"Root", "S4"}, {"S4", "D1"}, {"S4", "D2"}
+    });
+  GlobalRoutingHelper().InstallAll();
+  NodeContainer producers = makeProducers({"A1", "A2", "B1", "B2", "C1", "C2", "D1", "D2"});
+
+  AggregationTreeHelper tree;
+  tree.SetMaxFanIn(3);
+  BOOST_CHECK(tree.Build(getNode("Root"), producers));
+  BOOST_CHECK_EQUAL(tree.GetChildren("Root").size(), 3);
+  for (const auto& parent : tree.GetTree()) {
+    BOOST_CHECK_LE(parent.second.size(), 3);
+  }
+  BOOST_CHECK_EQUAL(tree.GetAggregators().size(), 4);
+  BOOST_CHECK_EQUAL(tree.GetProducers().size(), 8);
+  // The moved aggregator's flow runs down and back up through the root
+  BOOST_CHECK_EQUAL(tree.GetMaxLinkLoad(), 2);
+
+  // Moving an aggregator under a sibling would put two flows on the sibling's uplink
+  AggregationTreeHelper limited;
+  limited.SetMaxFanIn(3);
+  limited.SetMaxLinkFlows(1);
+  BOOST_CHECK(!limited.Build(getNode("Root"), producers));
+  BOOST_CHECK_EQUAL(limited.GetChildren("Root").size(), 4);
+  BOOST_CHECK_EQUAL(limited.GetMaxLinkLoad(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(MaxFanInInsertsIntermediates)
+{
+  // A ToR whose children are all hosts: no child aggregator can take the excess...
+  createTopology({
+      {"Root", "ToR"}, {"ToR", "H1"}, {"ToR", "H2"}, {"ToR", "H3"}, {"ToR", "H4"}
+    });
+  GlobalRoutingHelper().InstallAll();
+  NodeContainer producers = makeProducers({"H1", "H2", "H3", "H4"});
+
+  AggregationTreeHelper alone;
+  alone.SetMaxFanIn(2);
+  BOOST_CHECK(!alone.Build(getNode("Root"), producers));
+  BOOST_CHECK_EQUAL(alone.GetChildren("ToR").size(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(MaxFanInUsesSpareNodes)
+{
+  // ...but spare switches next to it can aggregate some of the hosts
+  createTopology({
+      {"Root", "ToR"}, {"ToR", "H1"}, {"ToR", "H2"}, {"ToR", "H3"}, {"ToR", "H4"},
+      {"ToR", "S1"}, {"ToR", "S2"}
+    });
+  GlobalRoutingHelper().InstallAll();
+
+  AggregationTreeHelper tree;
+  tree.SetMaxFanIn(2);
+  BOOST_CHECK(tree.Build(getNode("Root"), makeProducers({"H1", "H2", "H3", "H4"})));
+  for (const auto& parent : tree.GetTree()) {
+    BOOST_CHECK_LE(parent.second.size(), 2);
+  }
+  BOOST_CHECK(tree.GetAggregators() == (Children{"S1", "S2", "ToR"}));
+  BOOST_CHECK(tree.GetProducers() == (Children{"H1", "H2", "H3", "H4"}));
+}
+
+BOOST_AUTO_TEST_CASE(AggregatorCandidates)
+{
+  createTopology({
+      {"Root", "S1"}, {"S1", "A"}, {"S1", "B"}
+    });
+  GlobalRoutingHelper().InstallAll();
+
+  AggregationTreeHelper tree;
+  tree.SetAggregatorCandidates(makeProducers({"Root"}));
+  tree.SetMaxLinkFlows(1);
+  // S1 may not aggregate: both flows cross the Root-S1 link
+  BOOST_CHECK(!tree.Build(getNode("Root"), makeProducers({"A", "B"})));
+  BOOST_CHECK(tree.GetChildren("Root") == (Children{"A", "B"}));
+  BOOST_CHECK_EQUAL(tree.GetMaxLinkLoad(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(WriteRead)
+{
+  createTopology({
+      {"Root", "S1"}, {"S1", "A"}, {"S1", "B"}, {"Root", "C"}
+    });
+  GlobalRoutingHelper().InstallAll();
+
+  AggregationTreeHelper tree;
+  tree.Build(getNode("Root"), makeProducers({"A", "B", "C"}));
+  std::stringstream os;
+  tree.Write(os);
+  BOOST_CHECK_EQUAL(os.str(),
+                    "# Format: ParentNode Child1 Child2 ...\n"
+                    "Root S1 C\n"
+                    "S1 A B\n");
+
+  AggregationTreeHelper loaded;
+  loaded.Read(os);
+  BOOST_CHECK_EQUAL(loaded.GetRoot(), "Root");
+  BOOST_CHECK(loaded.GetTree() == tree.GetTree());
+}
+
+BOOST_AUTO_TEST_CASE(ReadJobs)
+{
+  std::stringstream file("# Format: ParentNode Child1 Child2 ...\n"
+                         "Root Agg1\n"
+                         "Agg1 Leaf1 Leaf2\n"
+                         "\n"
+                         "job 2 0.5\n"
+                         "# job 2 skips Agg1\n"
+                         "Root Leaf1 Leaf3\n"
+                         "job 7\n"
+                         "Agg1 Leaf2\n"
+                         "Root2 Agg1\n");
+  std::vector<AggregationTreeHelper> jobs = AggregationTreeHelper::ReadJobs(file);
+  BOOST_REQUIRE_EQUAL(jobs.size(), 3);
+
+  // Lines before the first job line are job 0
+  BOOST_CHECK_EQUAL(jobs[0].GetJobId(), 0);
+  BOOST_CHECK_EQUAL(jobs[0].GetJobWeight(), 1.0);
+  BOOST_CHECK_EQUAL(jobs[0].GetRoot(), "Root");
+  BOOST_CHECK(jobs[0].GetChildren("Agg1") == (Children{"Leaf1", "Leaf2"}));
+
+  // "job" is a section header, not a parent
+  BOOST_CHECK_EQUAL(jobs[1].GetJobId(), 2);
+  BOOST_CHECK_EQUAL(jobs[1].GetJobWeight(), 0.5);
+  BOOST_CHECK_EQUAL(jobs[1].GetRoot(), "Root");
+  BOOST_CHECK(jobs[1].GetChildren("Root") == (Children{"Leaf1", "Leaf3"}));
+  BOOST_CHECK_EQUAL(jobs[1].GetTree().size(), 1);
+  BOOST_CHECK(jobs[1].GetChildren("job").empty());
+
+  BOOST_CHECK_EQUAL(jobs[2].GetJobId(), 7);
+  BOOST_CHECK_EQUAL(jobs[2].GetJobWeight(), 1.0);
+  BOOST_CHECK_EQUAL(jobs[2].GetRoot(), "Root2");
+  BOOST_CHECK(jobs[2].GetAggregators() == (Children{"Agg1"}));
+  BOOST_CHECK(jobs[2].GetProducers() == (Children{"Leaf2"}));
+
+  // Written one after the other, the trees read back as the same jobs
+  std::stringstream os;
+  for (const AggregationTreeHelper& job : jobs) {
+    job.Write(os);
+  }
+  std::vector<AggregationTreeHelper> reloaded = AggregationTreeHelper::ReadJobs(os);
+  BOOST_REQUIRE_EQUAL(reloaded.size(), 3);
+  for (size_t i = 0; i < jobs.size(); ++i) {
+    BOOST_CHECK_EQUAL(reloaded[i].GetJobId(), jobs[i].GetJobId());
+    BOOST_CHECK_EQUAL(reloaded[i].GetJobWeight(), jobs[i].GetJobWeight());
+    BOOST_CHECK_EQUAL(reloaded[i].GetRoot(), jobs[i].GetRoot());
+    BOOST_CHECK(reloaded[i].GetTree() == jobs[i].GetTree());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ReadSingleJob)
+{
+  std::stringstream file("job 5 2\n"
+                         "Root Agg1\n"
+                         "Agg1 Leaf1 Leaf2\n");
+  AggregationTreeHelper tree;
+  tree.Read(file);
+  BOOST_CHECK_EQUAL(tree.GetJobId(), 5);
+  BOOST_CHECK_EQUAL(tree.GetJobWeight(), 2.0);
+  BOOST_CHECK_EQUAL(tree.GetRoot(), "Root");
+  BOOST_CHECK(tree.GetAggregators() == (Children{"Agg1"}));
+
+  std::stringstream os;
+  tree.Write(os);
+  BOOST_CHECK_EQUAL(os.str(),
+                    "# Format: ParentNode Child1 Child2 ...\n"
+                    "job 5 2\n"
+                    "Root Agg1\n"
+                    "Agg1 Leaf1 Leaf2\n");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
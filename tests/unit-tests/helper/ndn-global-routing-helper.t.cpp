@@ -19,6 +19,7 @@
 
 #include "helper/ndn-global-routing-helper.hpp"
 #include "helper/ndn-stack-helper.hpp"
+#include "helper/ndn-link-control-helper.hpp"
 
 #include "model/ndn-global-router.hpp"
 #include "model/ndn-l3-protocol.hpp"
@@ -186,6 +187,144 @@ BOOST_AUTO_TEST_CASE(CalculateRoutesBasedOnLinkDelay)
   }
 }
 
+BOOST_AUTO_TEST_CASE(CalculateRoutesInParallel)
+{
+  PointToPointHelper p2p;
+  PointToPointGridHelper grid(4, 4, p2p);
+  grid.BoundingBox(100, 100, 200, 200);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+  for (uint32_t row = 0; row < 4; ++row) {
+    for (uint32_t col = 0; col < 4; ++col) {
+      ndnGlobalRoutingHelper.AddOrigin("/" + std::to_string(row) + "/" + std::to_string(col),
+                                       grid.GetNode(row, col));
+    }
+  }
+
+  ndn::GlobalRoutingHelper::SetThreadCount(4);
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+  ndn::GlobalRoutingHelper::SetThreadCount(0);
+
+  // Every node reaches every other node with the Manhattan distance as cost
+  for (uint32_t row = 0; row < 4; ++row) {
+    for (uint32_t col = 0; col < 4; ++col) {
+      auto& fib = grid.GetNode(row, col)->GetObject<ndn::L3Protocol>()->getForwarder()->getFib();
+      size_t nRoutes = 0;
+      for (const auto& entry : fib) {
+        if (Name("/localhost").isPrefixOf(entry.getPrefix())) {
+          continue;
+        }
+        ++nRoutes;
+        uint32_t otherRow = std::stoul(entry.getPrefix().get(0).toUri());
+        uint32_t otherCol = std::stoul(entry.getPrefix().get(1).toUri());
+        uint32_t distance = std::max(row, otherRow) - std::min(row, otherRow)
+                            + std::max(col, otherCol) - std::min(col, otherCol);
+        BOOST_REQUIRE_EQUAL(entry.getNextHops().size(), 1);
+        BOOST_CHECK_EQUAL(entry.getNextHops().front().getCost(), distance);
+      }
+      BOOST_CHECK_EQUAL(nRoutes, 15);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(IncrementalUpdates)
+{
+  PointToPointHelper p2p;
+  PointToPointGridHelper grid(3, 3, p2p);
+  grid.BoundingBox(100, 100, 200, 200);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+  ndnGlobalRoutingHelper.AddOrigin("/prefix", grid.GetNode(0, 1));
+
+  ndn::GlobalRoutingHelper::EnableIncrementalUpdates();
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+  ndn::GlobalRoutingHelper::EnableIncrementalUpdates(false);
+
+  auto getNextHop = [&] (uint32_t row, uint32_t col) -> std::pair<std::string, uint64_t> {
+    auto& fib = grid.GetNode(row, col)->GetObject<ndn::L3Protocol>()->getForwarder()->getFib();
+    const auto* entry = fib.findExactMatch("/prefix");
+    if (entry == nullptr || entry->getNextHops().size() != 1) {
+      return {"", 0};
+    }
+    const auto& nextHop = entry->getNextHops().front();
+    auto transport = dynamic_cast<NetDeviceTransport*>(nextHop.getFace().getTransport());
+    Ptr<Channel> channel = transport->GetNetDevice()->GetChannel();
+    Ptr<Node> other = channel->GetDevice(0)->GetNode() == grid.GetNode(row, col) ?
+                        channel->GetDevice(1)->GetNode() : channel->GetDevice(0)->GetNode();
+    return {std::to_string(other->GetId()), nextHop.getCost()};
+  };
+  auto nodeId = [&] (uint32_t row, uint32_t col) {
+    return std::to_string(grid.GetNode(row, col)->GetId());
+  };
+
+  BOOST_CHECK(getNextHop(0, 0) == std::make_pair(nodeId(0, 1), uint64_t(1)));
+  BOOST_CHECK_EQUAL(getNextHop(1, 0).second, 2);
+
+  // (0,0) and (1,0) now go around through (1,1); other nodes keep their routes
+  LinkControlHelper::FailLink(grid.GetNode(0, 0), grid.GetNode(0, 1));
+  BOOST_CHECK(getNextHop(0, 0) == std::make_pair(nodeId(1, 0), uint64_t(3)));
+  BOOST_CHECK(getNextHop(1, 0) == std::make_pair(nodeId(1, 1), uint64_t(2)));
+  BOOST_CHECK(getNextHop(0, 2) == std::make_pair(nodeId(0, 1), uint64_t(1)));
+
+  // (0,1) is cut off: the routes to it are removed
+  LinkControlHelper::FailLink(grid.GetNode(0, 1), grid.GetNode(1, 1));
+  LinkControlHelper::FailLink(grid.GetNode(0, 1), grid.GetNode(0, 2));
+  BOOST_CHECK(getNextHop(0, 0) == std::make_pair(std::string(), uint64_t(0)));
+  BOOST_CHECK(getNextHop(2, 2) == std::make_pair(std::string(), uint64_t(0)));
+
+  LinkControlHelper::UpLink(grid.GetNode(0, 1), grid.GetNode(1, 1));
+  LinkControlHelper::UpLink(grid.GetNode(0, 1), grid.GetNode(0, 2));
+  LinkControlHelper::UpLink(grid.GetNode(0, 0), grid.GetNode(0, 1));
+  BOOST_CHECK(getNextHop(0, 0) == std::make_pair(nodeId(0, 1), uint64_t(1)));
+  BOOST_CHECK(getNextHop(1, 1) == std::make_pair(nodeId(0, 1), uint64_t(1)));
+  BOOST_CHECK(getNextHop(2, 2).second == 3);
+}
+
+BOOST_AUTO_TEST_CASE(AllPossibleRoutesStopIncrementalUpdates)
+{
+  PointToPointHelper p2p;
+  PointToPointGridHelper grid(3, 3, p2p);
+  grid.BoundingBox(100, 100, 200, 200);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+  ndnGlobalRoutingHelper.AddOrigin("/prefix", grid.GetNode(0, 1));
+
+  ndn::GlobalRoutingHelper::EnableIncrementalUpdates();
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+  ndn::GlobalRoutingHelper::EnableIncrementalUpdates(false);
+  ndn::GlobalRoutingHelper::CalculateAllPossibleRoutes();
+
+  auto getNextHops = [&] (uint32_t row, uint32_t col) {
+    auto& fib = grid.GetNode(row, col)->GetObject<ndn::L3Protocol>()->getForwarder()->getFib();
+    const auto* entry = fib.findExactMatch("/prefix");
+    std::vector<uint64_t> costs;
+    if (entry != nullptr) {
+      for (const auto& nextHop : entry->getNextHops()) {
+        costs.push_back(nextHop.getCost());
+      }
+    }
+    return costs;
+  };
+  // (0,0) reaches (0,1) directly, or around through (1,0)
+  BOOST_CHECK(getNextHops(0, 0) == std::vector<uint64_t>({1, 3}));
+
+  // The multipath routes are left alone: the failure does not reinstall shortest paths
+  LinkControlHelper::FailLink(grid.GetNode(0, 0), grid.GetNode(0, 1));
+  BOOST_CHECK(getNextHops(0, 0) == std::vector<uint64_t>({1, 3}));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
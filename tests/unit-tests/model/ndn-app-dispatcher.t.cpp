@@ -0,0 +1,98 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2025  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/ndn-app-dispatcher.hpp"
+#include "model/ndn-l3-protocol.hpp"
+#include "helper/ndn-scenario-helper.hpp"
+
+#include "NFD/daemon/fw/forwarder.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class AppDispatcherFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  ~AppDispatcherFixture()
+  {
+    Config::SetDefault("ns3::ndn::AppDispatcher::Mode", StringValue("Scheduled"));
+  }
+
+  void
+  run(const std::string& mode)
+  {
+    Config::SetDefault("ns3::ndn::AppDispatcher::Mode", StringValue(mode));
+
+    createTopology({
+        {"1", "2"},
+      });
+
+    addRoutes({
+        {"1", "2", "/remote", 1},
+      });
+
+    // /remote crosses the link; /local is produced and consumed on node 2, so the Data reaches
+    // the consumer while the producer's own callback is still running in Direct mode
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/remote"}, {"Frequency", "100"}},
+            "0.1s", "1.1s"},
+        {"2", "ns3::ndn::Producer",
+            {{"Prefix", "/remote"}, {"PayloadSize", "100"}},
+            "0s", "10s"},
+        {"2", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/local"}, {"Frequency", "100"}},
+            "0.1s", "1.1s"},
+        {"2", "ns3::ndn::Producer",
+            {{"Prefix", "/local"}, {"PayloadSize", "100"}},
+            "0s", "10s"},
+      });
+
+    Simulator::Stop(Seconds(2.0));
+    Simulator::Run();
+
+    BOOST_CHECK_EQUAL(AppDispatcher::GetDispatcher(getNode("2"))->GetMode(),
+                      mode == "Batched" ? AppDispatcher::BATCHED : AppDispatcher::DIRECT);
+    BOOST_CHECK_EQUAL(getFace("2", "1")->getCounters().nOutData, 100);
+    BOOST_CHECK_EQUAL(getFace("1", "2")->getCounters().nInData, 100);
+
+    auto& counters = getNode("2")->GetObject<L3Protocol>()->getForwarder()->getCounters();
+    BOOST_CHECK_EQUAL(counters.nSatisfiedInterests, 200);
+    BOOST_CHECK_EQUAL(counters.nUnsatisfiedInterests, 0);
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(ModelNdnAppDispatcher, AppDispatcherFixture)
+
+BOOST_AUTO_TEST_CASE(Batched)
+{
+  run("Batched");
+}
+
+BOOST_AUTO_TEST_CASE(Direct)
+{
+  run("Direct");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
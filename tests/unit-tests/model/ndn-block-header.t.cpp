@@ -92,6 +92,30 @@ BOOST_AUTO_TEST_CASE(EncodePrintData)
   BOOST_CHECK_EQUAL(header.GetSerializedSize(), 1365);
 }
 
+BOOST_AUTO_TEST_CASE(DeserializeRoundTrip)
+{
+  Data data("/other/prefix");
+  data.setContent(std::make_shared< ::ndn::Buffer>(4000));
+  ndn::StackHelper::getKeyChain().sign(data);
+  Block wire = lp::Packet(data.wireEncode()).wireEncode();
+
+  Ptr<Packet> packet = Create<Packet>();
+  packet->AddHeader(BlockHeader(wire));
+  BOOST_CHECK_EQUAL(packet->GetSize(), wire.size());
+
+  BlockHeader header;
+  BOOST_CHECK_EQUAL(packet->RemoveHeader(header), wire.size());
+  BOOST_CHECK_EQUAL(packet->GetSize(), 0);
+  BOOST_CHECK(header.getBlock() == wire);
+  BOOST_CHECK_EQUAL_COLLECTIONS(header.getBlock().begin(), header.getBlock().end(),
+                                wire.begin(), wire.end());
+
+  // A truncated element does not parse
+  Ptr<Packet> truncated = Create<Packet>(wire.data(), wire.size() - 1);
+  BlockHeader truncatedHeader;
+  BOOST_CHECK_THROW(truncated->RemoveHeader(truncatedHeader), ::ndn::tlv::Error);
+}
+
 BOOST_AUTO_TEST_CASE(PrintLpPacket)
 {
   Interest interest("/prefix");
@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2025  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/ndn-net-device-transport.hpp"
+#include "apps/ndn-app.hpp"
+#include "helper/ndn-scenario-helper.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class NetDeviceTransportFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  // Fetch 3 Data from a producer one p2p link away, with packets sent as a BlockHeader or not
+  void
+  roundTrip(bool blockHeader)
+  {
+    getStackHelper().SetStackAttributes("BlockHeader", blockHeader ? "true" : "false");
+    createTopology({
+        {"1", "2"},
+      });
+    addRoutes({
+        {"1", "2", "/prefix", 1},
+      });
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "10"}, {"MaxSeq", "3"}},
+            "0s", "1s"},
+        {"2", "ns3::ndn::Producer", {{"Prefix", "/prefix"}, {"PayloadSize", "100"}}, "0s", "1s"},
+      });
+    getNode("2")->GetApplication(0)->TraceConnectWithoutContext("ReceivedInterests",
+      MakeCallback(&NetDeviceTransportFixture::onInterest, this));
+    getNode("1")->GetApplication(0)->TraceConnectWithoutContext("ReceivedDatas",
+      MakeCallback(&NetDeviceTransportFixture::onData, this));
+
+    Simulator::Stop(Seconds(1));
+    Simulator::Run();
+
+    BOOST_CHECK_EQUAL(getNode("1")->GetObject<L3Protocol>()->isBlockHeaderEnabled(), blockHeader);
+    BOOST_REQUIRE_EQUAL(interests.size(), 3);
+    BOOST_REQUIRE_EQUAL(datas.size(), 3);
+    for (uint64_t seq = 0; seq < 3; ++seq) {
+      Name name = Name("/prefix").appendSequenceNumber(seq);
+      BOOST_CHECK_EQUAL(interests[seq], name);
+      BOOST_CHECK_EQUAL(datas[seq]->getName(), name);
+      BOOST_CHECK_EQUAL(datas[seq]->getContent().value_size(), 100);
+    }
+  }
+
+  void
+  onInterest(shared_ptr<const Interest> interest, Ptr<App>, shared_ptr<Face>)
+  {
+    interests.push_back(interest->getName());
+  }
+
+  void
+  onData(shared_ptr<const Data> data, Ptr<App>, shared_ptr<Face>)
+  {
+    datas.push_back(data);
+  }
+
+public:
+  std::vector<Name> interests;
+  std::vector<shared_ptr<const Data>> datas;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ModelNdnNetDeviceTransport, NetDeviceTransportFixture)
+
+BOOST_AUTO_TEST_CASE(SendQueue)
+{
+  createTopology({
+      {"1", "2"},
+    });
+
+  auto transport = dynamic_cast<NetDeviceTransport*>(getFace("1", "2")->getTransport());
+  BOOST_REQUIRE(transport != nullptr);
+
+  // TxQueue of the PointToPointNetDevice, resolved when the face was created
+  BOOST_CHECK_EQUAL(transport->getSendQueueLength(), 0);
+  PointerValue txQueue;
+  getNetDevice("1", "2")->GetAttribute("TxQueue", txQueue);
+  QueueSize maxSize = txQueue.Get<QueueBase>()->GetMaxSize();
+  BOOST_REQUIRE(maxSize.GetUnit() == PACKETS);
+  BOOST_CHECK_EQUAL(transport->getSendQueueCapacity(), maxSize.GetValue() * 1500);
+  BOOST_CHECK_EQUAL(transport->GetSendQueueOccupancy().packets, 0);
+
+  transport->SetSendQueueCallback([] {
+      return NetDeviceTransport::QueueOccupancy{3000, 2};
+    });
+  BOOST_CHECK_EQUAL(transport->getSendQueueLength(), 3000);
+  BOOST_CHECK_EQUAL(transport->GetSendQueueOccupancy().packets, 2);
+
+  transport->SetSendQueueCallback(nullptr);
+  BOOST_CHECK_EQUAL(transport->getSendQueueLength(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(RoundTripPayload)
+{
+  roundTrip(false);
+}
+
+BOOST_AUTO_TEST_CASE(RoundTripBlockHeader)
+{
+  roundTrip(true);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
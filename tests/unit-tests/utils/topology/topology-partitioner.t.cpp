@@ -0,0 +1,104 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2025  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/topology/topology-partitioner.hpp"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsTopologyPartitioner)
+
+BOOST_AUTO_TEST_CASE(Grid)
+{
+  // 10x10 grid with unit weights: four 5x5 quadrants cut 20 links
+  TopologyPartitioner partitioner(100);
+  for (uint32_t row = 0; row < 10; ++row) {
+    for (uint32_t col = 0; col < 10; ++col) {
+      if (col + 1 < 10) {
+        partitioner.AddLink(row * 10 + col, row * 10 + col + 1, 1.0);
+      }
+      if (row + 1 < 10) {
+        partitioner.AddLink(row * 10 + col, (row + 1) * 10 + col, 1.0);
+      }
+    }
+  }
+
+  std::vector<uint32_t> partition = partitioner.Partition(4);
+  BOOST_REQUIRE_EQUAL(partition.size(), 100);
+
+  std::vector<uint32_t> sizes(4, 0);
+  for (uint32_t p : partition) {
+    BOOST_REQUIRE_LT(p, 4);
+    ++sizes[p];
+  }
+  for (uint32_t size : sizes) {
+    BOOST_CHECK_EQUAL(size, 25);
+  }
+  BOOST_CHECK_CLOSE(partitioner.GetCutWeight(partition), 20.0, 0.001);
+
+  BOOST_CHECK(partitioner.Partition(4) == partition); // deterministic
+}
+
+BOOST_AUTO_TEST_CASE(CutsLightestLinks)
+{
+  // Two 5-node cliques of heavy (short) links joined by one light (long) link
+  TopologyPartitioner partitioner(10);
+  for (uint32_t base : {0, 5}) {
+    for (uint32_t i = 0; i < 5; ++i) {
+      for (uint32_t j = i + 1; j < 5; ++j) {
+        partitioner.AddLink(base + i, base + j, 10.0);
+      }
+    }
+  }
+  partitioner.AddLink(2, 7, 0.1);
+
+  std::vector<uint32_t> partition = partitioner.Partition(2);
+  BOOST_CHECK_CLOSE(partitioner.GetCutWeight(partition), 0.1, 0.001);
+  for (uint32_t i = 1; i < 5; ++i) {
+    BOOST_CHECK_EQUAL(partition[i], partition[0]);
+    BOOST_CHECK_EQUAL(partition[5 + i], partition[5]);
+  }
+  BOOST_CHECK_NE(partition[0], partition[5]);
+}
+
+BOOST_AUTO_TEST_CASE(Disconnected)
+{
+  // Isolated nodes still get spread over all partitions
+  TopologyPartitioner partitioner(6);
+  partitioner.AddLink(0, 1, 1.0);
+  partitioner.AddLink(1, 0, 1.0); // parallel link
+  partitioner.AddLink(2, 3, 1.0);
+
+  std::vector<uint32_t> partition = partitioner.Partition(3);
+  std::vector<uint32_t> sizes(3, 0);
+  for (uint32_t p : partition) {
+    ++sizes[p];
+  }
+  for (uint32_t size : sizes) {
+    BOOST_CHECK_EQUAL(size, 2);
+  }
+  BOOST_CHECK_EQUAL(partitioner.GetCutWeight(partition), 0.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -43,6 +43,7 @@
 #include "ns3/double.h"
 
 #include "model/ndn-l3-protocol.hpp"
+#include "topology-partitioner.hpp"
 
 #include <boost/foreach.hpp>
 #include <boost/lexical_cast.hpp>
@@ -52,6 +53,7 @@
 #include <boost/graph/graphviz.hpp>
 
 #include <set>
+#include <tuple>
 
 #ifdef NS3_MPI
 #include <ns3/mpi-interface.h>
@@ -69,6 +71,8 @@ AnnotatedTopologyReader::AnnotatedTopologyReader(const std::string& path, double
   , m_randY(CreateObject<UniformRandomVariable>())
   , m_scale(scale)
   , m_requiredPartitions(1)
+  , m_autoPartitioning(false)
+  , m_autoPartitions(0)
 {
   NS_LOG_FUNCTION(this);
 
@@ -100,6 +104,83 @@ AnnotatedTopologyReader::SetMobilityModel(const std::string& model)
   m_mobilityFactory.SetTypeId(model);
 }
 
+void
+AnnotatedTopologyReader::EnableAutoPartitioning(uint32_t partitions)
+{
+  NS_LOG_FUNCTION(this << partitions);
+  m_autoPartitioning = true;
+  m_autoPartitions = partitions;
+}
+
+vector<uint32_t>
+AnnotatedTopologyReader::PartitionNodes(const vector<string>& names,
+                                        const vector<vector<string>>& links) const
+{
+  uint32_t partitions = m_autoPartitions;
+  if (partitions == 0) {
+    partitions = 1;
+#ifdef NS3_MPI
+    if (MpiInterface::IsEnabled()) {
+      partitions = MpiInterface::GetSize();
+    }
+#endif
+  }
+  if (names.empty()) {
+    return {};
+  }
+  if (partitions > names.size()) {
+    NS_FATAL_ERROR("Cannot split " << names.size() << " nodes into " << partitions
+                                   << " partitions");
+  }
+
+  // Links without a delay get the default delay of the point-to-point channel
+  Time defaultDelay;
+  {
+    TypeId::AttributeInformation info;
+    if (TypeId::LookupByName("ns3::PointToPointChannel").LookupAttributeByName("Delay", &info)) {
+      defaultDelay = DynamicCast<const TimeValue>(info.initialValue)->Get();
+    }
+  }
+
+  map<string, uint32_t> index;
+  for (uint32_t i = 0; i < names.size(); ++i) {
+    index[names[i]] = i;
+  }
+
+  // The cut links bound the lookahead of the parallel simulation, so cutting a link costs the
+  // more the shorter its delay (zero-delay links are practically never cut)
+  ns3::TopologyPartitioner partitioner(names.size());
+  vector<std::tuple<uint32_t, uint32_t, Time>> delays;
+  for (const auto& link : links) {
+    auto from = index.find(link[0]);
+    auto to = index.find(link[1]);
+    if (from == index.end() || to == index.end()) {
+      continue; // reported when the link is created
+    }
+    Time delay = link[4].empty() ? defaultDelay : Time(link[4]);
+    partitioner.AddLink(from->second, to->second, 1.0 / std::max(delay.GetSeconds(), 1e-9));
+    delays.emplace_back(from->second, to->second, delay);
+  }
+
+  vector<uint32_t> partition = partitioner.Partition(partitions);
+
+  uint32_t cutLinks = 0;
+  Time lookahead = Time::Max();
+  for (const auto& link : delays) {
+    if (partition[std::get<0>(link)] != partition[std::get<1>(link)]) {
+      ++cutLinks;
+      lookahead = std::min(lookahead, std::get<2>(link));
+    }
+  }
+  NS_LOG_INFO("Partitioned " << names.size() << " nodes into " << partitions << " partitions, "
+              << cutLinks << " links cut, lookahead " << (cutLinks > 0 ? lookahead : Time(0)));
+  if (cutLinks > 0 && lookahead.IsZero()) {
+    NS_LOG_WARN("A zero-delay link crosses partitions, parallel simulation will not progress");
+  }
+
+  return partition;
+}
+
 AnnotatedTopologyReader::~AnnotatedTopologyReader()
 {
   NS_LOG_FUNCTION(this);
@@ -174,6 +255,16 @@ AnnotatedTopologyReader::Read(void)
     return m_nodes;
   }
 
+  // Nodes are created once the links are known, so that they can be partitioned automatically
+  struct NodeSpec
+  {
+    string name;
+    double posX;
+    double posY;
+    uint32_t systemId;
+  };
+  vector<NodeSpec> nodeSpecs;
+
   while (!topgen.eof()) {
     string line;
     getline(topgen, line);
@@ -191,24 +282,27 @@ AnnotatedTopologyReader::Read(void)
     if (name.empty())
       continue;
 
-    Ptr<Node> node;
-
     if (abs(latitude) > 0.001 && abs(latitude) > 0.001)
-      node = CreateNode(name, m_scale * longitude, -m_scale * latitude, systemId);
+      nodeSpecs.push_back({name, m_scale * longitude, -m_scale * latitude, systemId});
     else {
       Ptr<UniformRandomVariable> var = CreateObject<UniformRandomVariable>();
-      node = CreateNode(name, var->GetValue(0, 200), var->GetValue(0, 200), systemId);
-      // node = CreateNode (name, systemId);
+      double posX = var->GetValue(0, 200);
+      double posY = var->GetValue(0, 200);
+      nodeSpecs.push_back({name, posX, posY, systemId});
     }
   }
 
-  map<string, set<string>> processedLinks; // to eliminate duplications
-
   if (topgen.eof()) {
+    for (const auto& spec : nodeSpecs) {
+      CreateNode(spec.name, spec.posX, spec.posY, spec.systemId);
+    }
     NS_LOG_ERROR("Topology file " << GetFileName() << " does not have \"link\" section");
     return m_nodes;
   }
 
+  map<string, set<string>> processedLinks; // to eliminate duplications
+  vector<vector<string>> linkSpecs; // from, to, capacity, metric, delay, maxPackets, lossRate
+
   // SeekToSection ("link");
   while (!topgen.eof()) {
     string line;
@@ -231,6 +325,33 @@ AnnotatedTopologyReader::Read(void)
     }
     processedLinks[from].insert(to);
 
+    linkSpecs.push_back({from, to, capacity, metric, delay, maxPackets, lossRate});
+  }
+
+  if (m_autoPartitioning) {
+    vector<string> names;
+    for (const auto& spec : nodeSpecs) {
+      names.push_back(spec.name);
+    }
+    vector<uint32_t> systemIds = PartitionNodes(names, linkSpecs);
+    for (size_t i = 0; i < nodeSpecs.size(); ++i) {
+      nodeSpecs[i].systemId = systemIds[i];
+    }
+  }
+
+  for (const auto& spec : nodeSpecs) {
+    CreateNode(spec.name, spec.posX, spec.posY, spec.systemId);
+  }
+
+  for (const auto& spec : linkSpecs) {
+    const string& from = spec[0];
+    const string& to = spec[1];
+    const string& capacity = spec[2];
+    const string& metric = spec[3];
+    const string& delay = spec[4];
+    const string& maxPackets = spec[5];
+    const string& lossRate = spec[6];
+
     Ptr<Node> fromNode = Names::Find<Node>(m_path, from);
     NS_ASSERT_MSG(fromNode != 0, from << " node not found");
     Ptr<Node> toNode = Names::Find<Node>(m_path, to);
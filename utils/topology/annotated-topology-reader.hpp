@@ -27,6 +27,9 @@
 #include "ns3/object-factory.h"
 #include "ns3/node-container.h"
 
+#include <string>
+#include <vector>
+
 namespace ns3 {
 
 /**
@@ -98,6 +101,18 @@ public:
   virtual void
   SetMobilityModel(const std::string& model);
 
+  /**
+   * \brief Assign nodes to MPI partitions automatically instead of using the systemId column
+   *
+   * Must be called before Read(). The nodes are split into partitions of (nearly) equal size,
+   * cutting links with long delays rather than short ones, as the shortest cut link bounds the
+   * lookahead of the parallel simulation.
+   *
+   * \param partitions number of partitions (0: the number of MPI ranks, or 1 without MPI)
+   */
+  void
+  EnableAutoPartitioning(uint32_t partitions = 0);
+
   /**
    * \brief Apply OSPF metric on Ipv4 (if exists) and Ccnx (if exists) stacks
    */
@@ -123,6 +138,14 @@ protected:
   Ptr<Node>
   CreateNode(const std::string name, double posX, double posY, uint32_t systemId);
 
+  /**
+   * \brief Compute the system id of every node of @p names
+   * \param links from, to, capacity, metric, delay, ... of every link
+   */
+  std::vector<uint32_t>
+  PartitionNodes(const std::vector<std::string>& names,
+                 const std::vector<std::vector<std::string>>& links) const;
+
 protected:
   /**
    * \brief This method applies setting to corresponding nodes and links
@@ -148,6 +171,8 @@ private:
   double m_scale;
 
   uint32_t m_requiredPartitions;
+  bool m_autoPartitioning;
+  uint32_t m_autoPartitions;
 };
 }
 
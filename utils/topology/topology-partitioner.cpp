@@ -0,0 +1,348 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2025  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "topology-partitioner.hpp"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <set>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("TopologyPartitioner");
+
+namespace {
+
+const int8_t OUTSIDE = -1; // node is not part of the bisected subset
+const double EPSILON = 1e-9;
+const uint32_t MAX_REFINE_PASSES = 8;
+const size_t MAX_FRUITLESS_MOVES = 100; // FM moves tried past the best cut found in a pass
+const uint32_t GROW_TRIALS = 4;         // seeds tried per bisection
+
+// Ordered by decreasing gain, then by node id (keeps the result deterministic)
+typedef std::set<std::pair<double, uint32_t>> GainQueue;
+
+} // namespace
+
+TopologyPartitioner::TopologyPartitioner(uint32_t nNodes)
+  : m_adjacency(nNodes)
+{
+}
+
+void
+TopologyPartitioner::AddLink(uint32_t node1, uint32_t node2, double weight)
+{
+  NS_ASSERT(node1 < m_adjacency.size() && node2 < m_adjacency.size());
+  if (node1 == node2) {
+    return;
+  }
+
+  for (auto& neighbor : m_adjacency[node1]) {
+    if (neighbor.first == node2) {
+      neighbor.second += weight;
+      for (auto& back : m_adjacency[node2]) {
+        if (back.first == node1) {
+          back.second += weight;
+        }
+      }
+      return;
+    }
+  }
+  m_adjacency[node1].emplace_back(node2, weight);
+  m_adjacency[node2].emplace_back(node1, weight);
+}
+
+std::vector<uint32_t>
+TopologyPartitioner::Partition(uint32_t nPartitions) const
+{
+  NS_ASSERT_MSG(nPartitions > 0 && nPartitions <= std::max<size_t>(m_adjacency.size(), 1),
+                "Cannot split " << m_adjacency.size() << " nodes into " << nPartitions
+                                << " partitions");
+
+  std::vector<uint32_t> partition(m_adjacency.size(), 0);
+  std::vector<uint32_t> nodes(m_adjacency.size());
+  for (uint32_t i = 0; i < nodes.size(); ++i) {
+    nodes[i] = i;
+  }
+  Bisect(nodes, 0, nPartitions, partition);
+  return partition;
+}
+
+double
+TopologyPartitioner::GetCutWeight(const std::vector<uint32_t>& partition) const
+{
+  double cut = 0;
+  for (uint32_t node = 0; node < m_adjacency.size(); ++node) {
+    for (const auto& neighbor : m_adjacency[node]) {
+      if (node < neighbor.first && partition[node] != partition[neighbor.first]) {
+        cut += neighbor.second;
+      }
+    }
+  }
+  return cut;
+}
+
+void
+TopologyPartitioner::Bisect(const std::vector<uint32_t>& nodes, uint32_t firstPartition,
+                            uint32_t nPartitions, std::vector<uint32_t>& partition) const
+{
+  if (nPartitions == 1) {
+    for (uint32_t node : nodes) {
+      partition[node] = firstPartition;
+    }
+    return;
+  }
+
+  // The left half gets floor(nPartitions / 2) partitions and the matching share of the nodes
+  uint32_t leftPartitions = nPartitions / 2;
+  size_t targetLeft = (nodes.size() * leftPartitions + nPartitions / 2) / nPartitions;
+
+  std::vector<int8_t> initial(m_adjacency.size(), OUTSIDE);
+  for (uint32_t node : nodes) {
+    initial[node] = 1;
+  }
+
+  // Refinement may trade balance for cut weight within the tolerance, but each half keeps at
+  // least one node per partition it still has to hold
+  size_t tolerance = std::max<size_t>(1, nodes.size() / 200);
+  uint32_t partitions[2] = {leftPartitions, nPartitions - leftPartitions};
+  size_t target[2] = {targetLeft, nodes.size() - targetLeft};
+  std::array<size_t, 2> minSize, maxSize;
+  for (int s = 0; s < 2; ++s) {
+    minSize[s] = std::max<size_t>(target[s] > tolerance ? target[s] - tolerance : 0,
+                                  partitions[s]);
+    maxSize[s] = std::min(target[s] + tolerance, nodes.size() - partitions[1 - s]);
+  }
+
+  // Grow from a few peripheral nodes (each the farthest from the previous one) and keep the
+  // smallest cut
+  std::vector<int8_t> side;
+  double bestCut = 0;
+  uint32_t seed = nodes.empty() ? 0 : FarthestNode(nodes.front(), initial);
+  for (uint32_t trial = 0; trial < GROW_TRIALS && !nodes.empty(); ++trial) {
+    std::vector<int8_t> candidate = initial;
+    Grow(nodes, seed, targetLeft, candidate);
+    Refine(nodes, minSize, maxSize, candidate);
+
+    double cut = 0;
+    for (uint32_t node : nodes) {
+      for (const auto& neighbor : m_adjacency[node]) {
+        if (node < neighbor.first && candidate[neighbor.first] != OUTSIDE &&
+            candidate[node] != candidate[neighbor.first]) {
+          cut += neighbor.second;
+        }
+      }
+    }
+    if (side.empty() || cut < bestCut - EPSILON) {
+      side = std::move(candidate);
+      bestCut = cut;
+    }
+    seed = FarthestNode(seed, initial);
+  }
+  if (side.empty()) {
+    side = std::move(initial);
+  }
+
+  std::vector<uint32_t> left, right;
+  for (uint32_t node : nodes) {
+    (side[node] == 0 ? left : right).push_back(node);
+  }
+  NS_LOG_DEBUG("Bisected " << nodes.size() << " nodes into " << left.size() << " + "
+                           << right.size());
+
+  Bisect(left, firstPartition, leftPartitions, partition);
+  Bisect(right, firstPartition + leftPartitions, nPartitions - leftPartitions, partition);
+}
+
+uint32_t
+TopologyPartitioner::FarthestNode(uint32_t start, const std::vector<int8_t>& side) const
+{
+  // The last node reached by a BFS within the subset
+  uint32_t last = start;
+  std::vector<bool> visited(m_adjacency.size(), false);
+  std::deque<uint32_t> queue{start};
+  visited[start] = true;
+  while (!queue.empty()) {
+    last = queue.front();
+    queue.pop_front();
+    for (const auto& neighbor : m_adjacency[last]) {
+      if (side[neighbor.first] != OUTSIDE && !visited[neighbor.first]) {
+        visited[neighbor.first] = true;
+        queue.push_back(neighbor.first);
+      }
+    }
+  }
+  return last;
+}
+
+void
+TopologyPartitioner::Grow(const std::vector<uint32_t>& nodes, uint32_t seed, size_t targetLeft,
+                          std::vector<int8_t>& side) const
+{
+  if (targetLeft == 0) {
+    return;
+  }
+
+  // gain[v]: cut weight saved by moving v to the left half (weight to left - weight to right)
+  std::vector<double> gain(m_adjacency.size(), 0);
+  for (uint32_t node : nodes) {
+    for (const auto& neighbor : m_adjacency[node]) {
+      if (side[neighbor.first] != OUTSIDE) {
+        gain[node] -= neighbor.second;
+      }
+    }
+  }
+
+  GainQueue frontier;
+  std::vector<bool> inFrontier(m_adjacency.size(), false);
+  size_t nextUnreached = 0;
+  uint32_t next = seed;
+  for (size_t inLeft = 0; inLeft < targetLeft; ++inLeft) {
+    side[next] = 0;
+    for (const auto& neighbor : m_adjacency[next]) {
+      uint32_t other = neighbor.first;
+      if (side[other] != 1) {
+        continue;
+      }
+      if (inFrontier[other]) {
+        frontier.erase({-gain[other], other});
+      }
+      gain[other] += 2 * neighbor.second;
+      frontier.insert({-gain[other], other});
+      inFrontier[other] = true;
+    }
+
+    if (inLeft + 1 == targetLeft) {
+      break;
+    }
+    if (!frontier.empty()) {
+      next = frontier.begin()->second;
+      frontier.erase(frontier.begin());
+      inFrontier[next] = false;
+    }
+    else {
+      // The component is exhausted, continue from another one
+      while (side[nodes[nextUnreached]] != 1) {
+        ++nextUnreached;
+      }
+      next = nodes[nextUnreached];
+    }
+  }
+}
+
+void
+TopologyPartitioner::Refine(const std::vector<uint32_t>& nodes,
+                            const std::array<size_t, 2>& minSize,
+                            const std::array<size_t, 2>& maxSize, std::vector<int8_t>& side) const
+{
+  // weight[v][s]: weight of the links from v to half s
+  std::vector<std::array<double, 2>> weight(m_adjacency.size(), {0, 0});
+  for (uint32_t node : nodes) {
+    for (const auto& neighbor : m_adjacency[node]) {
+      if (side[neighbor.first] != OUTSIDE) {
+        weight[node][side[neighbor.first]] += neighbor.second;
+      }
+    }
+  }
+  auto gainOf = [&] (uint32_t node) {
+    return weight[node][1 - side[node]] - weight[node][side[node]];
+  };
+  auto move = [&] (uint32_t node) {
+    int8_t from = side[node];
+    side[node] = 1 - from;
+    for (const auto& neighbor : m_adjacency[node]) {
+      if (side[neighbor.first] != OUTSIDE) {
+        weight[neighbor.first][from] -= neighbor.second;
+        weight[neighbor.first][1 - from] += neighbor.second;
+      }
+    }
+  };
+
+  for (uint32_t pass = 0; pass < MAX_REFINE_PASSES; ++pass) {
+    size_t size[2] = {0, 0};
+    GainQueue queue[2];
+    for (uint32_t node : nodes) {
+      ++size[side[node]];
+      queue[side[node]].insert({-gainOf(node), node});
+    }
+    std::vector<bool> locked(m_adjacency.size(), false);
+
+    std::vector<uint32_t> moves;
+    double total = 0;
+    double best = 0;
+    size_t bestMoves = 0;
+    while (moves.size() < bestMoves + MAX_FRUITLESS_MOVES) {
+      // Best node of either half whose move keeps both halves within their size limits
+      int8_t from = OUTSIDE;
+      for (int8_t s = 0; s < 2; ++s) {
+        if (queue[s].empty() || size[s] <= minSize[s] || size[1 - s] >= maxSize[1 - s]) {
+          continue;
+        }
+        if (from == OUTSIDE || *queue[s].begin() < *queue[from].begin()) {
+          from = s;
+        }
+      }
+      if (from == OUTSIDE) {
+        break;
+      }
+
+      uint32_t node = queue[from].begin()->second;
+      total -= queue[from].begin()->first;
+      queue[from].erase(queue[from].begin());
+      locked[node] = true;
+
+      for (const auto& neighbor : m_adjacency[node]) {
+        uint32_t other = neighbor.first;
+        if (side[other] != OUTSIDE && !locked[other]) {
+          queue[side[other]].erase({-gainOf(other), other});
+        }
+      }
+      move(node);
+      for (const auto& neighbor : m_adjacency[node]) {
+        uint32_t other = neighbor.first;
+        if (side[other] != OUTSIDE && !locked[other]) {
+          queue[side[other]].insert({-gainOf(other), other});
+        }
+      }
+      --size[from];
+      ++size[1 - from];
+      moves.push_back(node);
+
+      if (total > best + EPSILON) {
+        best = total;
+        bestMoves = moves.size();
+      }
+    }
+
+    // Keep the prefix of moves that reached the smallest cut
+    while (moves.size() > bestMoves) {
+      move(moves.back());
+      moves.pop_back();
+    }
+    if (bestMoves == 0) {
+      break;
+    }
+  }
+}
+
+} // namespace ns3